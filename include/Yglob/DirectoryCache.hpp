@@ -0,0 +1,82 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include "RealFileSystem.hpp"
+
+namespace Yglob
+{
+    /**
+     * @brief Caches directory listings so that they can be shared by
+     *      several PathIterators.
+     *
+     * A listing is reused as long as the directory's modification and
+     * status change times are unchanged, otherwise the directory is
+     * read again. Listings of directories that were modified immediately
+     * before they were read are not reused, as the timestamps of later
+     * changes could be the same.
+     *
+     * DirectoryCache is thread safe. When several threads ask for the
+     * same directory at the same time, the directory is read once and
+     * the other threads wait for the result.
+     *
+     * As a FileSystem, the cache returns cached listings from
+     * list_directory() and gets file statuses from the operating system.
+     */
+    class YGLOB_API DirectoryCache : public RealFileSystem
+    {
+    public:
+        DirectoryCache();
+
+        ~DirectoryCache() override;
+
+        DirectoryCache(const DirectoryCache&) = delete;
+
+        DirectoryCache& operator=(const DirectoryCache&) = delete;
+
+        /**
+         * @brief Returns the entries in @a directory, in the order the
+         *      file system lists them.
+         *
+         * The entries "." and ".." are not included. Errors are reported
+         * the same way as by std::filesystem::directory_iterator, and
+         * @a options is passed on to it.
+         */
+        [[nodiscard]]
+        std::shared_ptr<const Listing>
+        listing(const std::filesystem::path& directory,
+                std::filesystem::directory_options options = {});
+
+        /**
+         * @brief Same as listing().
+         */
+        [[nodiscard]]
+        std::shared_ptr<const Listing>
+        list_directory(const std::filesystem::path& directory,
+                       std::filesystem::directory_options options = {}) override;
+
+        /**
+         * @brief Removes all listings from the cache.
+         */
+        void clear();
+
+        /**
+         * @brief Returns the number of directories in the cache.
+         */
+        [[nodiscard]]
+        size_t size() const;
+    private:
+        friend class GlobSnapshot;
+
+        class DirectoryCacheImpl;
+        std::unique_ptr<DirectoryCacheImpl> impl_;
+    };
+}
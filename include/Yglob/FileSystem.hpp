@@ -0,0 +1,99 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include "YglobDefinitions.hpp"
+
+namespace Yglob
+{
+    /**
+     * @brief The file system a PathIterator reads directories and file
+     *      statuses from.
+     *
+     * Implementations must be thread safe if they are used by parallel
+     * PathIterators or by several iterators on different threads.
+     */
+    class YGLOB_API FileSystem
+    {
+    public:
+        struct Entry
+        {
+            /**
+             * @brief The entry's file name in UTF-8.
+             */
+            std::string name;
+            /**
+             * @brief The type of the file, after following symbolic
+             *      links.
+             */
+            std::filesystem::file_type type = std::filesystem::file_type::none;
+            bool is_symlink = false;
+        };
+
+        using Listing = std::vector<Entry>;
+
+        struct Status
+        {
+            /**
+             * @brief The type of the file, after following symbolic
+             *      links.
+             *
+             * The type is not_found if there is no file or the link is
+             * broken, and none if the status couldn't be determined.
+             */
+            std::filesystem::file_type type = std::filesystem::file_type::none;
+            bool is_symlink = false;
+
+            [[nodiscard]]
+            bool exists() const
+            {
+                return type != std::filesystem::file_type::none
+                       && type != std::filesystem::file_type::not_found;
+            }
+        };
+
+        virtual ~FileSystem();
+
+        /**
+         * @brief Returns the entries in @a directory.
+         *
+         * The entries "." and ".." are not included. An empty path is
+         * the current directory. Errors are reported the same way as by
+         * std::filesystem::directory_iterator.
+         */
+        [[nodiscard]]
+        virtual std::shared_ptr<const Listing>
+        list_directory(const std::filesystem::path& directory,
+                       std::filesystem::directory_options options = {}) = 0;
+
+        /**
+         * @brief Returns the status of the file at @a path.
+         *
+         * Doesn't throw if the file doesn't exist or its status can't
+         * be determined.
+         */
+        [[nodiscard]]
+        virtual Status status(const std::filesystem::path& path) = 0;
+
+        /**
+         * @brief Replaces @a statuses with the statuses of the files at
+         *      @a paths.
+         *
+         * The default implementation calls status() for each path, file
+         * systems where each call is a round-trip should override it.
+         */
+        virtual void get_statuses(const std::vector<std::filesystem::path>& paths,
+                                  std::vector<Status>& statuses);
+
+        [[nodiscard]]
+        bool exists(const std::filesystem::path& path);
+    };
+}
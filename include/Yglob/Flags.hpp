@@ -16,7 +16,17 @@ namespace Yglob
         DEFAULT = 0,
         NO_BRACES = 1,
         NO_SETS = 2,
-        CASE_SENSITIVE = 4
+        CASE_SENSITIVE = 4,
+        /**
+         * @brief Enables the extended glob operators `@(a|b)`, `?(a|b)`,
+         *      `*(a|b)`, `+(a|b)` and `!(a|b)`.
+         *
+         * They match exactly one, zero or one, zero or more, one or more
+         * and anything except the alternatives respectively. Without
+         * this flag, the operators are treated as ordinary characters
+         * or wildcards.
+         */
+        EXT_GLOBS = 8
     };
 
     YGLOB_ENABLE_BITMASK_OPERATORS(GlobFlags);
@@ -49,7 +59,18 @@ namespace Yglob
         CASE_INSENSITIVE_PATHS = 8,
         NO_FILES = 16,
         NO_DIRECTORIES = 32,
-        THROW_IF_ACCESS_DENIED = 64
+        THROW_IF_ACCESS_DENIED = 64,
+        /**
+         * @brief If set, files and directories that are ignored by
+         *      .gitignore and .ignore files are skipped.
+         *
+         * Ignored directories are not read. See IgnoreFilter for details.
+         */
+        USE_IGNORE_FILES = 128,
+        /**
+         * @brief Enables extended glob operators, see GlobFlags::EXT_GLOBS.
+         */
+        EXT_GLOBS = 256
     };
 
     YGLOB_ENABLE_BITMASK_OPERATORS(PathIteratorFlags);
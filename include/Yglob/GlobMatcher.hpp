@@ -8,6 +8,7 @@
 #pragma once
 #include <iosfwd>
 #include <memory>
+#include <memory_resource>
 #include <string_view>
 #include "Flags.hpp"
 #include "YglobDefinitions.hpp"
@@ -15,6 +16,7 @@
 namespace Yglob
 {
     struct GlobElements;
+    class ExtGlobAutomaton;
 
     class YGLOB_API GlobMatcher
     {
@@ -24,6 +26,22 @@ namespace Yglob
         explicit GlobMatcher(std::string_view pattern,
                              GlobFlags flags = GlobFlags::DEFAULT);
 
+        /**
+         * @brief Creates a matcher whose compiled pattern, and the
+         *      buffers used while matching extended globs, are allocated
+         *      from @a resource.
+         *
+         * The resource must outlive the matcher and all its copies.
+         * Unlike matchers created without a resource, the compiled
+         * pattern isn't shared with other matchers for the same pattern.
+         * The alternatives of braces and extended globs, the ranges of
+         * character sets and the extended-glob automaton itself are
+         * still allocated on the global heap.
+         */
+        GlobMatcher(std::string_view pattern,
+                    GlobFlags flags,
+                    std::pmr::memory_resource* resource);
+
         GlobMatcher(const GlobMatcher& rhs);
 
         GlobMatcher(GlobMatcher&& rhs) noexcept;
@@ -38,16 +56,48 @@ namespace Yglob
 
         [[nodiscard]]
         bool match(std::string_view str) const;
+
+        /**
+         * @brief Returns the approximate number of bytes used by the
+         *      matcher, including the matcher object itself.
+         *
+         * Matchers made from the same pattern and flags share their
+         * compiled pattern, and so do copies of a matcher. The shared
+         * part is included in the number for each of them.
+         */
+        [[nodiscard]]
+        size_t memory_usage() const;
     private:
         friend YGLOB_API std::ostream&
         operator<<(std::ostream&, const GlobMatcher&);
 
-        std::unique_ptr<GlobElements> pattern_;
+        friend YGLOB_API bool
+        is_subset(const GlobMatcher&, const GlobMatcher&);
+
+        std::shared_ptr<const GlobElements> pattern_;
+        /**
+         * @brief Matches patterns with extended globs, which the default
+         *      algorithm doesn't support.
+         */
+        std::shared_ptr<const ExtGlobAutomaton> ext_glob_automaton_;
     };
 
     YGLOB_API std::ostream&
     operator<<(std::ostream& os, const GlobMatcher& matcher);
 
+    /**
+     * @brief Returns true if every string that matches @a a also
+     *      matches @a b.
+     *
+     * For instance, "app-*.log" is a subset of "*.log". The function
+     * errs on the side of caution: it may return false for some
+     * case-insensitive patterns with non-ASCII letters even if they are
+     * subsets.
+     */
+    [[nodiscard]]
+    YGLOB_API bool
+    is_subset(const GlobMatcher& a, const GlobMatcher& b);
+
     [[nodiscard]]
     YGLOB_API bool
     is_glob_pattern(std::string_view str,
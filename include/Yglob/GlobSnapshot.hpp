@@ -0,0 +1,110 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include "DirectoryCache.hpp"
+#include "Flags.hpp"
+#include "YglobDefinitions.hpp"
+
+namespace Yglob
+{
+    /**
+     * @brief The result of a glob, saved together with the listings and
+     *      stamps of the directories that were read to produce it.
+     *
+     * A snapshot is brought up to date with PathIterator::refresh(),
+     * which only reads the directories whose modification time, status
+     * change time or identity has changed. Relative glob paths are
+     * evaluated relative to the current directory, both when the
+     * snapshot is made and when it is refreshed.
+     */
+    class YGLOB_API GlobSnapshot
+    {
+    public:
+        /**
+         * @brief Creates an empty snapshot.
+         */
+        GlobSnapshot();
+
+        /**
+         * @brief Finds the paths that match @a glob_paths, as a
+         *      PathIterator with the same arguments would, and records
+         *      the directories that were read.
+         */
+        explicit GlobSnapshot(const std::vector<std::filesystem::path>& glob_paths,
+                              const std::vector<std::string>& exclude_patterns = {},
+                              PathIteratorFlags flags = PathIteratorFlags::DEFAULT);
+
+        GlobSnapshot(GlobSnapshot&& rhs) noexcept;
+
+        ~GlobSnapshot();
+
+        GlobSnapshot& operator=(GlobSnapshot&& rhs) noexcept;
+
+        /**
+         * @brief Loads a snapshot that was saved with save().
+         *
+         * Throws YglobException if the file isn't a valid snapshot.
+         */
+        [[nodiscard]]
+        static GlobSnapshot load(const std::filesystem::path& file_path);
+
+        void save(const std::filesystem::path& file_path) const;
+
+        [[nodiscard]]
+        const std::vector<std::filesystem::path>& glob_paths() const;
+
+        [[nodiscard]]
+        const std::vector<std::string>& exclude_patterns() const;
+
+        [[nodiscard]]
+        PathIteratorFlags flags() const;
+
+        /**
+         * @brief The paths that matched, sorted and without duplicates.
+         */
+        [[nodiscard]]
+        const std::vector<std::filesystem::path>& paths() const;
+    private:
+        friend class PathIterator;
+
+        GlobSnapshot(const std::vector<std::filesystem::path>& glob_paths,
+                     const std::vector<std::string>& exclude_patterns,
+                     PathIteratorFlags flags,
+                     std::shared_ptr<DirectoryCache> cache);
+
+        /**
+         * @brief Returns a cache with the directory listings in this
+         *      snapshot.
+         */
+        [[nodiscard]]
+        std::shared_ptr<DirectoryCache> make_cache() const;
+
+        class GlobSnapshotImpl;
+        std::unique_ptr<GlobSnapshotImpl> impl_;
+    };
+
+    /**
+     * @brief The result of PathIterator::refresh().
+     */
+    struct RefreshedGlob
+    {
+        GlobSnapshot snapshot;
+        /**
+         * @brief The paths that match now, but didn't before, sorted.
+         */
+        std::vector<std::filesystem::path> added;
+        /**
+         * @brief The paths that matched before, but don't anymore, sorted.
+         */
+        std::vector<std::filesystem::path> removed;
+    };
+}
@@ -0,0 +1,134 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Flags.hpp"
+#include "YglobDefinitions.hpp"
+
+namespace Yglob
+{
+    enum class GlobEventType
+    {
+        /**
+         * @brief A path that matches was created, or moved in from
+         *      somewhere that didn't match.
+         */
+        CREATED,
+        /**
+         * @brief A path that matched was deleted, or moved somewhere
+         *      that doesn't match.
+         */
+        DELETED,
+        /**
+         * @brief A path that matched was moved to a path that also
+         *      matches.
+         */
+        MOVED
+    };
+
+    struct GlobEvent
+    {
+        GlobEventType type = GlobEventType::CREATED;
+        std::filesystem::path path;
+        /**
+         * @brief The path before it was moved if type is MOVED, otherwise
+         *      empty.
+         */
+        std::filesystem::path old_path;
+    };
+
+    /**
+     * @brief Reports when paths that match a set of glob paths are
+     *      created, deleted or moved.
+     *
+     * The watcher starts by finding the paths that match, like a
+     * PathIterator with the same arguments. It then watches the
+     * directories that can contain matches or lead to directories that
+     * can, and nothing else. Directories that appear later are watched
+     * as soon as the watcher learns about them, and paths that were
+     * created in them before that are reported as created.
+     *
+     * Only changes to the directory structure are reported, changes to
+     * the contents of files are not. Relative glob paths are relative to
+     * the current directory when the watcher is created, and the paths
+     * in the events are relative too.
+     *
+     * GlobWatcher uses inotify and is only available on Linux, on other
+     * platforms the constructors throw YglobException.
+     */
+    class YGLOB_API GlobWatcher
+    {
+    public:
+        /**
+         * @brief Creates a watcher that doesn't watch anything.
+         */
+        GlobWatcher();
+
+        explicit GlobWatcher(const std::filesystem::path& glob_path,
+                             PathIteratorFlags flags = PathIteratorFlags::DEFAULT);
+
+        explicit GlobWatcher(const std::vector<std::filesystem::path>& glob_paths,
+                             const std::vector<std::string>& exclude_patterns = {},
+                             PathIteratorFlags flags = PathIteratorFlags::DEFAULT);
+
+        GlobWatcher(GlobWatcher&& rhs) noexcept;
+
+        ~GlobWatcher();
+
+        GlobWatcher& operator=(GlobWatcher&& rhs) noexcept;
+
+        /**
+         * @brief Returns true if GlobWatcher is available on this
+         *      platform.
+         */
+        [[nodiscard]]
+        static bool is_supported();
+
+        /**
+         * @brief The paths that match, sorted.
+         *
+         * The paths are updated by poll().
+         */
+        [[nodiscard]]
+        const std::vector<std::filesystem::path>& paths() const;
+
+        /**
+         * @brief Waits up to @a timeout for changes and returns the
+         *      events for the paths that changed.
+         *
+         * Returns immediately if there are changes already, or if the
+         * timeout is zero. If the operating system has dropped events,
+         * the directories are read again and the events are the
+         * differences from the previous paths.
+         */
+        std::vector<GlobEvent> poll(std::chrono::milliseconds timeout = {});
+
+        /**
+         * @brief Returns the file descriptor that becomes readable when
+         *      there are changes, or -1 if the watcher is empty.
+         *
+         * Use it to wait for changes with select, poll or epoll together
+         * with other file descriptors, then call poll() to get the events.
+         */
+        [[nodiscard]]
+        int native_handle() const;
+
+        /**
+         * @brief The number of directories that are being watched.
+         */
+        [[nodiscard]]
+        size_t watch_count() const;
+    private:
+        class GlobWatcherImpl;
+        std::unique_ptr<GlobWatcherImpl> impl_;
+    };
+}
@@ -0,0 +1,86 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include "YglobDefinitions.hpp"
+
+namespace Yglob
+{
+    /**
+     * @brief Decides whether paths are ignored according to .gitignore
+     *      and .ignore files.
+     *
+     * The rules in a directory's ignore files apply to everything below
+     * that directory, and rules in deeper directories take precedence
+     * over rules in the directories above them. The ignore files are
+     * read from the directories of the paths that are checked and their
+     * parent directories, up to and including the nearest directory that
+     * contains a .git directory. If there is no such directory, the search
+     * stops at the outermost directory that has been given rules with
+     * add_rules, or at the first directory that is checked.
+     *
+     * The ignore files are read once and cached.
+     */
+    class YGLOB_API IgnoreFilter
+    {
+    public:
+        /**
+         * @brief Creates a filter that reads .gitignore and .ignore files.
+         */
+        IgnoreFilter();
+
+        /**
+         * @brief Creates a filter that reads the files named in
+         *      @a file_names.
+         *
+         * Rules in later files take precedence over rules in earlier
+         * ones.
+         */
+        explicit IgnoreFilter(std::vector<std::string> file_names);
+
+        IgnoreFilter(IgnoreFilter&& rhs) noexcept;
+
+        ~IgnoreFilter();
+
+        IgnoreFilter& operator=(IgnoreFilter&& rhs) noexcept;
+
+        /**
+         * @brief Adds rules for @a directory in addition to the ones in
+         *      its ignore files.
+         *
+         * @a text has the same format as a .gitignore file. The rules
+         * have lower precedence than those in the directory's files.
+         */
+        void add_rules(const std::filesystem::path& directory,
+                       std::string_view text);
+
+        /**
+         * @brief Returns true if @a path, or any of its parent directories,
+         *      is ignored.
+         */
+        [[nodiscard]]
+        bool is_ignored(const std::filesystem::path& path, bool is_directory);
+
+        /**
+         * @brief Returns true if @a path is ignored, assuming that its
+         *      parent directory is not.
+         *
+         * This is the function to use during traversal, when the parent
+         * directories have already been checked.
+         */
+        [[nodiscard]]
+        bool is_ignored_entry(const std::filesystem::path& path,
+                              bool is_directory);
+    private:
+        class IgnoreFilterImpl;
+        std::unique_ptr<IgnoreFilterImpl> impl_;
+    };
+}
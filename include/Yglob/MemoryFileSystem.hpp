@@ -0,0 +1,69 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include "FileSystem.hpp"
+
+namespace Yglob
+{
+    /**
+     * @brief A file system that only exists in memory, for running
+     *      PathIterators on synthetic trees without any system calls.
+     *
+     * Relative and absolute paths are separate trees, the relative paths
+     * are relative to the empty path. There are no symbolic links, and
+     * the directories list their entries in the order they were added.
+     *
+     * Reading is thread safe, but files must not be added while
+     * PathIterators use the file system.
+     */
+    class YGLOB_API MemoryFileSystem : public FileSystem
+    {
+    public:
+        MemoryFileSystem();
+
+        ~MemoryFileSystem() override;
+
+        MemoryFileSystem(const MemoryFileSystem&) = delete;
+
+        MemoryFileSystem& operator=(const MemoryFileSystem&) = delete;
+
+        /**
+         * @brief Adds a file of type @a type at @a path, and any missing
+         *      directories above it.
+         *
+         * Throws YglobException if a file that isn't a directory
+         * already exists at @a path or above it.
+         */
+        void add_file(const std::filesystem::path& path,
+                      std::filesystem::file_type type = std::filesystem::file_type::regular);
+
+        /**
+         * @brief Adds a directory at @a path, and any missing
+         *      directories above it.
+         */
+        void add_directory(const std::filesystem::path& path);
+
+        /**
+         * @brief Returns the number of files and directories, not
+         *      counting the roots.
+         */
+        [[nodiscard]]
+        size_t size() const;
+
+        [[nodiscard]]
+        std::shared_ptr<const Listing>
+        list_directory(const std::filesystem::path& directory,
+                       std::filesystem::directory_options options = {}) override;
+
+        [[nodiscard]]
+        Status status(const std::filesystem::path& path) override;
+    private:
+        class MemoryFileSystemImpl;
+        std::unique_ptr<MemoryFileSystemImpl> impl_;
+    };
+}
@@ -6,12 +6,160 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
+#include <chrono>
 #include <filesystem>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "DirectoryCache.hpp"
 #include "Flags.hpp"
+#include "GlobSnapshot.hpp"
 #include "YglobDefinitions.hpp"
 
 namespace Yglob
 {
+    /**
+     * @brief Tells whether a PathIterator has produced all its paths, or
+     *      why it stopped before it had.
+     */
+    enum class IterationStatus
+    {
+        /**
+         * @brief next() hasn't returned false yet.
+         */
+        IN_PROGRESS,
+        /**
+         * @brief All the matching paths have been produced.
+         */
+        COMPLETED,
+        /**
+         * @brief A stop was requested through the iterator's stop token.
+         */
+        CANCELLED,
+        /**
+         * @brief The iterator's deadline passed.
+         */
+        TIMED_OUT
+    };
+
+    /**
+     * @brief Options for PathIterators that read directories on several
+     *      threads.
+     */
+    struct ParallelOptions
+    {
+        /**
+         * @brief The number of threads that read directories, 0 means
+         *      one per hardware thread.
+         */
+        unsigned thread_count = 0;
+
+        /**
+         * @brief Runs the tasks that read directories on the caller's
+         *      threads instead of on threads owned by the iterator.
+         *
+         * Each task reads one directory. The executor must not run the
+         * task before returning, as tasks wait while the iterator's
+         * buffer is full. thread_count is ignored if this is set.
+         */
+        std::function<void(std::function<void()>)> executor;
+
+        /**
+         * @brief The number of paths that can be found before they are
+         *      returned by next().
+         *
+         * Threads don't start reading more directories while the buffer
+         * is full, but a directory that has been started is always
+         * completed, so the buffer can hold somewhat more paths than
+         * this.
+         */
+        size_t queue_size = 4096;
+
+        /**
+         * @brief Produce the paths in the same order every time.
+         *
+         * The order is depth first, with the entries in each directory
+         * sorted by their names. Otherwise the paths are produced in
+         * the order the directories are read.
+         */
+        bool ordered = false;
+    };
+
+    /**
+     * @brief Selects one of several disjoint parts of a traversal, to
+     *      divide a traversal between processes or machines.
+     *
+     * The directories and files at @a depth levels below the directory
+     * where the traversal starts are assigned to shards by a hash of
+     * their paths relative to that directory, and a shard only reads
+     * the subdirectories that are assigned to it. Directories that are
+     * named literally in the glob path, and are therefore looked up
+     * rather than read, don't count as levels. Paths above @a depth
+     * are assigned to shards by the same hash.
+     *
+     * Together the shards 0 to count - 1 produce exactly the paths
+     * a traversal without sharding produces, each of them once. This
+     * holds for parallel traversals and traversals of any FileSystem
+     * too, see PathIteratorOptions.
+     */
+    struct Shard
+    {
+        Shard() = default;
+
+        Shard(size_t index, size_t count, size_t depth = 1)
+            : index(index), count(count), depth(depth)
+        {}
+
+        size_t index = 0;
+        size_t count = 1;
+        size_t depth = 1;
+    };
+
+    /**
+     * @brief The settings of a PathIterator that can be combined, e.g. to
+     *      read one shard of a traversal in parallel from a
+     *      DirectoryCache.
+     */
+    struct PathIteratorOptions
+    {
+        /**
+         * @brief Where directories and file statuses are read from, null
+         *      means the operating system's file system.
+         */
+        std::shared_ptr<FileSystem> file_system;
+
+        /**
+         * @brief Read the directories on several threads, if set.
+         */
+        std::optional<ParallelOptions> parallel;
+
+        /**
+         * @brief The part of the traversal to produce.
+         */
+        Shard shard;
+
+        /**
+         * @brief Where the matchers and traversal state are allocated
+         *      from, null means the default resource.
+         *
+         * Parallel traversals ignore it, their tasks and results are
+         * shared between threads and live on the global heap.
+         */
+        std::pmr::memory_resource* resource = nullptr;
+    };
+
+    /**
+     * @brief Produces the paths that match one or more glob paths.
+     *
+     * Relative glob paths produce paths relative to the current
+     * directory, without a leading "./": "*.txt" produces "a.txt", not
+     * "./a.txt". Every constructor spells a path the same way.
+     */
     class YGLOB_API PathIterator
     {
     public:
@@ -20,6 +168,136 @@ namespace Yglob
         explicit PathIterator(const std::filesystem::path& glob_path,
                               PathIteratorFlags flags = PathIteratorFlags::DEFAULT);
 
+        /**
+         * @brief Creates an iterator that skips files and directories
+         *      that match any of the patterns in @a exclude_patterns.
+         *
+         * The exclude patterns have the same syntax as PathMatcher
+         * patterns and are matched against the paths the iterator
+         * produces. Relative patterns that start with "**" match
+         * regardless of where the iteration starts. Excluded directories
+         * are not read, and neither is anything below them.
+         */
+        PathIterator(const std::filesystem::path& glob_path,
+                     const std::vector<std::string>& exclude_patterns,
+                     PathIteratorFlags flags = PathIteratorFlags::DEFAULT);
+
+        /**
+         * @brief Creates an iterator that produces the paths that match
+         *      any of the glob paths in @a glob_paths.
+         *
+         * The glob paths are combined so that each directory is read at
+         * most once, and a path that matches several glob paths is only
+         * produced once. Use pattern_indexes() to find which glob paths
+         * the current path matched.
+         */
+        explicit PathIterator(const std::vector<std::filesystem::path>& glob_paths,
+                              PathIteratorFlags flags = PathIteratorFlags::DEFAULT);
+
+        PathIterator(const std::vector<std::filesystem::path>& glob_paths,
+                     const std::vector<std::string>& exclude_patterns,
+                     PathIteratorFlags flags = PathIteratorFlags::DEFAULT);
+
+        /**
+         * @brief Creates an iterator that reads directories and file
+         *      statuses from @a file_system.
+         *
+         * If @a file_system is a DirectoryCache, iterators that share it
+         * only read directories that haven't changed since another
+         * iterator read them once. A MemoryFileSystem serves the glob
+         * paths without any system calls. If @a file_system is null, the
+         * iterator reads the operating system's file system directly.
+         */
+        PathIterator(const std::filesystem::path& glob_path,
+                     const std::vector<std::string>& exclude_patterns,
+                     PathIteratorFlags flags,
+                     std::shared_ptr<FileSystem> file_system);
+
+        PathIterator(const std::vector<std::filesystem::path>& glob_paths,
+                     const std::vector<std::string>& exclude_patterns,
+                     PathIteratorFlags flags,
+                     std::shared_ptr<FileSystem> file_system);
+
+        /**
+         * @brief Creates an iterator that reads directories in parallel.
+         *
+         * Each directory is read by a task, and the tasks run on a pool
+         * of threads where idle threads take tasks from busy ones, or on
+         * the executor in @a parallel. The paths are produced in the
+         * order they are found unless @a parallel requests a
+         * deterministic order.
+         *
+         * Exceptions thrown while reading directories are rethrown by
+         * next().
+         */
+        PathIterator(const std::filesystem::path& glob_path,
+                     const std::vector<std::string>& exclude_patterns,
+                     PathIteratorFlags flags,
+                     const ParallelOptions& parallel);
+
+        PathIterator(const std::vector<std::filesystem::path>& glob_paths,
+                     const std::vector<std::string>& exclude_patterns,
+                     PathIteratorFlags flags,
+                     const ParallelOptions& parallel);
+
+        /**
+         * @brief Creates an iterator that only produces the paths in
+         *      @a shard.
+         *
+         * Throws YglobException if the shard's index isn't less than its
+         * count, or its depth is 0.
+         */
+        PathIterator(const std::filesystem::path& glob_path,
+                     const std::vector<std::string>& exclude_patterns,
+                     PathIteratorFlags flags,
+                     const Shard& shard);
+
+        PathIterator(const std::vector<std::filesystem::path>& glob_paths,
+                     const std::vector<std::string>& exclude_patterns,
+                     PathIteratorFlags flags,
+                     const Shard& shard);
+
+        /**
+         * @brief Creates an iterator whose matchers and traversal state
+         *      are allocated from @a resource.
+         *
+         * The resource provides the compiled glob components, the
+         * buffers used while matching them and, for several glob paths,
+         * the stack of directories and their trie nodes. The resource
+         * must outlive the iterator.
+         *
+         * Everything else stays on the global heap: the paths, the
+         * directory listings, the iterator's own objects, the trie of
+         * several glob paths, the exclude patterns, and the parts of the
+         * matchers that GlobMatcher's overload with a resource leaves
+         * there.
+         */
+        PathIterator(const std::filesystem::path& glob_path,
+                     const std::vector<std::string>& exclude_patterns,
+                     PathIteratorFlags flags,
+                     std::pmr::memory_resource* resource);
+
+        PathIterator(const std::vector<std::filesystem::path>& glob_paths,
+                     const std::vector<std::string>& exclude_patterns,
+                     PathIteratorFlags flags,
+                     std::pmr::memory_resource* resource);
+
+        /**
+         * @brief Creates an iterator with any combination of the settings
+         *      the constructors above take one at a time.
+         *
+         * Throws YglobException if the shard in @a options is invalid.
+         */
+        PathIterator(const std::filesystem::path& glob_path,
+                     const std::vector<std::string>& exclude_patterns,
+                     PathIteratorFlags flags,
+                     const PathIteratorOptions& options);
+
+        PathIterator(const std::vector<std::filesystem::path>& glob_paths,
+                     const std::vector<std::string>& exclude_patterns,
+                     PathIteratorFlags flags,
+                     const PathIteratorOptions& options);
+
         ~PathIterator();
 
         PathIterator(const PathIterator& rhs) = delete;
@@ -32,8 +310,81 @@ namespace Yglob
 
         bool next();
 
+        /**
+         * @brief Makes next() return false soon after a stop is requested
+         *      on @a token.
+         *
+         * The token is checked before each directory entry is read, and
+         * while next() waits for other threads. The paths that next()
+         * has already produced are the partial result, status() tells
+         * whether the iteration was cancelled. Must be called before the
+         * first call to next().
+         */
+        void set_stop_token(std::stop_token token);
+
+        /**
+         * @brief Makes next() return false soon after @a deadline.
+         *
+         * The deadline is checked like the stop token in
+         * set_stop_token(). Must be called before the first call to
+         * next().
+         */
+        void set_deadline(std::chrono::steady_clock::time_point deadline);
+
+        /**
+         * @brief Returns IN_PROGRESS until next() returns false, and then
+         *      the reason it did.
+         */
+        [[nodiscard]]
+        IterationStatus status() const;
+
         [[nodiscard]]
         const std::filesystem::path& path() const;
+
+        /**
+         * @brief Returns the current path as a string without copying it.
+         *
+         * The view is valid until the next call to next(). Where the
+         * native path encoding isn't char, e.g. on Windows, the view is
+         * the generic path in UTF-8, converted into a buffer that is
+         * reused for every path.
+         */
+        [[nodiscard]]
+        std::string_view view() const;
+
+        /**
+         * @brief Returns the indexes of the glob paths that match the
+         *      current path, in ascending order.
+         *
+         * Iterators created with a single glob path always return {0}.
+         */
+        [[nodiscard]]
+        const std::vector<size_t>& pattern_indexes() const;
+
+        /**
+         * @brief Returns an iterator that runs @a source on a background
+         *      thread, reading directories while the caller processes
+         *      the paths.
+         *
+         * The paths and their pattern indexes are produced in the same
+         * order as @a source would produce them. The background thread
+         * pauses when @a max_buffered paths are waiting to be returned by
+         * next(). Exceptions thrown by @a source are rethrown by next()
+         * after the paths that were found before them.
+         */
+        [[nodiscard]]
+        static PathIterator prefetching(PathIterator source,
+                                        size_t max_buffered = 1024);
+
+        /**
+         * @brief Globs the paths in @a previous again and returns the new
+         *      result together with the paths that were added and removed.
+         *
+         * Directories that haven't changed since @a previous was made are
+         * not read again, their listings are taken from @a previous.
+         */
+        [[nodiscard]]
+        static RefreshedGlob refresh(const GlobSnapshot& previous);
     private:
         class PathIteratorImpl;
         std::unique_ptr<PathIteratorImpl> impl_;
@@ -0,0 +1,162 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Flags.hpp"
+#include "YglobDefinitions.hpp"
+
+namespace Yglob
+{
+    class PathIterator;
+
+    /**
+     * @brief A compact, append-only list of paths.
+     *
+     * Each path is stored as the length of the prefix it shares with the
+     * path before it, followed by the rest of the path. Paths produced by
+     * a PathIterator share most of their directories with their
+     * neighbours, and typically need a fraction of the memory of a
+     * std::vector<std::filesystem::path>.
+     *
+     * The paths are divided into blocks where the first path is stored
+     * in full, random access only has to decode the paths in a single
+     * block. Iterating over the list is faster than indexing it.
+     *
+     * Paths are stored as UTF-8 with the generic directory separator.
+     */
+    class YGLOB_API PathList
+    {
+    public:
+        /**
+         * @brief Iterates over the paths in a PathList.
+         *
+         * The string_views refer to a buffer in the iterator and are
+         * invalidated when the iterator is incremented or destroyed.
+         */
+        class YGLOB_API Iterator
+        {
+        public:
+            using value_type = std::string_view;
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::string_view*;
+            using reference = std::string_view;
+
+            Iterator() = default;
+
+            std::string_view operator*() const
+            {
+                return current_;
+            }
+
+            Iterator& operator++();
+
+            Iterator operator++(int)
+            {
+                auto result = *this;
+                ++*this;
+                return result;
+            }
+
+            friend bool operator==(const Iterator& lhs, const Iterator& rhs)
+            {
+                return lhs.index_ == rhs.index_;
+            }
+        private:
+            friend class PathList;
+
+            Iterator(const PathList* list, size_t index);
+
+            const PathList* list_ = nullptr;
+            size_t index_ = 0;
+            size_t offset_ = 0;
+            std::string current_;
+        };
+
+        PathList();
+
+        /**
+         * @brief Adds @a path to the end of the list.
+         */
+        void push_back(std::string_view path);
+
+        void push_back(const std::filesystem::path& path);
+
+        [[nodiscard]]
+        size_t size() const;
+
+        [[nodiscard]]
+        bool empty() const;
+
+        /**
+         * @brief Returns the path at @a index.
+         *
+         * The path is decoded from the start of its block, prefer
+         * iteration when visiting all the paths.
+         */
+        [[nodiscard]]
+        std::filesystem::path operator[](size_t index) const;
+
+        /**
+         * @brief Assigns the path at @a index to @a result and returns
+         *      a view of it.
+         *
+         * Reusing @a result avoids allocating memory for every path.
+         */
+        std::string_view get(size_t index, std::string& result) const;
+
+        [[nodiscard]]
+        Iterator begin() const;
+
+        [[nodiscard]]
+        Iterator end() const;
+
+        void clear();
+
+        /**
+         * @brief Frees memory that has been reserved for paths that
+         *      haven't been added.
+         */
+        void shrink_to_fit();
+
+        /**
+         * @brief Returns the number of bytes used by the list.
+         */
+        [[nodiscard]]
+        size_t memory_usage() const;
+    private:
+        /**
+         * @brief Decodes the path at @a offset in data_ onto the end of
+         *      the prefix it shares with @a path, and returns the offset
+         *      of the next path.
+         */
+        size_t decode(size_t offset, std::string& path) const;
+
+        std::string data_;
+        std::vector<size_t> block_offsets_;
+        std::string last_;
+        size_t size_ = 0;
+    };
+
+    /**
+     * @brief Adds the remaining paths from @a iterator to a PathList.
+     */
+    [[nodiscard]]
+    YGLOB_API PathList collect(PathIterator& iterator);
+
+    /**
+     * @brief Adds the paths that match @a glob_path to a PathList.
+     */
+    [[nodiscard]]
+    YGLOB_API PathList collect(const std::filesystem::path& glob_path,
+                               PathIteratorFlags flags = PathIteratorFlags::DEFAULT);
+}
@@ -8,7 +8,12 @@
 #pragma once
 #include <filesystem>
 #include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <span>
+#include <string>
 #include <string_view>
+#include <vector>
 #include "Flags.hpp"
 #include "YglobDefinitions.hpp"
 
@@ -25,6 +30,24 @@ namespace Yglob
         explicit PathMatcher(const std::filesystem::path& pattern,
                              GlobFlags flags = GlobFlags::DEFAULT);
 
+        /**
+         * @brief Creates a matcher whose compiled pattern and match
+         *      buffers are allocated from @a resource.
+         *
+         * The resource must outlive the matcher and all its copies,
+         * and the glob components aren't shared with other matchers.
+         * The buffers of IncrementalPathMatcher, match_sorted and
+         * filter_sorted also use the resource, apart from their copy of
+         * the previous path. What GlobMatcher's overload with a resource
+         * leaves on the global heap is also left there by this one, and
+         * so is the pattern's root.
+         */
+        PathMatcher(std::string_view pattern, GlobFlags flags,
+                    std::pmr::memory_resource* resource);
+
+        PathMatcher(const std::filesystem::path& pattern, GlobFlags flags,
+                    std::pmr::memory_resource* resource);
+
         PathMatcher(const PathMatcher& rhs);
 
         PathMatcher(PathMatcher&& rhs) noexcept;
@@ -40,8 +63,172 @@ namespace Yglob
 
         [[nodiscard]]
         bool match(const std::filesystem::path& str) const;
+
+        /**
+         * @brief Matches a path that has already been split into
+         *      components.
+         *
+         * If the path is absolute, its first component must be the root,
+         * e.g. "/" or "C:/". Empty components and "." are ignored.
+         */
+        [[nodiscard]]
+        bool match(std::span<const std::string_view> components) const;
+
+        /**
+         * @brief Returns true if any path below @a dir can match the
+         *      pattern.
+         *
+         * Traversal code can use this to avoid visiting directories
+         * where nothing will match.
+         */
+        [[nodiscard]]
+        bool may_match_below(std::string_view dir) const;
+
+        [[nodiscard]]
+        bool may_match_below(const std::filesystem::path& dir) const;
+
+        /**
+         * @brief Returns true if every path below @a dir matches the
+         *      pattern.
+         *
+         * This is the case when @a dir matches the part of the pattern
+         * that precedes a trailing `**`.
+         */
+        [[nodiscard]]
+        bool matches_all_below(std::string_view dir) const;
+
+        [[nodiscard]]
+        bool matches_all_below(const std::filesystem::path& dir) const;
+
+        /**
+         * @brief Matches every path in @a paths and returns a vector with
+         *      the result for each of them.
+         *
+         * The matcher's state for the leading components a path shares
+         * with the previous one is reused, which makes this much faster
+         * than calling match() for each path when @a paths is sorted.
+         *
+         * @a paths can be any range of strings, string views or
+         * std::filesystem::path.
+         */
+        template <typename Range>
+        [[nodiscard]]
+        std::vector<bool> match_sorted(const Range& paths) const;
+
+        /**
+         * @brief Copies the paths in @a paths that match to @a out.
+         *
+         * Uses the same algorithm as match_sorted.
+         */
+        template <typename Range, typename OutputIt>
+        OutputIt filter_sorted(const Range& paths, OutputIt out) const;
+
+        /**
+         * @brief Returns the approximate number of bytes used by the
+         *      matcher, including the matcher object itself.
+         *
+         * Copies of a matcher share its compiled pattern, and glob
+         * components are shared by all matchers that contain the same
+         * component with the same flags. The shared parts are included
+         * in the number for each of them.
+         */
+        [[nodiscard]]
+        size_t memory_usage() const;
     private:
+        friend class IncrementalPathMatcher;
+
+        friend YGLOB_API bool
+        is_subset(const PathMatcher&, const PathMatcher&);
+
         class PathMatcherImpl;
-        std::unique_ptr<PathMatcherImpl> impl_;
+        std::shared_ptr<const PathMatcherImpl> impl_;
     };
+
+    /**
+     * @brief Returns true if every path that matches @a a also matches
+     *      @a b.
+     *
+     * For instance, "src/main.c" is a subset of "src/[a-z]*.c". The
+     * function errs on the side of caution and returns false when a
+     * subset can't be determined by comparing the patterns' components
+     * one by one.
+     */
+    [[nodiscard]]
+    YGLOB_API bool
+    is_subset(const PathMatcher& a, const PathMatcher& b);
+
+    /**
+     * @brief Returns @a patterns without the patterns that are subsets
+     *      of other patterns in the list.
+     *
+     * Of several equivalent patterns, only the first is kept. The
+     * remaining patterns are in their original order.
+     */
+    [[nodiscard]]
+    YGLOB_API std::vector<std::string>
+    simplify_patterns(const std::vector<std::string>& patterns,
+                      GlobFlags flags = GlobFlags::DEFAULT);
+
+    /**
+     * @brief Matches paths one at a time with a PathMatcher, reusing the
+     *      work done for the leading components shared with the
+     *      previous path.
+     *
+     * The PathMatcher must outlive the IncrementalPathMatcher.
+     */
+    class YGLOB_API IncrementalPathMatcher
+    {
+    public:
+        explicit IncrementalPathMatcher(const PathMatcher& matcher);
+
+        IncrementalPathMatcher(IncrementalPathMatcher&& rhs) noexcept;
+
+        ~IncrementalPathMatcher();
+
+        IncrementalPathMatcher& operator=(IncrementalPathMatcher&& rhs) noexcept;
+
+        [[nodiscard]]
+        bool match(std::string_view path);
+
+        [[nodiscard]]
+        bool match(const std::filesystem::path& path);
+    private:
+        struct IncrementalPathMatcherImpl;
+        std::unique_ptr<IncrementalPathMatcherImpl> impl_;
+    };
+
+    template <typename Range>
+    std::vector<bool> PathMatcher::match_sorted(const Range& paths) const
+    {
+        std::vector<bool> result;
+        if constexpr (std::ranges::sized_range<Range>)
+            result.reserve(std::ranges::size(paths));
+
+        IncrementalPathMatcher matcher(*this);
+        for (const auto& path : paths)
+        {
+            if constexpr (std::is_convertible_v<decltype(path), std::string_view>)
+                result.push_back(matcher.match(std::string_view(path)));
+            else
+                result.push_back(matcher.match(path));
+        }
+        return result;
+    }
+
+    template <typename Range, typename OutputIt>
+    OutputIt PathMatcher::filter_sorted(const Range& paths, OutputIt out) const
+    {
+        IncrementalPathMatcher matcher(*this);
+        for (const auto& path : paths)
+        {
+            bool is_match;
+            if constexpr (std::is_convertible_v<decltype(path), std::string_view>)
+                is_match = matcher.match(std::string_view(path));
+            else
+                is_match = matcher.match(path);
+            if (is_match)
+                *out++ = path;
+        }
+        return out;
+    }
 }
@@ -0,0 +1,98 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include "Flags.hpp"
+#include "YglobDefinitions.hpp"
+
+namespace Yglob
+{
+    class ComponentTrie;
+
+    /**
+     * @brief Matches paths against many PathMatcher patterns at once.
+     *
+     * The patterns are compiled into a single trie of path components, so
+     * that a path is matched against all of them in one pass over its
+     * components. Each pattern is identified by the index it was given
+     * when it was added, and lower indexes are considered to have higher
+     * priority.
+     */
+    class YGLOB_API PathMatcherSet
+    {
+    public:
+        PathMatcherSet();
+
+        explicit PathMatcherSet(const std::vector<std::string>& patterns,
+                                GlobFlags flags = GlobFlags::DEFAULT);
+
+        PathMatcherSet(const PathMatcherSet& rhs);
+
+        PathMatcherSet(PathMatcherSet&& rhs) noexcept;
+
+        ~PathMatcherSet();
+
+        PathMatcherSet& operator=(const PathMatcherSet& rhs);
+
+        PathMatcherSet& operator=(PathMatcherSet&& rhs) noexcept;
+
+        /**
+         * @brief Adds @a pattern to the set and returns its index.
+         */
+        size_t add(std::string_view pattern,
+                   GlobFlags flags = GlobFlags::DEFAULT);
+
+        size_t add(const std::filesystem::path& pattern,
+                   GlobFlags flags = GlobFlags::DEFAULT);
+
+        [[nodiscard]]
+        size_t size() const;
+
+        [[nodiscard]]
+        bool empty() const;
+
+        /**
+         * @brief Returns true if any of the patterns match @a path.
+         */
+        [[nodiscard]]
+        bool match(std::string_view path) const;
+
+        [[nodiscard]]
+        bool match(const std::filesystem::path& path) const;
+
+        /**
+         * @brief Returns the lowest index of the patterns that match
+         *      @a path.
+         */
+        [[nodiscard]]
+        std::optional<size_t> find_first(std::string_view path) const;
+
+        [[nodiscard]]
+        std::optional<size_t> find_first(const std::filesystem::path& path) const;
+
+        /**
+         * @brief Returns the indexes of all patterns that match @a path
+         *      in ascending order.
+         */
+        [[nodiscard]]
+        std::vector<size_t> find_all(std::string_view path) const;
+
+        [[nodiscard]]
+        std::vector<size_t> find_all(const std::filesystem::path& path) const;
+    private:
+        template <typename Func>
+        void walk(std::string_view path, Func func) const;
+
+        std::unique_ptr<ComponentTrie> trie_;
+        size_t size_ = 0;
+    };
+}
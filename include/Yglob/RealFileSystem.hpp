@@ -0,0 +1,38 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include "FileSystem.hpp"
+
+namespace Yglob
+{
+    /**
+     * @brief The operating system's file system.
+     *
+     * PathIterators created without a FileSystem read the operating
+     * system's file system directly, this class is for code that needs
+     * a FileSystem, for instance to fall back to when a path isn't in
+     * another one.
+     *
+     * On Linux, get_statuses() submits the system calls for all the
+     * paths in one batch if io_uring is available.
+     */
+    class YGLOB_API RealFileSystem : public FileSystem
+    {
+    public:
+        [[nodiscard]]
+        std::shared_ptr<const Listing>
+        list_directory(const std::filesystem::path& directory,
+                       std::filesystem::directory_options options = {}) override;
+
+        [[nodiscard]]
+        Status status(const std::filesystem::path& path) override;
+
+        void get_statuses(const std::vector<std::filesystem::path>& paths,
+                          std::vector<Status>& statuses) override;
+    };
+}
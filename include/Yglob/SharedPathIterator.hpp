@@ -0,0 +1,82 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include "PathIterator.hpp"
+#include "YglobDefinitions.hpp"
+
+namespace Yglob
+{
+    /**
+     * @brief Finds the paths that match one or more glob paths and hands
+     *      them out to several consumer threads.
+     *
+     * The directories are read in parallel, as by a PathIterator created
+     * with ParallelOptions, and each path is handed out exactly once.
+     * The paths are handed out in no particular order,
+     * ParallelOptions::ordered is ignored.
+     *
+     * All member functions except the constructors and the destructor
+     * can be called from several threads at once. The consumers must
+     * have returned from try_next() and try_next_batch() before the
+     * iterator is destroyed, call stop() first to wake them up.
+     */
+    class YGLOB_API SharedPathIterator
+    {
+    public:
+        explicit SharedPathIterator(const std::filesystem::path& glob_path,
+                                    PathIteratorFlags flags = PathIteratorFlags::DEFAULT);
+
+        explicit SharedPathIterator(const std::vector<std::filesystem::path>& glob_paths,
+                                    const std::vector<std::string>& exclude_patterns = {},
+                                    PathIteratorFlags flags = PathIteratorFlags::DEFAULT,
+                                    const ParallelOptions& parallel = {});
+
+        /**
+         * @brief Stops the traversal, directories that are being read are
+         *      completed first.
+         */
+        ~SharedPathIterator();
+
+        SharedPathIterator(const SharedPathIterator&) = delete;
+
+        SharedPathIterator& operator=(const SharedPathIterator&) = delete;
+
+        /**
+         * @brief Assigns the next path to @a path, waiting until one is
+         *      found if necessary.
+         *
+         * Returns false when there are no more paths, or when stop()
+         * has been called. Exceptions thrown while reading directories
+         * are rethrown by one of the consumers.
+         */
+        bool try_next(std::filesystem::path& path);
+
+        /**
+         * @brief Replaces @a paths with several paths, typically all
+         *      the matches in one directory.
+         *
+         * This amortizes the cost of synchronization over many paths,
+         * and is preferable when the consumers process paths quickly.
+         * Returns false under the same conditions as try_next().
+         */
+        bool try_next_batch(std::vector<std::filesystem::path>& paths);
+
+        /**
+         * @brief Stops the traversal and makes try_next() and
+         *      try_next_batch() return false in all threads.
+         */
+        void stop();
+    private:
+        class SharedPathIteratorImpl;
+        std::unique_ptr<SharedPathIteratorImpl> impl_;
+    };
+}
@@ -0,0 +1,130 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+#include "Flags.hpp"
+#include "YglobDefinitions.hpp"
+
+namespace Yglob
+{
+    /**
+     * @brief A snapshot of the names, types, sizes and modification
+     *      times of the files and directories below a root directory.
+     *
+     * Glob paths are matched against the index instead of the file
+     * system, which turns a walk of a large directory tree into a scan
+     * of a compact array. The index can be saved to a file, and loaded
+     * indexes are memory mapped rather than read.
+     *
+     * Symbolic links are stored as they are, the index doesn't include
+     * what is below symbolic links to directories. Directories that
+     * can't be read are stored without any contents.
+     */
+    class YGLOB_API TreeIndex
+    {
+    public:
+        struct Entry
+        {
+            std::filesystem::path path;
+            std::filesystem::file_type type = std::filesystem::file_type::none;
+            /**
+             * @brief The size of regular files, 0 for everything else.
+             */
+            uint64_t size = 0;
+            /**
+             * @brief The modification time in nanoseconds since the epoch
+             *      of the operating system's file times.
+             */
+            int64_t modified = 0;
+        };
+
+        /**
+         * @brief Creates an empty index.
+         */
+        TreeIndex();
+
+        /**
+         * @brief Creates an index of the tree below @a root.
+         */
+        explicit TreeIndex(const std::filesystem::path& root);
+
+        TreeIndex(TreeIndex&& rhs) noexcept;
+
+        ~TreeIndex();
+
+        TreeIndex& operator=(TreeIndex&& rhs) noexcept;
+
+        /**
+         * @brief Loads an index that was saved with save().
+         *
+         * The file is memory mapped and must not be modified while the
+         * index is in use. Throws YglobException if the file isn't a
+         * valid index.
+         */
+        [[nodiscard]]
+        static TreeIndex load(const std::filesystem::path& file_path);
+
+        /**
+         * @brief Writes the index to @a file_path.
+         */
+        void save(const std::filesystem::path& file_path) const;
+
+        /**
+         * @brief Brings the index up to date with the file system.
+         *
+         * Only directories whose modification time, status change time
+         * or identity has changed since they were indexed are read
+         * again. Changes to the sizes and modification times of files
+         * in unchanged directories are not detected, as they don't
+         * affect their directories.
+         *
+         * @return The number of directories that were read.
+         */
+        size_t refresh();
+
+        /**
+         * @brief The absolute path of the indexed directory.
+         */
+        [[nodiscard]]
+        const std::filesystem::path& root() const;
+
+        /**
+         * @brief The number of files and directories in the index, not
+         *      including the root.
+         */
+        [[nodiscard]]
+        size_t size() const;
+
+        /**
+         * @brief Returns the entries that match @a glob_path.
+         *
+         * Relative glob paths are relative to the root, and so are the
+         * paths of the entries they match. Absolute glob paths produce
+         * absolute paths. Only the entries in the index are matched,
+         * never the root or the directories above it. The flags are
+         * interpreted as by PathIterator.
+         */
+        [[nodiscard]]
+        std::vector<Entry> find(const std::filesystem::path& glob_path,
+                                PathIteratorFlags flags = PathIteratorFlags::DEFAULT) const;
+
+        /**
+         * @brief Returns the entries that match any of the glob paths in
+         *      @a glob_paths.
+         */
+        [[nodiscard]]
+        std::vector<Entry> find(const std::vector<std::filesystem::path>& glob_paths,
+                                PathIteratorFlags flags = PathIteratorFlags::DEFAULT) const;
+    private:
+        class TreeIndexImpl;
+        std::unique_ptr<TreeIndexImpl> impl_;
+    };
+}
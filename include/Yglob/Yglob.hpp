@@ -7,6 +7,17 @@
 //****************************************************************************
 #pragma once
 
+#include "DirectoryCache.hpp"
+#include "FileSystem.hpp"
+#include "GlobSnapshot.hpp"
+#include "GlobWatcher.hpp"
+#include "IgnoreFilter.hpp"
+#include "MemoryFileSystem.hpp"
 #include "PathIterator.hpp"
+#include "PathList.hpp"
 #include "PathMatcher.hpp"
+#include "PathMatcherSet.hpp"
+#include "RealFileSystem.hpp"
+#include "SharedPathIterator.hpp"
+#include "TreeIndex.hpp"
 #include "YglobException.hpp"
@@ -0,0 +1,233 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ComponentTrie.hpp"
+
+#include <algorithm>
+#include <Ystring/Algorithms.hpp>
+#include "PathAutomaton.hpp"
+#include "PathComponents.hpp"
+
+namespace Yglob
+{
+    ComponentTrie::ComponentTrie()
+    {
+        add_node();
+    }
+
+    void ComponentTrie::add(const std::filesystem::path& pattern,
+                            GlobFlags flags, size_t index)
+    {
+        add(pattern, flags, flags, false, index);
+    }
+
+    void ComponentTrie::add(const std::filesystem::path& pattern,
+                            GlobFlags flags, GlobFlags literal_flags,
+                            size_t index)
+    {
+        add(pattern, flags, literal_flags, true, index);
+    }
+
+    void ComponentTrie::add(const std::filesystem::path& pattern,
+                            GlobFlags flags, GlobFlags literal_flags,
+                            bool is_path_iterator_pattern, size_t index)
+    {
+        auto [root, names] = split_path_pattern(pattern);
+
+        uint32_t node = 0;
+        if (!root.empty())
+        {
+            auto it = std::ranges::find_if(roots_, [&](auto& r)
+            {
+                return is_same_root(r.first, root, false);
+            });
+            if (it != roots_.end())
+            {
+                node = it->second;
+            }
+            else
+            {
+                node = add_node();
+                roots_.emplace_back(root, node);
+            }
+        }
+
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            const auto& name = names[i];
+            node = add_child(node, name,
+                             is_glob_pattern(name, flags) ? flags : literal_flags,
+                             is_path_iterator_pattern && i + 1 == names.size());
+        }
+
+        nodes_[node].patterns.push_back(index);
+    }
+
+    void ComponentTrie::start(std::string_view root,
+                              NodeList& nodes) const
+    {
+        if (root.empty())
+        {
+            add_with_closure(0, nodes);
+            return;
+        }
+
+        for (const auto& [r, node] : roots_)
+        {
+            if (is_same_root(root, r, false))
+            {
+                add_with_closure(node, nodes);
+                break;
+            }
+        }
+
+        // Relative patterns that start with `**` also match absolute paths.
+        if (nodes_[0].any_path != NONE)
+            add_with_closure(nodes_[0].any_path, nodes);
+        if (nodes_[0].trailing_any_path != NONE)
+            nodes.push_back(nodes_[0].trailing_any_path);
+    }
+
+    void ComponentTrie::advance(const NodeList& from,
+                                std::string_view component,
+                                NodeList& to) const
+    {
+        to.clear();
+        for (auto index : from)
+            advance(nodes_[index], component, to);
+
+        if (to.size() > 1)
+        {
+            std::ranges::sort(to);
+            to.erase(std::unique(to.begin(), to.end()), to.end());
+        }
+    }
+
+    void ComponentTrie::advance(const Node& node,
+                                std::string_view component,
+                                NodeList& to) const
+    {
+        if (node.is_any_path)
+            to.push_back(uint32_t(&node - nodes_.data()));
+
+        if (node.trailing_any_path != NONE)
+            to.push_back(node.trailing_any_path);
+
+        if (!node.literals.empty())
+        {
+            if (auto it = node.literals.find(component); it != node.literals.end())
+                add_with_closure(it->second, to);
+        }
+
+        if (!node.folded_literals.empty())
+        {
+            char buffer[256];
+            std::string long_name;
+            auto folded = fold_ascii(component, buffer, sizeof(buffer));
+            if (folded.size() != component.size())
+            {
+                long_name = fold_ascii(component);
+                folded = long_name;
+            }
+            if (auto it = node.folded_literals.find(folded);
+                it != node.folded_literals.end())
+            {
+                add_with_closure(it->second, to);
+            }
+        }
+
+        for (const auto& [name, child] : node.other_literals)
+        {
+            if (ystring::case_insensitive::equal(component, name))
+                add_with_closure(child, to);
+        }
+
+        node.globs.match(component, [&](size_t i)
+        {
+            add_with_closure(node.glob_children[i], to);
+        });
+    }
+
+    uint32_t ComponentTrie::add_node(bool is_any_path)
+    {
+        nodes_.emplace_back().is_any_path = is_any_path;
+        return uint32_t(nodes_.size() - 1);
+    }
+
+    uint32_t ComponentTrie::add_child(uint32_t parent,
+                                      const std::string& name,
+                                      GlobFlags flags,
+                                      bool is_trailing)
+    {
+        auto element = make_path_element(name, flags);
+
+        if (std::holds_alternative<AnyPath>(element) && is_trailing)
+        {
+            if (nodes_[parent].trailing_any_path == NONE)
+            {
+                auto child = add_node(true);
+                nodes_[parent].trailing_any_path = child;
+            }
+            return nodes_[parent].trailing_any_path;
+        }
+
+        if (std::holds_alternative<AnyPath>(element))
+        {
+            if (nodes_[parent].any_path == NONE)
+            {
+                auto child = add_node(true);
+                nodes_[parent].any_path = child;
+            }
+            return nodes_[parent].any_path;
+        }
+
+        if (std::holds_alternative<GlobMatcher>(element))
+        {
+            auto i = nodes_[parent].globs.add(name, flags);
+            if (i == nodes_[parent].glob_children.size())
+            {
+                auto child = add_node();
+                nodes_[parent].glob_children.push_back(child);
+            }
+            return nodes_[parent].glob_children[i];
+        }
+
+        auto& literal = std::get<LiteralElement>(element);
+        if (bool(flags & GlobFlags::CASE_SENSITIVE) || literal.folded)
+        {
+            auto& map = literal.folded ? nodes_[parent].folded_literals
+                                       : nodes_[parent].literals;
+            auto it = map.find(std::string_view(literal.name));
+            if (it != map.end())
+                return it->second;
+            auto child = add_node();
+            auto& new_map = literal.folded ? nodes_[parent].folded_literals
+                                           : nodes_[parent].literals;
+            new_map.emplace(literal.name, child);
+            return child;
+        }
+
+        for (const auto& [n, child] : nodes_[parent].other_literals)
+        {
+            if (n == std::string_view(literal.name))
+                return child;
+        }
+        auto child = add_node();
+        nodes_[parent].other_literals.emplace_back(literal.name, child);
+        return child;
+    }
+
+    void ComponentTrie::add_with_closure(uint32_t node,
+                                         NodeList& nodes) const
+    {
+        while (node != NONE)
+        {
+            nodes.push_back(node);
+            node = nodes_[node].any_path;
+        }
+    }
+}
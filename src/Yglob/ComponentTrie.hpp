@@ -0,0 +1,184 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+#include "GlobSet.hpp"
+
+namespace Yglob
+{
+    /**
+     * @brief A trie of path patterns where each edge is a path component.
+     *
+     * The trie is matched like a non-deterministic automaton, with the
+     * nodes as states. A node reached through a `**` edge has a
+     * transition to itself for every component, and the parent of such a
+     * node has an empty transition to it. In patterns added the way
+     * PathIterator interprets them, a trailing `**` leads to a node
+     * without the empty transition, as it must match at least one
+     * component.
+     *
+     * The trie itself is allocated on the global heap, while the node
+     * lists used for matching are allocated from the resource they were
+     * created with.
+     */
+    class ComponentTrie
+    {
+    public:
+        static constexpr uint32_t NONE = UINT32_MAX;
+
+        /**
+         * @brief The nodes that a partially matched path has reached.
+         */
+        using NodeList = std::pmr::vector<uint32_t>;
+
+        struct Node
+        {
+            using LiteralMap = std::unordered_map<
+                std::string, uint32_t, StringHash, std::equal_to<>>;
+
+            /**
+             * @brief Children whose names are compared case-sensitively.
+             */
+            LiteralMap literals;
+            /**
+             * @brief Children whose names are ASCII and compared
+             *      case-insensitively. The keys are in lower case.
+             */
+            LiteralMap folded_literals;
+            /**
+             * @brief Children whose names contain non-ASCII characters
+             *      and are compared case-insensitively.
+             */
+            std::vector<std::pair<std::string, uint32_t>> other_literals;
+            GlobSet globs;
+            /**
+             * @brief The child for each pattern in globs.
+             */
+            std::vector<uint32_t> glob_children;
+            uint32_t any_path = NONE;
+            /**
+             * @brief The child for a trailing `**` that must match at
+             *      least one component, reached by consuming any
+             *      component rather than through an empty transition.
+             */
+            uint32_t trailing_any_path = NONE;
+            bool is_any_path = false;
+            /**
+             * @brief The indexes of the patterns that end in this node.
+             */
+            std::vector<size_t> patterns;
+
+            /**
+             * @brief Returns true if paths that reach this node can reach
+             *      other nodes by consuming more components.
+             */
+            [[nodiscard]]
+            bool has_successors() const
+            {
+                return is_any_path || any_path != NONE
+                       || trailing_any_path != NONE || !literals.empty()
+                       || !folded_literals.empty() || !other_literals.empty()
+                       || !globs.empty();
+            }
+
+            /**
+             * @brief Returns true if all the successors of this node are
+             *      reached through case-sensitive names, which can be
+             *      looked up directly.
+             */
+            [[nodiscard]]
+            bool has_only_plain_names() const
+            {
+                return !is_any_path && any_path == NONE
+                       && trailing_any_path == NONE
+                       && folded_literals.empty() && other_literals.empty()
+                       && globs.empty();
+            }
+        };
+
+        ComponentTrie();
+
+        void add(const std::filesystem::path& pattern, GlobFlags flags,
+                 size_t index);
+
+        /**
+         * @brief Adds @a pattern the way PathIterator interprets it.
+         *
+         * The components that aren't glob patterns are compared
+         * according to @a literal_flags, and a trailing `**` only
+         * matches paths below the directory it is in, not the directory
+         * itself.
+         */
+        void add(const std::filesystem::path& pattern, GlobFlags flags,
+                 GlobFlags literal_flags, size_t index);
+
+        /**
+         * @brief Appends the initial nodes for a path with the given root,
+         *      which is empty for relative paths, to @a nodes.
+         */
+        void start(std::string_view root, NodeList& nodes) const;
+
+        /**
+         * @brief Assigns the nodes reached from @a from by consuming
+         *      @a component to @a to.
+         *
+         * The nodes in @a to are sorted and unique.
+         */
+        void advance(const NodeList& from,
+                     std::string_view component,
+                     NodeList& to) const;
+
+        /**
+         * @brief Appends @a node and the nodes reachable from it through
+         *      empty transitions to @a nodes.
+         */
+        void add_with_closure(uint32_t node, NodeList& nodes) const;
+
+        [[nodiscard]]
+        const Node& node(uint32_t index) const
+        {
+            return nodes_[index];
+        }
+
+        [[nodiscard]]
+        const std::vector<Node>& nodes() const
+        {
+            return nodes_;
+        }
+
+        [[nodiscard]]
+        const std::vector<std::pair<std::string, uint32_t>>& roots() const
+        {
+            return roots_;
+        }
+    private:
+        uint32_t add_node(bool is_any_path = false);
+
+        void add(const std::filesystem::path& pattern, GlobFlags flags,
+                 GlobFlags literal_flags, bool is_path_iterator_pattern,
+                 size_t index);
+
+        uint32_t add_child(uint32_t parent, const std::string& name,
+                           GlobFlags flags, bool is_trailing);
+
+        void advance(const Node& node, std::string_view component,
+                     NodeList& to) const;
+
+        std::vector<Node> nodes_;
+        /**
+         * @brief The root strings of absolute patterns and their nodes.
+         *
+         * Node 0 is the root of the relative patterns.
+         */
+        std::vector<std::pair<std::string, uint32_t>> roots_;
+    };
+}
@@ -0,0 +1,150 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yglob/DirectoryCache.hpp"
+
+#include <chrono>
+#include "DirectoryCacheImpl.hpp"
+
+namespace Yglob
+{
+    namespace
+    {
+        template <typename T>
+        bool is_ready(const std::shared_future<T>& future)
+        {
+            using namespace std::chrono_literals;
+            return future.wait_for(0s) == std::future_status::ready;
+        }
+    }
+
+    std::shared_ptr<const DirectoryCache::Listing>
+    DirectoryCache::DirectoryCacheImpl::listing(
+            const std::filesystem::path& directory,
+            std::filesystem::directory_options options)
+    {
+        auto stamp = get_file_stamp(directory);
+        if (!stamp)
+            return RealFileSystem().list_directory(directory, options);
+
+        auto key = std::filesystem::absolute(directory).lexically_normal();
+        std::unique_lock lock(mutex_);
+        auto& cached = slots_[key.native()];
+        if (cached && is_same_version(cached->stamp, *stamp)
+            && cached->options == options
+            && (!cached->is_racy || !is_ready(cached->listing)))
+        {
+            cached->is_used = true;
+            // The listing might still be in the process of being read
+            // by another thread, don't wait while holding the lock.
+            auto future = cached->listing;
+            lock.unlock();
+            return future.get();
+        }
+
+        std::promise<std::shared_ptr<const Listing>> promise;
+        auto slot = std::make_shared<Slot>();
+        slot->stamp = *stamp;
+        slot->options = options;
+        slot->is_racy = is_recently_changed(*stamp);
+        slot->is_used = true;
+        slot->listing = promise.get_future().share();
+        cached = slot;
+        lock.unlock();
+
+        try
+        {
+            auto result = RealFileSystem().list_directory(directory, options);
+            promise.set_value(result);
+            return result;
+        }
+        catch (...)
+        {
+            // Remove the slot before the exception is stored, failed
+            // listings must never be returned by used_listings.
+            lock.lock();
+            if (auto it = slots_.find(key.native());
+                it != slots_.end() && it->second == slot)
+            {
+                slots_.erase(it);
+            }
+            lock.unlock();
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+    }
+
+    void DirectoryCache::DirectoryCacheImpl::clear()
+    {
+        std::lock_guard lock(mutex_);
+        slots_.clear();
+    }
+
+    size_t DirectoryCache::DirectoryCacheImpl::size() const
+    {
+        std::lock_guard lock(mutex_);
+        return slots_.size();
+    }
+
+    void DirectoryCache::DirectoryCacheImpl::add_listing(StampedListing listing)
+    {
+        std::promise<std::shared_ptr<const Listing>> promise;
+        promise.set_value(std::move(listing.listing));
+        auto slot = std::make_shared<Slot>();
+        slot->stamp = listing.stamp;
+        slot->options = listing.options;
+        slot->listing = promise.get_future().share();
+
+        std::lock_guard lock(mutex_);
+        slots_[listing.directory.native()] = std::move(slot);
+    }
+
+    std::vector<DirectoryCache::DirectoryCacheImpl::StampedListing>
+    DirectoryCache::DirectoryCacheImpl::used_listings() const
+    {
+        std::vector<StampedListing> result;
+        std::lock_guard lock(mutex_);
+        for (const auto& [key, slot] : slots_)
+        {
+            if (!slot->is_used || slot->is_racy || !is_ready(slot->listing))
+                continue;
+            result.push_back({std::filesystem::path(key), slot->stamp,
+                              slot->options, slot->listing.get()});
+        }
+        return result;
+    }
+
+    DirectoryCache::DirectoryCache()
+        : impl_(std::make_unique<DirectoryCacheImpl>())
+    {}
+
+    DirectoryCache::~DirectoryCache() = default;
+
+    std::shared_ptr<const DirectoryCache::Listing>
+    DirectoryCache::listing(const std::filesystem::path& directory,
+                            std::filesystem::directory_options options)
+    {
+        return impl_->listing(directory, options);
+    }
+
+    std::shared_ptr<const DirectoryCache::Listing>
+    DirectoryCache::list_directory(const std::filesystem::path& directory,
+                                   std::filesystem::directory_options options)
+    {
+        return impl_->listing(directory, options);
+    }
+
+    void DirectoryCache::clear()
+    {
+        impl_->clear();
+    }
+
+    size_t DirectoryCache::size() const
+    {
+        return impl_->size();
+    }
+}
@@ -0,0 +1,76 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <future>
+#include <mutex>
+#include <unordered_map>
+#include "Yglob/DirectoryCache.hpp"
+#include "FileStamp.hpp"
+
+namespace Yglob
+{
+    class DirectoryCache::DirectoryCacheImpl
+    {
+    public:
+        /**
+         * @brief A listing together with the stamp of its directory.
+         */
+        struct StampedListing
+        {
+            /**
+             * @brief The absolute and normalized path of the directory.
+             */
+            std::filesystem::path directory;
+            FileStamp stamp;
+            std::filesystem::directory_options options = {};
+            std::shared_ptr<const Listing> listing;
+        };
+
+        std::shared_ptr<const Listing>
+        listing(const std::filesystem::path& directory,
+                std::filesystem::directory_options options);
+
+        void clear();
+
+        [[nodiscard]]
+        size_t size() const;
+
+        /**
+         * @brief Adds a listing that was read earlier, for instance by
+         *      another process.
+         *
+         * The listing is only used if its directory still has the same
+         * stamp.
+         */
+        void add_listing(StampedListing listing);
+
+        /**
+         * @brief Returns the listings that have been requested since they
+         *      were read or added, and that can be reused later.
+         */
+        [[nodiscard]]
+        std::vector<StampedListing> used_listings() const;
+    private:
+        struct Slot
+        {
+            FileStamp stamp;
+            std::filesystem::directory_options options = {};
+            /**
+             * @brief True if the directory was modified so shortly before
+             *      it was read that the listing can't be trusted later.
+             */
+            bool is_racy = false;
+            bool is_used = false;
+            std::shared_future<std::shared_ptr<const Listing>> listing;
+        };
+
+        mutable std::mutex mutex_;
+        std::unordered_map<std::filesystem::path::string_type,
+                           std::shared_ptr<Slot>> slots_;
+    };
+}
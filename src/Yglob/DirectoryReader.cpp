@@ -0,0 +1,174 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "DirectoryReader.hpp"
+
+#include <Ystring/Algorithms.hpp>
+#include "FileStatusBatch.hpp"
+
+namespace Yglob
+{
+    namespace
+    {
+        std::filesystem::path from_string(std::string_view str)
+        {
+            return {std::u8string_view(reinterpret_cast<const char8_t*>(str.data()),
+                                       str.size())};
+        }
+
+        const std::filesystem::path& non_empty(const std::filesystem::path& dir)
+        {
+            static const std::filesystem::path current_dir(".");
+            return dir.empty() ? current_dir : dir;
+        }
+    }
+
+    DirectoryReader::DirectoryReader(std::filesystem::path dir,
+                                     std::filesystem::directory_options options,
+                                     FileSystem* file_system)
+        : dir_(std::move(dir))
+    {
+        if (file_system)
+        {
+            listing_ = file_system->list_directory(non_empty(dir_), options);
+        }
+        else
+        {
+            it_ = std::filesystem::directory_iterator(non_empty(dir_), options);
+            is_iterating_ = true;
+        }
+    }
+
+    DirectoryReader::DirectoryReader(std::filesystem::path dir,
+                                     std::vector<std::string> names,
+                                     FileSystem* file_system)
+        : dir_(std::move(dir)),
+          names_(std::move(names)),
+          file_system_(file_system)
+    {}
+
+    bool DirectoryReader::next()
+    {
+        if (listing_)
+        {
+            if (index_ == listing_->size())
+                return false;
+            set_path(from_string((*listing_)[index_++].name));
+            return true;
+        }
+
+        if (is_iterating_)
+        {
+            // The iterator is advanced here rather than after reading the
+            // entry, so that the current entry can be used without
+            // copying it.
+            if (index_++ != 0 && it_ != std::filesystem::directory_iterator())
+                ++it_;
+            if (it_ == std::filesystem::directory_iterator())
+                return false;
+
+            const auto& path = it_->path();
+            if constexpr (std::is_same_v<std::filesystem::path::value_type, char>)
+            {
+                std::string_view str(path.native());
+                name_.assign(str.substr(str.find_last_of('/') + 1));
+            }
+            else
+            {
+                auto name = path.filename().generic_u8string();
+                name_.assign(ystring::to_string_view(name));
+            }
+            if (dir_.empty())
+                path_ = path.filename();
+            return true;
+        }
+
+        // The names are looked up all at once, which lets the file
+        // system, or get_file_statuses(), handle them in one batch.
+        if (index_ == 0 && statuses_.empty() && !names_.empty())
+        {
+            std::vector<std::filesystem::path> paths;
+            paths.reserve(names_.size());
+            for (const auto& name : names_)
+            {
+                set_path(from_string(name));
+                paths.push_back(path_);
+            }
+            if (file_system_)
+                file_system_->get_statuses(paths, statuses_);
+            else
+                get_file_statuses(paths, statuses_);
+        }
+
+        while (index_ < names_.size())
+        {
+            if (!statuses_[index_++].exists())
+                continue;
+            name_ = names_[index_ - 1];
+            set_path(from_string(name_));
+            return true;
+        }
+        return false;
+    }
+
+    const std::filesystem::path& DirectoryReader::path() const
+    {
+        if (is_iterating_ && !dir_.empty())
+            return it_->path();
+        return path_;
+    }
+
+    std::string_view DirectoryReader::name() const
+    {
+        if (listing_)
+            return (*listing_)[index_ - 1].name;
+        return name_;
+    }
+
+    bool DirectoryReader::is_directory() const
+    {
+        return type() == std::filesystem::file_type::directory;
+    }
+
+    bool DirectoryReader::is_regular_file() const
+    {
+        return type() == std::filesystem::file_type::regular;
+    }
+
+    bool DirectoryReader::is_symlink() const
+    {
+        if (listing_)
+            return (*listing_)[index_ - 1].is_symlink;
+        if (!is_iterating_)
+            return statuses_[index_ - 1].is_symlink;
+        std::error_code ec;
+        return it_->is_symlink(ec);
+    }
+
+    std::filesystem::file_type DirectoryReader::type() const
+    {
+        if (listing_)
+            return (*listing_)[index_ - 1].type;
+        if (!is_iterating_)
+            return statuses_[index_ - 1].type;
+        return get_file_type(*it_);
+    }
+
+    void DirectoryReader::set_path(const std::filesystem::path& name)
+    {
+        if (dir_.empty())
+        {
+            path_ = name;
+        }
+        else
+        {
+            // Assigning and appending reuses the memory path_ already has.
+            path_ = dir_;
+            path_ /= name;
+        }
+    }
+}
@@ -0,0 +1,123 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Yglob/FileSystem.hpp"
+
+namespace Yglob
+{
+    /**
+     * @brief Produces the entries in a directory, either by reading it
+     *      directly, by getting its listing from a FileSystem, or by
+     *      looking up a given set of names.
+     *
+     * The paths of the entries are the directory's path followed by the
+     * entry names. If the directory's path is empty, the entries are
+     * read from the current directory and their paths are just the
+     * names.
+     */
+    class DirectoryReader
+    {
+    public:
+        /**
+         * @brief Creates a reader without any entries.
+         */
+        DirectoryReader() = default;
+
+        /**
+         * @brief Creates a reader for the entries in @a dir.
+         *
+         * The listing is taken from @a file_system if it isn't null,
+         * otherwise the directory is read directly.
+         */
+        DirectoryReader(std::filesystem::path dir,
+                        std::filesystem::directory_options options,
+                        FileSystem* file_system);
+
+        /**
+         * @brief Creates a reader for the entries in @a dir whose names
+         *      are in @a names, without reading the directory.
+         *
+         * The names are looked up in @a file_system if it isn't null.
+         */
+        DirectoryReader(std::filesystem::path dir,
+                        std::vector<std::string> names,
+                        FileSystem* file_system = nullptr);
+
+        /**
+         * @brief Moves to the next entry, returns false if there are
+         *      no more entries.
+         */
+        bool next();
+
+        [[nodiscard]]
+        const std::filesystem::path& dir() const
+        {
+            return dir_;
+        }
+
+        [[nodiscard]]
+        const std::filesystem::path& path() const;
+
+        /**
+         * @brief The current entry's file name in UTF-8.
+         */
+        [[nodiscard]]
+        std::string_view name() const;
+
+        [[nodiscard]]
+        bool is_directory() const;
+
+        [[nodiscard]]
+        bool is_regular_file() const;
+
+        [[nodiscard]]
+        bool is_symlink() const;
+
+        /**
+         * @brief Returns true if the reader looks up given names rather
+         *      than reading the directory.
+         */
+        [[nodiscard]]
+        bool is_lookup() const
+        {
+            return !is_iterating_ && !listing_;
+        }
+    private:
+        [[nodiscard]]
+        std::filesystem::file_type type() const;
+
+        void set_path(const std::filesystem::path& name);
+
+        std::filesystem::path dir_;
+        /**
+         * @brief The current path, except when reading a directory that
+         *      isn't the current directory, where it is the iterator's
+         *      path.
+         */
+        std::filesystem::path path_;
+        std::filesystem::directory_iterator it_;
+        std::string name_;
+        std::shared_ptr<const FileSystem::Listing> listing_;
+        std::vector<std::string> names_;
+        /**
+         * @brief The statuses of the files in names_.
+         */
+        std::vector<FileSystem::Status> statuses_;
+        FileSystem* file_system_ = nullptr;
+        /**
+         * @brief The index of the next entry in listing_ or names_, or
+         *      the number of entries read from it_.
+         */
+        size_t index_ = 0;
+        bool is_iterating_ = false;
+    };
+}
@@ -0,0 +1,74 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "EntryFilter.hpp"
+
+#include "Yglob/PathMatcher.hpp"
+#include "FlagConversion.hpp"
+
+namespace Yglob
+{
+    void EntryFilter::set_exclude_patterns(PathMatcherSet patterns)
+    {
+        exclude_patterns_ = std::move(patterns);
+    }
+
+    void EntryFilter::set_ignore_filter(std::unique_ptr<IgnoreFilter> filter)
+    {
+        ignore_filter_ = std::move(filter);
+    }
+
+    bool EntryFilter::is_excluded(const DirectoryReader& entry)
+    {
+        const auto& path = entry.path();
+        if (matches_exclude_patterns(path))
+            return true;
+        // The entry's type is only needed for the ignore files.
+        return ignore_filter_ && is_ignored(path, entry.is_directory());
+    }
+
+    bool EntryFilter::is_excluded(const std::filesystem::path& path,
+                                  bool is_directory)
+    {
+        return matches_exclude_patterns(path)
+               || (ignore_filter_ && is_ignored(path, is_directory));
+    }
+
+    bool EntryFilter::matches_exclude_patterns(const std::filesystem::path& path) const
+    {
+        return !exclude_patterns_.empty() && exclude_patterns_.match(path);
+    }
+
+    bool EntryFilter::is_ignored(const std::filesystem::path& path,
+                                 bool is_directory)
+    {
+        // Git's own directory is never part of the working tree.
+        if (is_directory && path.filename() == ".git")
+            return true;
+        return ignore_filter_->is_ignored_entry(path, is_directory);
+    }
+
+    std::shared_ptr<EntryFilter>
+    make_entry_filter(const std::vector<std::string>& exclude_patterns,
+                      PathIteratorFlags flags)
+    {
+        auto use_ignore_files = bool(flags & PathIteratorFlags::USE_IGNORE_FILES);
+        if (exclude_patterns.empty() && !use_ignore_files)
+            return {};
+
+        auto filter = std::make_shared<EntryFilter>();
+        if (!exclude_patterns.empty())
+        {
+            auto glob_flags = to_glob_flags(flags);
+            filter->set_exclude_patterns(PathMatcherSet(
+                simplify_patterns(exclude_patterns, glob_flags), glob_flags));
+        }
+        if (use_ignore_files)
+            filter->set_ignore_filter(std::make_unique<IgnoreFilter>());
+        return filter;
+    }
+}
@@ -0,0 +1,64 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Yglob/Flags.hpp"
+#include "Yglob/IgnoreFilter.hpp"
+#include "Yglob/PathMatcherSet.hpp"
+#include "DirectoryReader.hpp"
+
+namespace Yglob
+{
+    /**
+     * @brief Decides which directory entries the path part iterators
+     *      skip while reading directories.
+     *
+     * Excluded directories are not descended into. Entries are matched
+     * against the exclude patterns before anything else, as that only
+     * requires their paths.
+     */
+    class EntryFilter
+    {
+    public:
+        void set_exclude_patterns(PathMatcherSet patterns);
+
+        void set_ignore_filter(std::unique_ptr<IgnoreFilter> filter);
+
+        [[nodiscard]]
+        bool is_excluded(const DirectoryReader& entry);
+
+        /**
+         * @brief Returns true if the file at @a path is excluded, for
+         *      paths that weren't read from a directory.
+         */
+        [[nodiscard]]
+        bool is_excluded(const std::filesystem::path& path, bool is_directory);
+    private:
+        [[nodiscard]]
+        bool matches_exclude_patterns(const std::filesystem::path& path) const;
+
+        [[nodiscard]]
+        bool is_ignored(const std::filesystem::path& path, bool is_directory);
+
+        PathMatcherSet exclude_patterns_;
+        std::unique_ptr<IgnoreFilter> ignore_filter_;
+    };
+
+    /**
+     * @brief Returns a filter for @a exclude_patterns and the ignore
+     *      files if @a flags includes USE_IGNORE_FILES, or null if
+     *      nothing is to be excluded.
+     */
+    [[nodiscard]]
+    std::shared_ptr<EntryFilter>
+    make_entry_filter(const std::vector<std::string>& exclude_patterns,
+                      PathIteratorFlags flags);
+}
@@ -0,0 +1,278 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ExtGlobAutomaton.hpp"
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <Ystring/Algorithms.hpp>
+#include "MemoryUsage.hpp"
+
+namespace Yglob
+{
+    namespace
+    {
+        bool contains(std::span<const uint32_t> nodes, uint32_t node)
+        {
+            return std::ranges::binary_search(nodes, node);
+        }
+
+        bool equal_case_insensitive(char32_t a, char32_t b)
+        {
+            if (a < 0x80 && b < 0x80)
+            {
+                auto fold = [](char32_t c)
+                {
+                    return U'A' <= c && c <= U'Z' ? c + (U'a' - U'A') : c;
+                };
+                return fold(a) == fold(b);
+            }
+            std::string a_str, b_str;
+            ystring::append(a_str, a);
+            ystring::append(b_str, b);
+            return ystring::case_insensitive::equal(a_str, b_str);
+        }
+    }
+
+    ExtGlobAutomaton::ExtGlobAutomaton(const GlobElements& pattern,
+                                       bool case_sensitive,
+                                       std::pmr::memory_resource* resource)
+        : resource_(resource),
+          case_sensitive_(case_sensitive)
+    {
+        auto start = add_node();
+        accept_ = add(pattern, start);
+    }
+
+    bool ExtGlobAutomaton::match(std::string_view str) const
+    {
+        // The threads are allocated from a buffer on the stack, and only
+        // long strings or complex patterns need memory from resource_.
+        std::array<std::byte, 4096> buffer;
+        std::pmr::monotonic_buffer_resource memory(buffer.data(), buffer.size(),
+                                                   resource_);
+        Threads threads(&memory), next_threads(&memory);
+        add_with_closure(threads, 0);
+        while (auto ch = ystring::pop_utf8_codepoint(str))
+        {
+            next_threads.nodes.clear();
+            next_threads.negations.clear();
+            advance(threads, *ch, next_threads);
+            std::swap(threads, next_threads);
+            if (threads.nodes.empty() && threads.negations.empty())
+                return false;
+        }
+        return contains(threads.nodes, accept_);
+    }
+
+    size_t ExtGlobAutomaton::memory_usage() const
+    {
+        auto result = sizeof(ExtGlobAutomaton) + get_heap_usage(nodes_)
+                      + get_heap_usage(sets_);
+        for (const auto& node : nodes_)
+            result += get_heap_usage(node.empty_edges);
+        return result;
+    }
+
+    uint32_t ExtGlobAutomaton::add_node(NodeKind kind)
+    {
+        nodes_.emplace_back().kind = kind;
+        return uint32_t(nodes_.size() - 1);
+    }
+
+    uint32_t ExtGlobAutomaton::add_consuming_node(uint32_t from,
+                                                  NodeKind kind,
+                                                  char32_t ch,
+                                                  uint32_t index)
+    {
+        auto node = add_node(kind);
+        nodes_[node].ch = ch;
+        nodes_[node].index = index;
+        nodes_[node].next = node + 1;
+        nodes_[from].empty_edges.push_back(node);
+        return add_node();
+    }
+
+    // NOLINTBEGIN(misc-no-recursion)
+
+    uint32_t ExtGlobAutomaton::add(const GlobElements& pattern, uint32_t from)
+    {
+        for (const auto& part : pattern.parts)
+            from = add(part, from);
+        return from;
+    }
+
+    uint32_t ExtGlobAutomaton::add(const GlobElement& part, uint32_t from)
+    {
+        if (const auto* str = std::get_if<std::pmr::string>(&part))
+        {
+            std::string_view s = *str;
+            while (auto ch = ystring::pop_utf8_codepoint(s))
+                from = add_consuming_node(from, NodeKind::CHAR, *ch);
+        }
+        else if (const auto* qmark = std::get_if<QmarkElement>(&part))
+        {
+            for (size_t i = 0; i < qmark->length; ++i)
+                from = add_consuming_node(from, NodeKind::ANY);
+        }
+        else if (std::holds_alternative<StarElement>(part))
+        {
+            auto loop = add_node();
+            nodes_[from].empty_edges.push_back(loop);
+            auto end = add_consuming_node(loop, NodeKind::ANY);
+            nodes_[end].empty_edges.push_back(loop);
+            from = add_node();
+            nodes_[loop].empty_edges.push_back(from);
+        }
+        else if (const auto* set = std::get_if<ystring::CodepointSet>(&part))
+        {
+            sets_.push_back(*set);
+            from = add_consuming_node(from, NodeKind::SET, 0,
+                                      uint32_t(sets_.size() - 1));
+        }
+        else if (const auto* multi = std::get_if<MultiGlob>(&part))
+        {
+            from = add_alternatives(*multi, from);
+        }
+        else if (const auto* ext = std::get_if<ExtGlob>(&part))
+        {
+            switch (ext->kind)
+            {
+            case ExtGlobKind::ONE:
+                from = add_alternatives(ext->alternatives, from);
+                break;
+            case ExtGlobKind::ZERO_OR_ONE:
+            {
+                auto end = add_alternatives(ext->alternatives, from);
+                nodes_[from].empty_edges.push_back(end);
+                from = end;
+                break;
+            }
+            case ExtGlobKind::ZERO_OR_MORE:
+            case ExtGlobKind::ONE_OR_MORE:
+            {
+                auto loop = add_node();
+                nodes_[from].empty_edges.push_back(loop);
+                auto end = add_alternatives(ext->alternatives, loop);
+                nodes_[end].empty_edges.push_back(loop);
+                from = add_node();
+                nodes_[end].empty_edges.push_back(from);
+                if (ext->kind == ExtGlobKind::ZERO_OR_MORE)
+                    nodes_[loop].empty_edges.push_back(from);
+                break;
+            }
+            case ExtGlobKind::NONE_OF:
+            {
+                auto sub_start = add_node();
+                auto sub_accept = add_alternatives(ext->alternatives, sub_start);
+                auto negation = add_node(NodeKind::NEGATION);
+                nodes_[negation].index = sub_start;
+                nodes_[negation].sub_accept = sub_accept;
+                nodes_[from].empty_edges.push_back(negation);
+                from = add_node();
+                nodes_[negation].next = from;
+                break;
+            }
+            }
+        }
+        return from;
+    }
+
+    uint32_t ExtGlobAutomaton::add_alternatives(const MultiGlob& alternatives,
+                                                uint32_t from)
+    {
+        std::vector<uint32_t> ends;
+        for (const auto& pattern : alternatives.patterns)
+        {
+            auto start = add_node();
+            nodes_[from].empty_edges.push_back(start);
+            ends.push_back(add(*pattern, start));
+        }
+        auto end = add_node();
+        for (auto e : ends)
+            nodes_[e].empty_edges.push_back(end);
+        return end;
+    }
+
+    void ExtGlobAutomaton::add_with_closure(Threads& threads,
+                                            uint32_t node) const
+    {
+        auto it = std::ranges::lower_bound(threads.nodes, node);
+        if (it != threads.nodes.end() && *it == node)
+            return;
+        threads.nodes.insert(it, node);
+
+        const auto& n = nodes_[node];
+        if (n.kind == NodeKind::EMPTY)
+        {
+            for (auto next : n.empty_edges)
+                add_with_closure(threads, next);
+        }
+        else if (n.kind == NodeKind::NEGATION)
+        {
+            Threads sub_threads(threads.nodes.get_allocator());
+            sub_threads.negation = node;
+            add_with_closure(sub_threads, n.index);
+            const auto sub_match = contains(sub_threads.nodes, n.sub_accept);
+            if (std::ranges::find(threads.negations, sub_threads)
+                == threads.negations.end())
+            {
+                threads.negations.push_back(std::move(sub_threads));
+            }
+            // The negation matches the empty string unless one of the
+            // alternatives does.
+            if (!sub_match)
+                add_with_closure(threads, n.next);
+        }
+    }
+
+    void ExtGlobAutomaton::advance(const Threads& from, char32_t ch,
+                                   Threads& to) const
+    {
+        for (auto index : from.nodes)
+        {
+            const auto& node = nodes_[index];
+            if (node.kind != NodeKind::EMPTY && node.kind != NodeKind::NEGATION
+                && match(node, ch))
+            {
+                add_with_closure(to, node.next);
+            }
+        }
+
+        for (const auto& negation : from.negations)
+        {
+            Threads sub_threads(to.nodes.get_allocator());
+            sub_threads.negation = negation.negation;
+            advance(negation, ch, sub_threads);
+            const auto& node = nodes_[negation.negation];
+            const auto sub_match = contains(sub_threads.nodes, node.sub_accept);
+            if (std::ranges::find(to.negations, sub_threads) == to.negations.end())
+                to.negations.push_back(std::move(sub_threads));
+            if (!sub_match)
+                add_with_closure(to, node.next);
+        }
+    }
+
+    // NOLINTEND(misc-no-recursion)
+
+    bool ExtGlobAutomaton::match(const Node& node, char32_t ch) const
+    {
+        switch (node.kind)
+        {
+        case NodeKind::CHAR:
+            return case_sensitive_ ? ch == node.ch
+                                   : equal_case_insensitive(ch, node.ch);
+        case NodeKind::SET:
+            return case_sensitive_
+                   ? sets_[node.index].contains(ch)
+                   : sets_[node.index].case_insensitive_contains(ch);
+        default:
+            return true;
+        }
+    }
+}
@@ -0,0 +1,159 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+#include "GlobElements.hpp"
+
+namespace Yglob
+{
+    /**
+     * @brief A non-deterministic automaton for glob patterns with
+     *      extended globs.
+     *
+     * Each transition consumes a single codepoint. A `!(...)` is a node
+     * with its own sub-automaton for the alternatives. While the string
+     * is matched, the node keeps the states of the sub-automaton for the
+     * part of the string it has consumed, and passes control on to the
+     * following node whenever the sub-automaton is not in its accepting
+     * state. The string is therefore matched in a single pass, no matter
+     * how many negations the pattern contains.
+     *
+     * The automaton doesn't refer to the GlobElements it was created
+     * from.
+     */
+    class ExtGlobAutomaton
+    {
+    public:
+        /**
+         * @brief Creates the automaton for @a pattern.
+         *
+         * The nodes and sets of the automaton are allocated on the global
+         * heap. @a resource only provides the memory for matching that
+         * doesn't fit in a buffer on the stack, and must outlive the
+         * automaton.
+         */
+        ExtGlobAutomaton(const GlobElements& pattern, bool case_sensitive,
+                         std::pmr::memory_resource* resource
+                             = std::pmr::get_default_resource());
+
+        [[nodiscard]]
+        bool match(std::string_view str) const;
+
+        /**
+         * @brief Returns the approximate number of bytes used by the
+         *      automaton, including the object itself.
+         */
+        [[nodiscard]]
+        size_t memory_usage() const;
+    private:
+        enum class NodeKind
+        {
+            EMPTY,
+            CHAR,
+            ANY,
+            SET,
+            NEGATION
+        };
+
+        struct Node
+        {
+            NodeKind kind = NodeKind::EMPTY;
+            char32_t ch = 0;
+            /**
+             * @brief The index of the character set for SET nodes, and
+             *      the start of the sub-automaton for NEGATION nodes.
+             */
+            uint32_t index = 0;
+            /**
+             * @brief The accepting node of a NEGATION node's
+             *      sub-automaton.
+             */
+            uint32_t sub_accept = 0;
+            /**
+             * @brief The node reached after consuming a codepoint, or
+             *      after a NEGATION node.
+             */
+            uint32_t next = 0;
+            std::vector<uint32_t> empty_edges;
+        };
+
+        /**
+         * @brief The active nodes in an automaton or a sub-automaton.
+         */
+        struct Threads
+        {
+            using allocator_type = std::pmr::polymorphic_allocator<>;
+
+            explicit Threads(const allocator_type& alloc = {})
+                : nodes(alloc),
+                  negations(alloc)
+            {}
+
+            Threads(const Threads& rhs, const allocator_type& alloc)
+                : negation(rhs.negation),
+                  nodes(rhs.nodes, alloc),
+                  negations(rhs.negations, alloc)
+            {}
+
+            Threads(Threads&& rhs, const allocator_type& alloc)
+                : negation(rhs.negation),
+                  nodes(std::move(rhs.nodes), alloc),
+                  negations(std::move(rhs.negations), alloc)
+            {}
+
+            Threads(const Threads&) = default;
+
+            Threads(Threads&&) noexcept = default;
+
+            Threads& operator=(const Threads&) = default;
+
+            Threads& operator=(Threads&&) noexcept = default;
+
+            /**
+             * @brief The NEGATION node this is the sub-automaton of.
+             */
+            uint32_t negation = 0;
+            std::pmr::vector<uint32_t> nodes;
+            std::pmr::vector<Threads> negations;
+
+            friend bool operator==(const Threads&, const Threads&) = default;
+        };
+
+        uint32_t add_node(NodeKind kind = NodeKind::EMPTY);
+
+        /**
+         * @brief Adds a node that consumes a codepoint, and returns the
+         *      node it leads to.
+         */
+        uint32_t add_consuming_node(uint32_t from, NodeKind kind,
+                                    char32_t ch = 0, uint32_t index = 0);
+
+        uint32_t add(const GlobElements& pattern, uint32_t from);
+
+        uint32_t add(const GlobElement& part, uint32_t from);
+
+        uint32_t add_alternatives(const MultiGlob& alternatives,
+                                  uint32_t from);
+
+        void add_with_closure(Threads& threads, uint32_t node) const;
+
+        void advance(const Threads& from, char32_t ch, Threads& to) const;
+
+        [[nodiscard]]
+        bool match(const Node& node, char32_t ch) const;
+
+        std::vector<Node> nodes_;
+        std::vector<ystring::CodepointSet> sets_;
+        std::pmr::memory_resource* resource_;
+        uint32_t accept_ = 0;
+        bool case_sensitive_ = true;
+    };
+}
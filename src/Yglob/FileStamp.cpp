@@ -0,0 +1,154 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "FileStamp.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#ifndef _WIN32
+    #include <sys/stat.h>
+#endif
+
+namespace Yglob
+{
+    namespace
+    {
+        constexpr std::filesystem::file_type FILE_TYPES[] = {
+            std::filesystem::file_type::none,
+            std::filesystem::file_type::regular,
+            std::filesystem::file_type::directory,
+            std::filesystem::file_type::symlink,
+            std::filesystem::file_type::block,
+            std::filesystem::file_type::character,
+            std::filesystem::file_type::fifo,
+            std::filesystem::file_type::socket,
+            std::filesystem::file_type::unknown
+        };
+    }
+
+    bool is_same_version(const FileStamp& a, const FileStamp& b)
+    {
+        return a.type == b.type && a.size == b.size
+               && a.modified == b.modified && a.changed == b.changed
+               && a.device == b.device && a.inode == b.inode;
+    }
+
+    bool is_recently_changed(const FileStamp& stamp)
+    {
+        // File systems with timestamps in whole seconds (or worse) are
+        // recognized by their timestamps' missing fractions. Others
+        // still only update their clocks every few milliseconds.
+        auto period = NS_PER_SECOND / 50;
+        if (stamp.modified % NS_PER_SECOND == 0
+            && stamp.changed % NS_PER_SECOND == 0)
+        {
+            period = 2 * NS_PER_SECOND;
+        }
+        auto age = get_current_file_time() - std::max(stamp.modified, stamp.changed);
+        return age < period;
+    }
+
+    uint8_t encode_file_type(std::filesystem::file_type type)
+    {
+        auto it = std::ranges::find(FILE_TYPES, type);
+        if (it == std::end(FILE_TYPES))
+            return uint8_t(std::size(FILE_TYPES) - 1);
+        return uint8_t(it - std::begin(FILE_TYPES));
+    }
+
+    std::filesystem::file_type decode_file_type(uint8_t type)
+    {
+        if (type >= std::size(FILE_TYPES))
+            return std::filesystem::file_type::unknown;
+        return FILE_TYPES[type];
+    }
+
+#ifdef _WIN32
+    std::optional<FileStamp> get_file_stamp(const std::filesystem::path& path,
+                                            bool follow_symlinks)
+    {
+        std::error_code ec;
+        auto status = follow_symlinks ? std::filesystem::status(path, ec)
+                                      : std::filesystem::symlink_status(path, ec);
+        if (ec || !std::filesystem::exists(status))
+            return {};
+
+        using namespace std::chrono;
+        FileStamp stamp;
+        stamp.type = status.type();
+        if (stamp.type == std::filesystem::file_type::regular)
+            stamp.size = std::filesystem::file_size(path, ec);
+        auto time = std::filesystem::last_write_time(path, ec);
+        stamp.modified = duration_cast<nanoseconds>(time.time_since_epoch()).count();
+        stamp.changed = stamp.modified;
+        return stamp;
+    }
+
+    int64_t get_current_file_time()
+    {
+        using namespace std::chrono;
+        auto time = std::filesystem::file_time_type::clock::now();
+        return duration_cast<nanoseconds>(time.time_since_epoch()).count();
+    }
+#else
+    namespace
+    {
+        std::filesystem::file_type to_file_type(mode_t mode)
+        {
+            using std::filesystem::file_type;
+            if (S_ISREG(mode))
+                return file_type::regular;
+            if (S_ISDIR(mode))
+                return file_type::directory;
+            if (S_ISLNK(mode))
+                return file_type::symlink;
+            if (S_ISBLK(mode))
+                return file_type::block;
+            if (S_ISCHR(mode))
+                return file_type::character;
+            if (S_ISFIFO(mode))
+                return file_type::fifo;
+            if (S_ISSOCK(mode))
+                return file_type::socket;
+            return file_type::unknown;
+        }
+    }
+
+    std::optional<FileStamp> get_file_stamp(const std::filesystem::path& path,
+                                            bool follow_symlinks)
+    {
+        struct stat st = {};
+        auto result = follow_symlinks ? ::stat(path.c_str(), &st)
+                                      : ::lstat(path.c_str(), &st);
+        if (result != 0)
+            return {};
+
+        FileStamp stamp;
+        stamp.type = to_file_type(st.st_mode);
+        if (stamp.type == std::filesystem::file_type::regular)
+            stamp.size = uint64_t(st.st_size);
+    #ifdef __APPLE__
+        stamp.modified = st.st_mtimespec.tv_sec * NS_PER_SECOND + st.st_mtimespec.tv_nsec;
+        stamp.changed = st.st_ctimespec.tv_sec * NS_PER_SECOND + st.st_ctimespec.tv_nsec;
+    #else
+        stamp.modified = st.st_mtim.tv_sec * NS_PER_SECOND + st.st_mtim.tv_nsec;
+        stamp.changed = st.st_ctim.tv_sec * NS_PER_SECOND + st.st_ctim.tv_nsec;
+    #endif
+        stamp.device = uint64_t(st.st_dev);
+        stamp.inode = uint64_t(st.st_ino);
+        return stamp;
+    }
+
+    int64_t get_current_file_time()
+    {
+        using namespace std::chrono;
+        auto time = system_clock::now();
+        return duration_cast<nanoseconds>(time.time_since_epoch()).count();
+    }
+#endif
+}
@@ -0,0 +1,78 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+
+namespace Yglob
+{
+    constexpr int64_t NS_PER_SECOND = 1'000'000'000;
+
+    /**
+     * @brief The information from a single stat call that is used to
+     *      detect changes to files and directories.
+     *
+     * Times are in nanoseconds since the epoch of the file system's
+     * clock. On systems without status change times, @a changed is the
+     * same as @a modified, and @a device and @a inode are 0.
+     */
+    struct FileStamp
+    {
+        std::filesystem::file_type type = std::filesystem::file_type::none;
+        uint64_t size = 0;
+        int64_t modified = 0;
+        int64_t changed = 0;
+        uint64_t device = 0;
+        uint64_t inode = 0;
+    };
+
+    /**
+     * @brief Returns true if @a a and @a b are stamps of the same version
+     *      of the same file or directory.
+     */
+    [[nodiscard]]
+    bool is_same_version(const FileStamp& a, const FileStamp& b);
+
+    /**
+     * @brief Returns the stamp of @a path, or nothing if it doesn't exist
+     *      or can't be accessed.
+     */
+    [[nodiscard]]
+    std::optional<FileStamp> get_file_stamp(const std::filesystem::path& path,
+                                            bool follow_symlinks = true);
+
+    /**
+     * @brief Returns true if the file or directory changed so recently
+     *      that later changes could get the same timestamps.
+     *
+     * A file or directory whose stamp is recently changed can't be
+     * assumed to be unchanged just because its stamp is the same later.
+     */
+    [[nodiscard]]
+    bool is_recently_changed(const FileStamp& stamp);
+
+    /**
+     * @brief Returns a number that represents @a type in files.
+     *
+     * The values of std::filesystem::file_type vary between
+     * implementations, the encoded values don't.
+     */
+    [[nodiscard]]
+    uint8_t encode_file_type(std::filesystem::file_type type);
+
+    [[nodiscard]]
+    std::filesystem::file_type decode_file_type(uint8_t type);
+
+    /**
+     * @brief Returns the current time on the same clock as the times in
+     *      FileStamp.
+     */
+    [[nodiscard]]
+    int64_t get_current_file_time();
+}
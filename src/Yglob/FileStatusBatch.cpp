@@ -0,0 +1,413 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "FileStatusBatch.hpp"
+
+#if defined(__linux__) && defined(YGLOB_IO_URING)
+    #include <algorithm>
+    #include <array>
+    #include <atomic>
+    #include <cerrno>
+    #include <memory>
+    #include <string>
+    #include <fcntl.h>
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #define YGLOB_USE_IO_URING
+#endif
+
+namespace Yglob
+{
+    namespace
+    {
+#ifdef YGLOB_USE_IO_URING
+        std::filesystem::file_type to_file_type(uint16_t mode)
+        {
+            using std::filesystem::file_type;
+            switch (mode & S_IFMT)
+            {
+            case S_IFREG: return file_type::regular;
+            case S_IFDIR: return file_type::directory;
+            case S_IFLNK: return file_type::symlink;
+            case S_IFBLK: return file_type::block;
+            case S_IFCHR: return file_type::character;
+            case S_IFIFO: return file_type::fifo;
+            case S_IFSOCK: return file_type::socket;
+            default: return file_type::unknown;
+            }
+        }
+
+        std::filesystem::file_type to_file_type(int result,
+                                                const struct statx& buffer)
+        {
+            if (result == 0)
+                return to_file_type(buffer.stx_mode);
+            if (result == -ENOENT || result == -ENOTDIR)
+                return std::filesystem::file_type::not_found;
+            return std::filesystem::file_type::none;
+        }
+
+        /**
+         * @brief A minimal io_uring, set up with the raw system calls to
+         *      avoid depending on liburing.
+         */
+        class IoUring
+        {
+        public:
+            static constexpr unsigned SIZE = 64;
+
+            /**
+             * @brief Returns the ring for the current thread, or null if
+             *      io_uring can't be used.
+             */
+            static IoUring* get()
+            {
+                // 0: unknown, 1: available, 2: unavailable.
+                static std::atomic<int> availability = 0;
+                thread_local std::unique_ptr<IoUring> ring;
+                if (ring)
+                    return ring->is_valid() ? ring.get() : nullptr;
+                if (availability.load(std::memory_order_relaxed) == 2)
+                    return nullptr;
+
+                auto new_ring = std::unique_ptr<IoUring>(new IoUring);
+                if (!new_ring->is_valid())
+                {
+                    availability = 2;
+                    return nullptr;
+                }
+                availability = 1;
+                ring = std::move(new_ring);
+                return ring.get();
+            }
+
+            IoUring(const IoUring&) = delete;
+
+            IoUring& operator=(const IoUring&) = delete;
+
+            ~IoUring()
+            {
+                if (sqes_)
+                    munmap(sqes_, sqes_size_);
+                if (cq_ring_ && cq_ring_ != sq_ring_)
+                    munmap(cq_ring_, cq_ring_size_);
+                if (sq_ring_)
+                    munmap(sq_ring_, sq_ring_size_);
+                if (fd_ >= 0)
+                    close(fd_);
+            }
+
+            [[nodiscard]]
+            bool is_valid() const
+            {
+                return sqes_ != nullptr && !has_failed_;
+            }
+
+            /**
+             * @brief Runs statx on @a paths[i] for each i in @a indexes,
+             *      and waits for all of them to complete.
+             *
+             * Returns false if the kernel doesn't accept the requests.
+             */
+            bool statx(const std::vector<std::filesystem::path>& paths,
+                       const std::vector<size_t>& indexes,
+                       int flags,
+                       std::vector<struct statx>& buffers,
+                       std::vector<int>& results)
+            {
+                for (size_t i = 0; i < indexes.size(); i += SIZE)
+                {
+                    auto count = std::min<size_t>(indexes.size() - i, SIZE);
+                    for (size_t j = 0; j < count; ++j)
+                    {
+                        // The kernel reads the path and writes the buffer
+                        // asynchronously, so both belong to the ring.
+                        paths_[j] = paths[indexes[i + j]].native();
+                        auto& sqe = next_sqe(unsigned(j));
+                        sqe = {};
+                        sqe.opcode = IORING_OP_STATX;
+                        sqe.fd = AT_FDCWD;
+                        sqe.addr = uint64_t(uintptr_t(paths_[j].c_str()));
+                        sqe.len = STATX_TYPE | STATX_MODE;
+                        sqe.off = uint64_t(uintptr_t(&buffers_[j]));
+                        sqe.statx_flags = uint32_t(flags);
+                        sqe.user_data = j;
+                    }
+                    if (!submit_and_wait(unsigned(count)))
+                    {
+                        // The ring's state is unknown, don't use it again.
+                        has_failed_ = true;
+                        return false;
+                    }
+                    for (size_t j = 0; j < count; ++j)
+                    {
+                        auto index = indexes[i + j];
+                        buffers[index] = buffers_[j];
+                        results[index] = results_[j];
+                    }
+                }
+                return true;
+            }
+        private:
+            IoUring()
+            {
+                io_uring_params params = {};
+                fd_ = int(syscall(__NR_io_uring_setup, SIZE, &params));
+                if (fd_ < 0)
+                    return;
+
+                sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                if (params.features & IORING_FEAT_SINGLE_MMAP)
+                    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+
+                sq_ring_ = map(sq_ring_size_, IORING_OFF_SQ_RING);
+                if (!sq_ring_)
+                    return;
+                if (params.features & IORING_FEAT_SINGLE_MMAP)
+                    cq_ring_ = sq_ring_;
+                else
+                    cq_ring_ = map(cq_ring_size_, IORING_OFF_CQ_RING);
+                if (!cq_ring_)
+                    return;
+
+                sq_tail_ = at<unsigned>(sq_ring_, params.sq_off.tail);
+                sq_mask_ = *at<unsigned>(sq_ring_, params.sq_off.ring_mask);
+                sq_array_ = at<unsigned>(sq_ring_, params.sq_off.array);
+                cq_head_ = at<unsigned>(cq_ring_, params.cq_off.head);
+                cq_tail_ = at<unsigned>(cq_ring_, params.cq_off.tail);
+                cq_mask_ = *at<unsigned>(cq_ring_, params.cq_off.ring_mask);
+                cqes_ = at<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+
+                if (!supports_statx())
+                    return;
+
+                sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+                auto sqes = map(sqes_size_, IORING_OFF_SQES);
+                sqes_ = static_cast<io_uring_sqe*>(sqes);
+            }
+
+            [[nodiscard]]
+            void* map(size_t size, off_t offset) const
+            {
+                auto ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                                MAP_SHARED | MAP_POPULATE, fd_, offset);
+                return ptr == MAP_FAILED ? nullptr : ptr;
+            }
+
+            template <typename T>
+            static T* at(void* ring, uint32_t offset)
+            {
+                return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+            }
+
+            /**
+             * @brief Returns true if the kernel is recent enough to
+             *      support IORING_OP_STATX.
+             */
+            [[nodiscard]]
+            bool supports_statx() const
+            {
+                constexpr unsigned OP_COUNT = 256;
+                std::vector<char> buffer(sizeof(io_uring_probe)
+                                         + OP_COUNT * sizeof(io_uring_probe_op));
+                auto probe = reinterpret_cast<io_uring_probe*>(buffer.data());
+                if (syscall(__NR_io_uring_register, fd_, IORING_REGISTER_PROBE,
+                            probe, OP_COUNT) < 0)
+                {
+                    return false;
+                }
+                return IORING_OP_STATX <= probe->last_op
+                       && (probe->ops[IORING_OP_STATX].flags & IO_URING_OP_SUPPORTED);
+            }
+
+            io_uring_sqe& next_sqe(unsigned offset)
+            {
+                // Only this thread submits, so the tail can be read
+                // without synchronization.
+                auto index = (*sq_tail_ + offset) & sq_mask_;
+                sq_array_[index] = index;
+                return sqes_[index];
+            }
+
+            bool submit_and_wait(unsigned count)
+            {
+                std::atomic_ref(*sq_tail_).store(*sq_tail_ + count,
+                                                 std::memory_order_release);
+                unsigned submitted = 0;
+                unsigned completed = 0;
+                while (completed < count)
+                {
+                    auto rc = syscall(__NR_io_uring_enter, fd_, count - submitted,
+                                      count - completed, IORING_ENTER_GETEVENTS,
+                                      nullptr, 0);
+                    if (rc < 0)
+                    {
+                        if (errno == EINTR)
+                            continue;
+                        drain(submitted, completed);
+                        return false;
+                    }
+                    submitted += unsigned(rc);
+                    completed += reap();
+                }
+                return true;
+            }
+
+            /**
+             * @brief Waits for the requests the kernel has accepted to
+             *      complete.
+             *
+             * If that fails too, the requests may still write to
+             * buffers_ until the ring is closed, which is why the ring
+             * owns them.
+             */
+            void drain(unsigned submitted, unsigned completed)
+            {
+                completed += reap();
+                while (completed < submitted)
+                {
+                    auto rc = syscall(__NR_io_uring_enter, fd_, 0,
+                                      submitted - completed,
+                                      IORING_ENTER_GETEVENTS, nullptr, 0);
+                    if (rc < 0 && errno != EINTR)
+                        return;
+                    completed += reap();
+                }
+            }
+
+            /**
+             * @brief Moves the results of the completed requests to
+             *      results_ and returns their number.
+             */
+            unsigned reap()
+            {
+                unsigned count = 0;
+                auto head = *cq_head_;
+                auto tail = std::atomic_ref(*cq_tail_).load(std::memory_order_acquire);
+                for (; head != tail; ++head, ++count)
+                {
+                    const auto& cqe = cqes_[head & cq_mask_];
+                    results_[cqe.user_data] = cqe.res;
+                }
+                std::atomic_ref(*cq_head_).store(head, std::memory_order_release);
+                return count;
+            }
+
+            int fd_ = -1;
+            void* sq_ring_ = nullptr;
+            void* cq_ring_ = nullptr;
+            size_t sq_ring_size_ = 0;
+            size_t cq_ring_size_ = 0;
+            io_uring_sqe* sqes_ = nullptr;
+            size_t sqes_size_ = 0;
+            unsigned* sq_tail_ = nullptr;
+            unsigned sq_mask_ = 0;
+            unsigned* sq_array_ = nullptr;
+            unsigned* cq_head_ = nullptr;
+            unsigned* cq_tail_ = nullptr;
+            unsigned cq_mask_ = 0;
+            io_uring_cqe* cqes_ = nullptr;
+            std::array<std::string, SIZE> paths_;
+            std::array<struct statx, SIZE> buffers_ = {};
+            std::array<int, SIZE> results_ = {};
+            bool has_failed_ = false;
+        };
+
+        bool get_file_statuses(IoUring& ring,
+                               const std::vector<std::filesystem::path>& paths,
+                               std::vector<FileSystem::Status>& statuses)
+        {
+            std::vector<struct statx> buffers(paths.size());
+            std::vector<int> results(paths.size());
+            std::vector<size_t> indexes(paths.size());
+            for (size_t i = 0; i < paths.size(); ++i)
+                indexes[i] = i;
+
+            if (!ring.statx(paths, indexes, AT_SYMLINK_NOFOLLOW, buffers, results))
+                return false;
+
+            // The symbolic links are followed in a second batch.
+            indexes.clear();
+            for (size_t i = 0; i < paths.size(); ++i)
+            {
+                statuses[i].type = to_file_type(results[i], buffers[i]);
+                if (statuses[i].type == std::filesystem::file_type::symlink)
+                {
+                    statuses[i].is_symlink = true;
+                    indexes.push_back(i);
+                }
+            }
+            if (indexes.empty())
+                return true;
+
+            if (!ring.statx(paths, indexes, 0, buffers, results))
+                return false;
+            for (auto i : indexes)
+                statuses[i].type = to_file_type(results[i], buffers[i]);
+            return true;
+        }
+#endif
+    }
+
+    std::filesystem::file_type
+    get_file_type(const std::filesystem::directory_entry& entry)
+    {
+        // Unlike status(), which always calls stat, the is_* functions
+        // use the type readdir returned when there is one.
+        std::error_code ec;
+        if (!entry.is_symlink(ec))
+        {
+            if (entry.is_regular_file(ec))
+                return std::filesystem::file_type::regular;
+            if (entry.is_directory(ec))
+                return std::filesystem::file_type::directory;
+        }
+        return entry.status(ec).type();
+    }
+
+    FileSystem::Status get_file_status(const std::filesystem::path& path)
+    {
+        FileSystem::Status result;
+        std::error_code ec;
+        result.type = std::filesystem::symlink_status(path, ec).type();
+        if (result.type == std::filesystem::file_type::symlink)
+        {
+            result.is_symlink = true;
+            result.type = std::filesystem::status(path, ec).type();
+        }
+        return result;
+    }
+
+    void get_file_statuses(const std::vector<std::filesystem::path>& paths,
+                           std::vector<FileSystem::Status>& statuses)
+    {
+        statuses.assign(paths.size(), {});
+#ifdef YGLOB_USE_IO_URING
+        if (auto ring = IoUring::get())
+        {
+            if (get_file_statuses(*ring, paths, statuses))
+                return;
+            statuses.assign(paths.size(), {});
+        }
+#endif
+        for (size_t i = 0; i < paths.size(); ++i)
+            statuses[i] = get_file_status(paths[i]);
+    }
+
+    bool is_io_uring_available()
+    {
+#ifdef YGLOB_USE_IO_URING
+        return IoUring::get() != nullptr;
+#else
+        return false;
+#endif
+    }
+}
@@ -0,0 +1,52 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <vector>
+#include "Yglob/FileSystem.hpp"
+
+namespace Yglob
+{
+    /**
+     * @brief Returns the type of @a entry after following symbolic
+     *      links.
+     *
+     * Uses the type that was read with the directory where possible, so
+     * only symbolic links and entries of unknown type need a stat call.
+     */
+    [[nodiscard]]
+    std::filesystem::file_type
+    get_file_type(const std::filesystem::directory_entry& entry);
+
+    /**
+     * @brief Returns the status of the file at @a path.
+     */
+    [[nodiscard]]
+    FileSystem::Status get_file_status(const std::filesystem::path& path);
+
+    /**
+     * @brief Replaces @a statuses with the statuses of the files at
+     *      @a paths.
+     *
+     * On Linux the statx calls for all the paths are submitted to the
+     * kernel in one batch through io_uring, which turns a round-trip per
+     * path into one for the batch on network file systems. Where
+     * io_uring isn't available, or has been disabled, the files are
+     * examined one at a time.
+     */
+    void get_file_statuses(const std::vector<std::filesystem::path>& paths,
+                           std::vector<FileSystem::Status>& statuses);
+
+    /**
+     * @brief Returns true if get_file_statuses() uses io_uring.
+     *
+     * The first call determines whether the kernel supports it.
+     */
+    [[nodiscard]]
+    bool is_io_uring_available();
+}
@@ -0,0 +1,27 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yglob/FileSystem.hpp"
+
+namespace Yglob
+{
+    FileSystem::~FileSystem() = default;
+
+    void FileSystem::get_statuses(const std::vector<std::filesystem::path>& paths,
+                                  std::vector<Status>& statuses)
+    {
+        statuses.clear();
+        statuses.reserve(paths.size());
+        for (const auto& path : paths)
+            statuses.push_back(status(path));
+    }
+
+    bool FileSystem::exists(const std::filesystem::path& path)
+    {
+        return status(path).exists();
+    }
+}
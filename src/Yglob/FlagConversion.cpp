@@ -0,0 +1,51 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "FlagConversion.hpp"
+
+namespace Yglob
+{
+    namespace
+    {
+        GlobFlags to_common_glob_flags(PathIteratorFlags flags)
+        {
+            GlobFlags result = {};
+            if (bool(flags & PathIteratorFlags::NO_BRACES))
+                result |= GlobFlags::NO_BRACES;
+            if (bool(flags & PathIteratorFlags::NO_SETS))
+                result |= GlobFlags::NO_SETS;
+            if (bool(flags & PathIteratorFlags::EXT_GLOBS))
+                result |= GlobFlags::EXT_GLOBS;
+            return result;
+        }
+    }
+
+    GlobFlags to_glob_flags(PathIteratorFlags flags)
+    {
+        GlobFlags result = to_common_glob_flags(flags);
+        if (bool(flags & PathIteratorFlags::CASE_SENSITIVE_GLOBS))
+            result |= GlobFlags::CASE_SENSITIVE;
+        return result;
+    }
+
+    GlobFlags to_literal_flags(PathIteratorFlags flags)
+    {
+        GlobFlags result = to_common_glob_flags(flags);
+        if (!bool(flags & PathIteratorFlags::CASE_INSENSITIVE_PATHS))
+            result |= GlobFlags::CASE_SENSITIVE;
+        return result;
+    }
+
+    std::filesystem::directory_options
+    to_directory_options(PathIteratorFlags flags)
+    {
+        std::filesystem::directory_options result = {};
+        if (!bool(flags & PathIteratorFlags::THROW_IF_ACCESS_DENIED))
+            result |= std::filesystem::directory_options::skip_permission_denied;
+        return result;
+    }
+}
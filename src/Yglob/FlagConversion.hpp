@@ -0,0 +1,33 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include "Yglob/Flags.hpp"
+
+namespace Yglob
+{
+    /**
+     * @brief Returns the flags for the glob patterns in a glob path.
+     */
+    [[nodiscard]]
+    GlobFlags to_glob_flags(PathIteratorFlags flags);
+
+    /**
+     * @brief Returns the flags for the names in a glob path that aren't
+     *      glob patterns.
+     *
+     * These are compared case-sensitively unless CASE_INSENSITIVE_PATHS
+     * is set.
+     */
+    [[nodiscard]]
+    GlobFlags to_literal_flags(PathIteratorFlags flags);
+
+    [[nodiscard]]
+    std::filesystem::directory_options
+    to_directory_options(PathIteratorFlags flags);
+}
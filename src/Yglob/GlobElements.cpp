@@ -8,6 +8,7 @@
 #include "GlobElements.hpp"
 
 #include <ostream>
+#include "MemoryUsage.hpp"
 
 namespace Yglob
 {
@@ -42,6 +43,21 @@ namespace Yglob
         return os;
     }
 
+    std::ostream& operator<<(std::ostream& os, const ExtGlob& ext_glob)
+    {
+        constexpr char PREFIXES[] = {'@', '?', '*', '+', '!'};
+        os << PREFIXES[int(ext_glob.kind)] << '(';
+        const auto& patterns = ext_glob.alternatives.patterns;
+        for (size_t i = 0; i < patterns.size(); ++i)
+        {
+            if (i)
+                os << '|';
+            os << *patterns[i];
+        }
+        os << ')';
+        return os;
+    }
+
     std::ostream& operator<<(std::ostream& os, const GlobElement& part)
     {
         std::visit([&os](const auto& p) {os << p;}, part);
@@ -54,4 +70,60 @@ namespace Yglob
             os << part;
         return os;
     }
+
+    // NOLINTBEGIN(misc-no-recursion)
+
+    void compact(GlobElements& pattern)
+    {
+        pattern.parts.shrink_to_fit();
+        for (auto& part : pattern.parts)
+        {
+            if (auto* str = std::get_if<std::pmr::string>(&part))
+            {
+                str->shrink_to_fit();
+            }
+            else if (auto* multi = std::get_if<MultiGlob>(&part))
+            {
+                multi->patterns.shrink_to_fit();
+                for (auto& p : multi->patterns)
+                    compact(*p);
+            }
+            else if (auto* ext = std::get_if<ExtGlob>(&part))
+            {
+                ext->alternatives.patterns.shrink_to_fit();
+                for (auto& p : ext->alternatives.patterns)
+                    compact(*p);
+            }
+        }
+    }
+
+    namespace
+    {
+        size_t get_memory_usage(const MultiGlob& multi)
+        {
+            auto result = get_heap_usage(multi.patterns);
+            for (const auto& p : multi.patterns)
+                result += get_memory_usage(*p);
+            return result;
+        }
+    }
+
+    size_t get_memory_usage(const GlobElements& pattern)
+    {
+        auto result = sizeof(GlobElements) + get_heap_usage(pattern.parts);
+        for (const auto& part : pattern.parts)
+        {
+            if (const auto* str = std::get_if<std::pmr::string>(&part))
+                result += get_heap_usage(*str);
+            else if (const auto* multi = std::get_if<MultiGlob>(&part))
+                result += get_memory_usage(*multi);
+            else if (const auto* ext = std::get_if<ExtGlob>(&part))
+                result += get_memory_usage(ext->alternatives);
+            else if (const auto* set = std::get_if<ystring::CodepointSet>(&part))
+                result += get_heap_usage(set->ranges);
+        }
+        return result;
+    }
+
+    // NOLINTEND(misc-no-recursion)
 }
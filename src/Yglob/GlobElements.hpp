@@ -8,6 +8,7 @@
 #pragma once
 #include <iosfwd>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <string_view>
 #include <variant>
@@ -74,22 +75,72 @@ namespace Yglob
 
     std::ostream& operator<<(std::ostream& os, const MultiGlob& multi_pattern);
 
+    enum class ExtGlobKind
+    {
+        /** @brief `@(...)`, exactly one of the alternatives. */
+        ONE,
+        /** @brief `?(...)`, zero or one of the alternatives. */
+        ZERO_OR_ONE,
+        /** @brief `*(...)`, zero or more of the alternatives. */
+        ZERO_OR_MORE,
+        /** @brief `+(...)`, one or more of the alternatives. */
+        ONE_OR_MORE,
+        /** @brief `!(...)`, anything except the alternatives. */
+        NONE_OF
+    };
+
+    struct ExtGlob
+    {
+        ExtGlobKind kind = ExtGlobKind::ONE;
+        MultiGlob alternatives;
+    };
+
+    std::ostream& operator<<(std::ostream& os, const ExtGlob& ext_glob);
+
     using GlobElement = std::variant<
         EmptyElement,
         StarElement,
         QmarkElement,
         ystring::CodepointSet,
-        std::string,
-        MultiGlob
+        std::pmr::string,
+        MultiGlob,
+        ExtGlob
         >;
 
     std::ostream& operator<<(std::ostream& os, const GlobElement& part);
 
+    /**
+     * @brief A parsed glob pattern.
+     *
+     * The parts and the strings in them are allocated from the memory
+     * resource the pattern was parsed with. The lists of alternatives in
+     * braces and extended globs, and the sets' ranges, are always on the
+     * global heap.
+     */
     struct GlobElements
     {
-        std::vector<GlobElement> parts;
+        GlobElements() = default;
+
+        explicit GlobElements(std::pmr::memory_resource* resource)
+            : parts(resource)
+        {}
+
+        std::pmr::vector<GlobElement> parts;
         size_t tail_length = 0;
     };
 
     std::ostream& operator<<(std::ostream& os, const GlobElements& pattern);
+
+    /**
+     * @brief Releases the unused capacity in @a pattern's strings and
+     *      vectors.
+     */
+    void compact(GlobElements& pattern);
+
+    /**
+     * @brief Returns the approximate number of bytes used by @a pattern,
+     *      including the GlobElements object itself.
+     */
+    [[nodiscard]]
+    size_t get_memory_usage(const GlobElements& pattern);
 }
@@ -7,61 +7,132 @@
 //****************************************************************************
 #include "Yglob/GlobMatcher.hpp"
 
+#include <tuple>
 #include <Ystring/Unescape.hpp>
+#include "ExtGlobAutomaton.hpp"
+#include "GlobSubset.hpp"
+#include "InternPool.hpp"
 #include "MatchGlobPattern.hpp"
 #include "ParseGlobPattern.hpp"
 
 namespace Yglob
 {
-    GlobMatcher::GlobMatcher() = default;
-
-    GlobMatcher::GlobMatcher(std::string_view pattern,
-                             GlobFlags flags)
-        : case_sensitive(bool(flags & GlobFlags::CASE_SENSITIVE)),
-          pattern_(parse_glob_pattern(pattern,
-                                      {!bool(flags & GlobFlags::NO_BRACES),
-                                       !bool(flags & GlobFlags::NO_SETS)}))
+    namespace
+    {
+        /**
+         * @brief A parsed pattern, and the automaton for patterns with
+         *      extended globs.
+         */
+        struct CompiledGlob
+        {
+            CompiledGlob(std::string_view pattern, GlobFlags flags,
+                         std::pmr::memory_resource* resource)
+                : pattern(resource)
+            {
+                parse_glob_pattern(pattern,
+                                   {!bool(flags & GlobFlags::NO_BRACES),
+                                    !bool(flags & GlobFlags::NO_SETS),
+                                    false,
+                                    bool(flags & GlobFlags::EXT_GLOBS)},
+                                   this->pattern);
+                if (has_ext_glob(this->pattern))
+                {
+                    ext_glob_automaton = std::make_unique<ExtGlobAutomaton>(
+                        this->pattern, bool(flags & GlobFlags::CASE_SENSITIVE),
+                        resource);
+                }
+            }
 
-    {}
+            GlobElements pattern;
+            std::unique_ptr<const ExtGlobAutomaton> ext_glob_automaton;
+        };
 
-    GlobMatcher::GlobMatcher(const GlobMatcher& rhs)
-        : case_sensitive(rhs.case_sensitive),
-          pattern_(rhs.pattern_ ? std::make_unique<GlobElements>(*rhs.pattern_)
-                                : nullptr)
-    {}
+        std::shared_ptr<const CompiledGlob>
+        compile_glob(std::string_view pattern, GlobFlags flags)
+        {
+            static InternPool<CompiledGlob> pool;
 
-    GlobMatcher::GlobMatcher(GlobMatcher&& rhs) noexcept
-        : case_sensitive(rhs.case_sensitive),
-          pattern_(std::move(rhs.pattern_))
-    {}
+            std::string key(1, char(flags));
+            key += pattern;
+            return pool.get(key, [&]
+            {
+                // The pool outlives any default resource set by the
+                // program.
+                auto result = std::make_shared<CompiledGlob>(
+                    pattern, flags, std::pmr::new_delete_resource());
+                compact(result->pattern);
+                return result;
+            });
+        }
 
-    GlobMatcher::~GlobMatcher() = default;
+        std::shared_ptr<const CompiledGlob>
+        compile_glob(std::string_view pattern, GlobFlags flags,
+                     std::pmr::memory_resource* resource)
+        {
+            // Patterns on a caller's memory resource can't be shared
+            // with matchers that may outlive it. Compacting them would
+            // only allocate more from the resource.
+            return std::allocate_shared<CompiledGlob>(
+                std::pmr::polymorphic_allocator<CompiledGlob>(resource),
+                pattern, flags, resource);
+        }
 
-    GlobMatcher& GlobMatcher::operator=(const GlobMatcher& rhs)
-    {
-        if (this != &rhs)
+        /**
+         * @brief Returns pointers to the parts of @a compiled that share
+         *      its ownership.
+         */
+        std::pair<std::shared_ptr<const GlobElements>,
+                  std::shared_ptr<const ExtGlobAutomaton>>
+        split(const std::shared_ptr<const CompiledGlob>& compiled)
         {
-            pattern_ = rhs.pattern_
-                       ? std::make_unique<GlobElements>(*rhs.pattern_)
-                       : nullptr;
-            case_sensitive = rhs.case_sensitive;
+            std::shared_ptr<const ExtGlobAutomaton> automaton;
+            if (compiled->ext_glob_automaton)
+            {
+                automaton = std::shared_ptr<const ExtGlobAutomaton>(
+                    compiled, compiled->ext_glob_automaton.get());
+            }
+            return {std::shared_ptr<const GlobElements>(compiled, &compiled->pattern),
+                    std::move(automaton)};
         }
-        return *this;
     }
 
-    GlobMatcher& GlobMatcher::operator=(GlobMatcher&& rhs) noexcept
+    GlobMatcher::GlobMatcher() = default;
+
+    GlobMatcher::GlobMatcher(std::string_view pattern,
+                             GlobFlags flags)
+        : case_sensitive(bool(flags & GlobFlags::CASE_SENSITIVE))
+    {
+        std::tie(pattern_, ext_glob_automaton_) = split(compile_glob(pattern, flags));
+    }
+
+    GlobMatcher::GlobMatcher(std::string_view pattern,
+                             GlobFlags flags,
+                             std::pmr::memory_resource* resource)
+        : case_sensitive(bool(flags & GlobFlags::CASE_SENSITIVE))
     {
-        pattern_ = std::move(rhs.pattern_);
-        case_sensitive = rhs.case_sensitive;
-        return *this;
+        std::tie(pattern_, ext_glob_automaton_)
+            = split(compile_glob(pattern, flags, resource));
     }
 
+    GlobMatcher::GlobMatcher(const GlobMatcher& rhs) = default;
+
+    GlobMatcher::GlobMatcher(GlobMatcher&& rhs) noexcept = default;
+
+    GlobMatcher::~GlobMatcher() = default;
+
+    GlobMatcher& GlobMatcher::operator=(const GlobMatcher& rhs) = default;
+
+    GlobMatcher& GlobMatcher::operator=(GlobMatcher&& rhs) noexcept = default;
+
     [[nodiscard]]
     bool GlobMatcher::match(std::string_view str) const
     {
         if (!pattern_)
             return str.empty();
 
+        if (ext_glob_automaton_)
+            return ext_glob_automaton_->match(str);
+
         auto length = pattern_->parts.size() - pattern_->tail_length;
         std::span parts(pattern_->parts.data(), length);
         std::span tail(pattern_->parts.data() + length, pattern_->tail_length);
@@ -69,6 +140,16 @@ namespace Yglob
                && match_fwd(parts, str, case_sensitive, false);
     }
 
+    size_t GlobMatcher::memory_usage() const
+    {
+        auto result = sizeof(GlobMatcher);
+        if (pattern_)
+            result += get_memory_usage(*pattern_);
+        if (ext_glob_automaton_)
+            result += ext_glob_automaton_->memory_usage();
+        return result;
+    }
+
     std::ostream& operator<<(std::ostream& os, const GlobMatcher& matcher)
     {
         if (matcher.pattern_)
@@ -76,12 +157,23 @@ namespace Yglob
         return os;
     }
 
+    bool is_subset(const GlobMatcher& a, const GlobMatcher& b)
+    {
+        static const GlobElements empty_pattern;
+        return is_subset(a.pattern_ ? *a.pattern_ : empty_pattern,
+                         a.case_sensitive,
+                         b.pattern_ ? *b.pattern_ : empty_pattern,
+                         b.case_sensitive);
+    }
+
     bool is_glob_pattern(std::string_view str, GlobFlags flags)
     {
         GlobParserOptions parser_opts
         {
             !bool(flags & GlobFlags::NO_BRACES),
-            !bool(flags & GlobFlags::NO_SETS)
+            !bool(flags & GlobFlags::NO_SETS),
+            false,
+            bool(flags & GlobFlags::EXT_GLOBS)
         };
 
         while (!str.empty())
@@ -92,6 +184,7 @@ namespace Yglob
             case TokenType::QUESTION_MARK:
             case TokenType::OPEN_BRACE:
             case TokenType::OPEN_BRACKET:
+            case TokenType::OPEN_EXT_GLOB:
                 return true;
             default:
                 break;
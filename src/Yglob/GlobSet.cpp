@@ -0,0 +1,62 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "GlobSet.hpp"
+
+namespace Yglob
+{
+    namespace
+    {
+        /**
+         * @brief Returns the extension in patterns of the form `*.ext`,
+         *      or an empty string.
+         */
+        std::string_view get_plain_extension(std::string_view pattern)
+        {
+            if (pattern.size() < 3 || pattern[0] != '*' || pattern[1] != '.')
+                return {};
+            auto ext = pattern.substr(2);
+            if (ext.find_first_of("*?[]{},.()\\") != std::string_view::npos)
+                return {};
+            return ext;
+        }
+
+        std::string make_key(std::string_view pattern, GlobFlags flags)
+        {
+            std::string key(pattern);
+            key.push_back(char('0' + int(flags)));
+            return key;
+        }
+    }
+
+    size_t GlobSet::add(std::string_view pattern, GlobFlags flags)
+    {
+        auto [it, inserted] = index_.emplace(make_key(pattern, flags),
+                                             index_.size());
+        if (!inserted)
+            return it->second;
+
+        const auto index = it->second;
+        const auto case_sensitive = bool(flags & GlobFlags::CASE_SENSITIVE);
+        if (auto ext = get_plain_extension(pattern); !ext.empty())
+        {
+            if (case_sensitive)
+            {
+                extensions_[std::string(ext)].push_back(index);
+                return index;
+            }
+            if (is_ascii(ext))
+            {
+                folded_extensions_[fold_ascii(ext)].push_back(index);
+                return index;
+            }
+        }
+
+        matchers_.emplace_back(index, GlobMatcher(pattern, flags));
+        return index;
+    }
+}
@@ -0,0 +1,101 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Yglob/GlobMatcher.hpp"
+#include "PathComponents.hpp"
+
+namespace Yglob
+{
+    /**
+     * @brief A collection of glob patterns that are matched against
+     *      a name at once.
+     *
+     * Patterns of the form `*.ext` are looked up in a hash map with the
+     * name's extension, the others are matched one by one. Identical
+     * patterns are only stored once.
+     */
+    class GlobSet
+    {
+    public:
+        /**
+         * @brief Adds @a pattern to the set, unless it is already there,
+         *      and returns its index.
+         */
+        size_t add(std::string_view pattern, GlobFlags flags);
+
+        /**
+         * @brief Calls @a func with the index of each pattern that
+         *      matches @a name.
+         */
+        template <typename Func>
+        void match(std::string_view name, Func func) const
+        {
+            if (!extensions_.empty() || !folded_extensions_.empty())
+                match_extension(name, func);
+
+            for (const auto& [index, matcher] : matchers_)
+            {
+                if (matcher.match(name))
+                    func(index);
+            }
+        }
+
+        [[nodiscard]]
+        size_t size() const
+        {
+            return index_.size();
+        }
+
+        [[nodiscard]]
+        bool empty() const
+        {
+            return index_.empty();
+        }
+    private:
+        template <typename Func>
+        void match_extension(std::string_view name, Func& func) const
+        {
+            const auto pos = name.rfind('.');
+            if (pos == std::string_view::npos || pos + 1 == name.size())
+                return;
+
+            auto ext = name.substr(pos + 1);
+            if (auto it = extensions_.find(ext); it != extensions_.end())
+            {
+                for (auto index : it->second)
+                    func(index);
+            }
+
+            char buffer[64];
+            std::string long_ext;
+            auto folded_ext = fold_ascii(ext, buffer, sizeof(buffer));
+            if (folded_ext.size() != ext.size())
+            {
+                long_ext = fold_ascii(ext);
+                folded_ext = long_ext;
+            }
+            if (auto it = folded_extensions_.find(folded_ext);
+                it != folded_extensions_.end())
+            {
+                for (auto index : it->second)
+                    func(index);
+            }
+        }
+
+        using IndexMap = std::unordered_map<
+            std::string, std::vector<size_t>, StringHash, std::equal_to<>>;
+
+        std::unordered_map<std::string, size_t> index_;
+        IndexMap extensions_;
+        IndexMap folded_extensions_;
+        std::vector<std::pair<size_t, GlobMatcher>> matchers_;
+    };
+}
@@ -0,0 +1,284 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yglob/GlobSnapshot.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <Ystring/Algorithms.hpp>
+#include "Yglob/PathIterator.hpp"
+#include "Yglob/YglobException.hpp"
+#include "DirectoryCacheImpl.hpp"
+
+namespace Yglob
+{
+    namespace
+    {
+        constexpr char MAGIC[8] = {'Y', 'G', 'L', 'O', 'B', 'S', 'N', 'P'};
+        constexpr uint32_t VERSION = 1;
+
+        std::string to_string(const std::filesystem::path& path)
+        {
+            return std::string(ystring::to_string_view(path.generic_u8string()));
+        }
+
+        std::filesystem::path from_string(std::string_view str)
+        {
+            return {std::u8string_view(reinterpret_cast<const char8_t*>(str.data()),
+                                       str.size())};
+        }
+
+        /**
+         * @brief Writes integers in little-endian byte order and strings
+         *      prefixed by their length.
+         */
+        class SnapshotWriter
+        {
+        public:
+            explicit SnapshotWriter(std::ostream& stream)
+                : stream_(stream)
+            {}
+
+            void write(uint64_t value, size_t size = 8)
+            {
+                for (size_t i = 0; i < size; ++i)
+                    stream_.put(char((value >> (8 * i)) & 0xFFu));
+            }
+
+            void write(std::string_view str)
+            {
+                write(str.size());
+                stream_.write(str.data(), std::streamsize(str.size()));
+            }
+        private:
+            std::ostream& stream_;
+        };
+
+        class SnapshotReader
+        {
+        public:
+            explicit SnapshotReader(std::string_view data)
+                : data_(data)
+            {}
+
+            uint64_t read(size_t size = 8)
+            {
+                if (data_.size() < size)
+                    YGLOB_THROW("The GlobSnapshot is truncated.");
+                uint64_t value = 0;
+                for (size_t i = 0; i < size; ++i)
+                    value |= uint64_t(uint8_t(data_[i])) << (8 * i);
+                data_.remove_prefix(size);
+                return value;
+            }
+
+            std::string_view read_string()
+            {
+                auto size = read();
+                if (data_.size() < size)
+                    YGLOB_THROW("The GlobSnapshot is truncated.");
+                auto result = data_.substr(0, size);
+                data_.remove_prefix(size);
+                return result;
+            }
+
+            /**
+             * @brief Reads the number of items in a sequence where each
+             *      item is at least @a min_item_size bytes.
+             */
+            size_t read_count(size_t min_item_size)
+            {
+                auto count = read();
+                if (count > data_.size() / min_item_size)
+                    YGLOB_THROW("The GlobSnapshot is truncated.");
+                return size_t(count);
+            }
+        private:
+            std::string_view data_;
+        };
+    }
+
+    class GlobSnapshot::GlobSnapshotImpl
+    {
+    public:
+        using StampedListing = DirectoryCache::DirectoryCacheImpl::StampedListing;
+
+        std::vector<std::filesystem::path> glob_paths;
+        std::vector<std::string> exclude_patterns;
+        PathIteratorFlags flags = PathIteratorFlags::DEFAULT;
+        std::vector<std::filesystem::path> paths;
+        std::vector<StampedListing> listings;
+
+        void save(std::ostream& stream) const
+        {
+            stream.write(MAGIC, sizeof(MAGIC));
+            SnapshotWriter writer(stream);
+            writer.write(VERSION, 4);
+            writer.write(glob_paths.size());
+            for (const auto& glob_path : glob_paths)
+                writer.write(to_string(glob_path));
+            writer.write(exclude_patterns.size());
+            for (const auto& pattern : exclude_patterns)
+                writer.write(pattern);
+            writer.write(unsigned(flags), 4);
+            writer.write(paths.size());
+            for (const auto& path : paths)
+                writer.write(to_string(path));
+
+            writer.write(listings.size());
+            for (const auto& listing : listings)
+            {
+                writer.write(to_string(listing.directory));
+                writer.write(listing.stamp.size);
+                writer.write(uint64_t(listing.stamp.modified));
+                writer.write(uint64_t(listing.stamp.changed));
+                writer.write(listing.stamp.device);
+                writer.write(listing.stamp.inode);
+                writer.write(unsigned(listing.options), 4);
+                writer.write(listing.listing->size());
+                for (const auto& entry : *listing.listing)
+                {
+                    writer.write(entry.name);
+                    writer.write(encode_file_type(entry.type), 1);
+                    writer.write(entry.is_symlink ? 1 : 0, 1);
+                }
+            }
+        }
+
+        void load(std::string_view data)
+        {
+            if (data.size() < sizeof(MAGIC)
+                || std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0)
+            {
+                YGLOB_THROW("The file is not a GlobSnapshot.");
+            }
+
+            SnapshotReader reader(data.substr(sizeof(MAGIC)));
+            if (reader.read(4) != VERSION)
+                YGLOB_THROW("Unsupported GlobSnapshot version.");
+            for (auto n = reader.read_count(8); n-- > 0;)
+                glob_paths.push_back(from_string(reader.read_string()));
+            for (auto n = reader.read_count(8); n-- > 0;)
+                exclude_patterns.emplace_back(reader.read_string());
+            flags = PathIteratorFlags(reader.read(4));
+            for (auto n = reader.read_count(8); n-- > 0;)
+                paths.push_back(from_string(reader.read_string()));
+
+            for (auto n = reader.read_count(52); n-- > 0;)
+            {
+                StampedListing& listing = listings.emplace_back();
+                listing.directory = from_string(reader.read_string());
+                listing.stamp.type = std::filesystem::file_type::directory;
+                listing.stamp.size = reader.read();
+                listing.stamp.modified = int64_t(reader.read());
+                listing.stamp.changed = int64_t(reader.read());
+                listing.stamp.device = reader.read();
+                listing.stamp.inode = reader.read();
+                listing.options = std::filesystem::directory_options(reader.read(4));
+
+                auto entries = std::make_shared<DirectoryCache::Listing>();
+                for (auto m = reader.read_count(10); m-- > 0;)
+                {
+                    auto& entry = entries->emplace_back();
+                    entry.name = reader.read_string();
+                    entry.type = decode_file_type(uint8_t(reader.read(1)));
+                    entry.is_symlink = reader.read(1) != 0;
+                }
+                listing.listing = std::move(entries);
+            }
+        }
+    };
+
+    GlobSnapshot::GlobSnapshot()
+        : impl_(std::make_unique<GlobSnapshotImpl>())
+    {}
+
+    GlobSnapshot::GlobSnapshot(const std::vector<std::filesystem::path>& glob_paths,
+                               const std::vector<std::string>& exclude_patterns,
+                               PathIteratorFlags flags)
+        : GlobSnapshot(glob_paths, exclude_patterns, flags,
+                       std::make_shared<DirectoryCache>())
+    {}
+
+    GlobSnapshot::GlobSnapshot(const std::vector<std::filesystem::path>& glob_paths,
+                               const std::vector<std::string>& exclude_patterns,
+                               PathIteratorFlags flags,
+                               std::shared_ptr<DirectoryCache> cache)
+        : impl_(std::make_unique<GlobSnapshotImpl>())
+    {
+        impl_->glob_paths = glob_paths;
+        impl_->exclude_patterns = exclude_patterns;
+        impl_->flags = flags;
+
+        PathIterator it(glob_paths, exclude_patterns, flags, cache);
+        while (it.next())
+            impl_->paths.push_back(it.path());
+        std::ranges::sort(impl_->paths);
+        impl_->paths.erase(std::unique(impl_->paths.begin(), impl_->paths.end()),
+                           impl_->paths.end());
+
+        impl_->listings = cache->impl_->used_listings();
+    }
+
+    GlobSnapshot::GlobSnapshot(GlobSnapshot&& rhs) noexcept = default;
+
+    GlobSnapshot::~GlobSnapshot() = default;
+
+    GlobSnapshot& GlobSnapshot::operator=(GlobSnapshot&& rhs) noexcept = default;
+
+    GlobSnapshot GlobSnapshot::load(const std::filesystem::path& file_path)
+    {
+        std::ifstream stream(file_path, std::ios::binary);
+        if (!stream)
+            YGLOB_THROW("Unable to open the GlobSnapshot file.");
+        std::string data((std::istreambuf_iterator<char>(stream)),
+                         std::istreambuf_iterator<char>());
+
+        GlobSnapshot result;
+        result.impl_->load(data);
+        return result;
+    }
+
+    void GlobSnapshot::save(const std::filesystem::path& file_path) const
+    {
+        std::ofstream stream(file_path, std::ios::binary | std::ios::trunc);
+        if (!stream)
+            YGLOB_THROW("Unable to create the GlobSnapshot file.");
+        impl_->save(stream);
+        if (!stream.flush())
+            YGLOB_THROW("Unable to write the GlobSnapshot file.");
+    }
+
+    const std::vector<std::filesystem::path>& GlobSnapshot::glob_paths() const
+    {
+        return impl_->glob_paths;
+    }
+
+    const std::vector<std::string>& GlobSnapshot::exclude_patterns() const
+    {
+        return impl_->exclude_patterns;
+    }
+
+    PathIteratorFlags GlobSnapshot::flags() const
+    {
+        return impl_->flags;
+    }
+
+    const std::vector<std::filesystem::path>& GlobSnapshot::paths() const
+    {
+        return impl_->paths;
+    }
+
+    std::shared_ptr<DirectoryCache> GlobSnapshot::make_cache() const
+    {
+        auto cache = std::make_shared<DirectoryCache>();
+        for (const auto& listing : impl_->listings)
+            cache->impl_->add_listing(listing);
+        return cache;
+    }
+}
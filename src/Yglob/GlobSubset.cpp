@@ -0,0 +1,439 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "GlobSubset.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <optional>
+#include <set>
+#include <Ystring/Algorithms.hpp>
+
+namespace Yglob
+{
+    namespace
+    {
+        /**
+         * @brief The maximum number of state pairs that is_subset
+         *      explores before giving up.
+         */
+        constexpr size_t MAX_STATE_PAIRS = 100'000;
+
+        constexpr char32_t MAX_CODEPOINT = 0x10FFFF;
+
+        constexpr char32_t fold_ascii(char32_t ch)
+        {
+            return U'A' <= ch && ch <= U'Z' ? ch + (U'a' - U'A') : ch;
+        }
+
+        /**
+         * @brief Returns the alternative as a string if it doesn't
+         *      contain any wildcards.
+         */
+        std::optional<std::string> get_plain_string(const GlobElements& pattern)
+        {
+            std::string result;
+            for (const auto& part : pattern.parts)
+            {
+                if (const auto* str = std::get_if<std::pmr::string>(&part))
+                    result += *str;
+                else if (!std::holds_alternative<EmptyElement>(part))
+                    return {};
+            }
+            return result;
+        }
+
+        /**
+         * @brief Returns true if GlobMatcher matches exactly the strings
+         *      that the automaton matches for @a multi.
+         *
+         * GlobMatcher uses the first alternative that matches and doesn't
+         * backtrack to try the others. That only makes no difference if
+         * the alternatives are plain strings where none is the start or
+         * end of another.
+         */
+        bool is_unambiguous(const MultiGlob& multi, bool case_sensitive)
+        {
+            std::vector<std::string> strings;
+            for (const auto& pattern : multi.patterns)
+            {
+                auto str = get_plain_string(*pattern);
+                if (!str)
+                    return false;
+                strings.push_back(std::move(*str));
+            }
+
+            for (size_t i = 0; i < strings.size(); ++i)
+            {
+                for (size_t j = 0; j < strings.size(); ++j)
+                {
+                    if (i == j)
+                        continue;
+                    if (case_sensitive
+                            ? strings[i].starts_with(strings[j])
+                              || strings[i].ends_with(strings[j])
+                            : ystring::case_insensitive::starts_with(strings[i], strings[j])
+                              || ystring::case_insensitive::ends_with(strings[i], strings[j]))
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        struct Edge
+        {
+            enum class Kind
+            {
+                CHAR,
+                ANY,
+                SET
+            };
+
+            Kind kind = Kind::ANY;
+            char32_t ch = 0;
+            const ystring::CodepointSet* set = nullptr;
+            uint32_t target = 0;
+        };
+
+        struct State
+        {
+            std::vector<Edge> edges;
+            std::vector<uint32_t> empty_edges;
+        };
+
+        /**
+         * @brief A non-deterministic automaton where each transition
+         *      consumes a single codepoint.
+         */
+        class CharAutomaton
+        {
+        public:
+            CharAutomaton(const GlobElements& pattern, bool case_sensitive)
+                : case_sensitive_(case_sensitive)
+            {
+                auto start = add_state();
+                accept_ = add(pattern, start);
+            }
+
+            /**
+             * @brief Returns false if the automaton might match strings
+             *      that GlobMatcher doesn't match.
+             *
+             * This is the case for case-insensitive patterns with
+             * non-ASCII characters, for braces where GlobMatcher might
+             * pick the wrong alternative, and for negations.
+             */
+            [[nodiscard]]
+            bool is_exact() const
+            {
+                return (case_sensitive_ || !has_non_ascii_)
+                       && !has_ambiguous_braces_ && !has_negation_;
+            }
+
+            /**
+             * @brief Returns false if the automaton might not match all
+             *      the strings GlobMatcher matches.
+             */
+            [[nodiscard]]
+            bool is_complete() const
+            {
+                return case_sensitive_ || !has_non_ascii_;
+            }
+
+            /**
+             * @brief Appends the codepoints where the automaton's
+             *      transitions can change from matching to not matching.
+             */
+            void add_boundaries(std::vector<char32_t>& boundaries) const
+            {
+                for (const auto& state : states_)
+                {
+                    for (const auto& edge : state.edges)
+                    {
+                        if (edge.kind == Edge::Kind::CHAR && edge.ch >= 0x80)
+                        {
+                            boundaries.push_back(edge.ch);
+                            boundaries.push_back(edge.ch + 1);
+                        }
+                        else if (edge.kind == Edge::Kind::SET)
+                        {
+                            for (auto [first, last] : edge.set->ranges)
+                            {
+                                if (last < 0x80)
+                                    continue;
+                                boundaries.push_back(std::max(first, char32_t(0x80)));
+                                boundaries.push_back(last + 1);
+                            }
+                        }
+                    }
+                }
+            }
+
+            [[nodiscard]]
+            std::vector<uint32_t> start() const
+            {
+                std::vector<uint32_t> result;
+                add_with_closure(0, result);
+                return result;
+            }
+
+            void advance(const std::vector<uint32_t>& from, char32_t ch,
+                         std::vector<uint32_t>& to) const
+            {
+                to.clear();
+                for (auto index : from)
+                {
+                    for (const auto& edge : states_[index].edges)
+                    {
+                        if (match(edge, ch))
+                            add_with_closure(edge.target, to);
+                    }
+                }
+                std::ranges::sort(to);
+                to.erase(std::unique(to.begin(), to.end()), to.end());
+            }
+
+            [[nodiscard]]
+            bool is_match(const std::vector<uint32_t>& states) const
+            {
+                return std::ranges::binary_search(states, accept_);
+            }
+        private:
+            uint32_t add_state()
+            {
+                states_.emplace_back();
+                return uint32_t(states_.size() - 1);
+            }
+
+            void add_edge(uint32_t from, Edge edge)
+            {
+                states_[from].edges.push_back(edge);
+            }
+
+            // NOLINTBEGIN(misc-no-recursion)
+
+            uint32_t add(const GlobElements& pattern, uint32_t state)
+            {
+                for (const auto& part : pattern.parts)
+                    state = add(part, state);
+                return state;
+            }
+
+            uint32_t add(const GlobElement& part, uint32_t state)
+            {
+                if (const auto* str = std::get_if<std::pmr::string>(&part))
+                {
+                    std::string_view s = *str;
+                    while (auto ch = ystring::pop_utf8_codepoint(s))
+                    {
+                        if (*ch >= 0x80)
+                            has_non_ascii_ = true;
+                        auto next = add_state();
+                        add_edge(state, {Edge::Kind::CHAR, *ch, nullptr, next});
+                        state = next;
+                    }
+                }
+                else if (const auto* qmark = std::get_if<QmarkElement>(&part))
+                {
+                    for (size_t i = 0; i < qmark->length; ++i)
+                    {
+                        auto next = add_state();
+                        add_edge(state, {Edge::Kind::ANY, 0, nullptr, next});
+                        state = next;
+                    }
+                }
+                else if (std::holds_alternative<StarElement>(part))
+                {
+                    auto next = add_state();
+                    states_[state].empty_edges.push_back(next);
+                    add_edge(next, {Edge::Kind::ANY, 0, nullptr, next});
+                    state = next;
+                }
+                else if (const auto* set = std::get_if<ystring::CodepointSet>(&part))
+                {
+                    if (!set->ranges.empty() && set->ranges.back().second >= 0x80)
+                        has_non_ascii_ = true;
+                    auto next = add_state();
+                    add_edge(state, {Edge::Kind::SET, 0, set, next});
+                    state = next;
+                }
+                else if (const auto* multi = std::get_if<MultiGlob>(&part))
+                {
+                    if (!is_unambiguous(*multi, case_sensitive_))
+                        has_ambiguous_braces_ = true;
+                    state = add_alternatives(*multi, state);
+                }
+                else if (const auto* ext = std::get_if<ExtGlob>(&part))
+                {
+                    state = add(*ext, state);
+                }
+                return state;
+            }
+
+            uint32_t add(const ExtGlob& ext, uint32_t state)
+            {
+                switch (ext.kind)
+                {
+                case ExtGlobKind::ONE:
+                    return add_alternatives(ext.alternatives, state);
+                case ExtGlobKind::ZERO_OR_ONE:
+                {
+                    auto end = add_alternatives(ext.alternatives, state);
+                    states_[state].empty_edges.push_back(end);
+                    return end;
+                }
+                case ExtGlobKind::ZERO_OR_MORE:
+                case ExtGlobKind::ONE_OR_MORE:
+                {
+                    auto loop = add_state();
+                    states_[state].empty_edges.push_back(loop);
+                    auto end = add_alternatives(ext.alternatives, loop);
+                    states_[end].empty_edges.push_back(loop);
+                    if (ext.kind == ExtGlobKind::ZERO_OR_MORE)
+                        states_[loop].empty_edges.push_back(end);
+                    return end;
+                }
+                default:
+                {
+                    // Negations are treated as `*`, which makes the
+                    // automaton match too much.
+                    has_negation_ = true;
+                    auto next = add_state();
+                    states_[state].empty_edges.push_back(next);
+                    add_edge(next, {Edge::Kind::ANY, 0, nullptr, next});
+                    return next;
+                }
+                }
+            }
+
+            uint32_t add_alternatives(const MultiGlob& alternatives,
+                                      uint32_t state)
+            {
+                auto next = add_state();
+                for (const auto& pattern : alternatives.patterns)
+                {
+                    auto end = add(*pattern, state);
+                    states_[end].empty_edges.push_back(next);
+                }
+                return next;
+            }
+
+            void add_with_closure(uint32_t state, std::vector<uint32_t>& states) const
+            {
+                if (std::ranges::find(states, state) != states.end())
+                    return;
+                states.push_back(state);
+                for (auto next : states_[state].empty_edges)
+                    add_with_closure(next, states);
+            }
+
+            // NOLINTEND(misc-no-recursion)
+
+            [[nodiscard]]
+            bool match(const Edge& edge, char32_t ch) const
+            {
+                switch (edge.kind)
+                {
+                case Edge::Kind::CHAR:
+                    return case_sensitive_ ? ch == edge.ch
+                                           : fold_ascii(ch) == fold_ascii(edge.ch);
+                case Edge::Kind::SET:
+                    return case_sensitive_ ? edge.set->contains(ch)
+                                           : edge.set->case_insensitive_contains(ch);
+                default:
+                    return true;
+                }
+            }
+
+            std::vector<State> states_;
+            uint32_t accept_ = 0;
+            bool case_sensitive_;
+            bool has_non_ascii_ = false;
+            bool has_ambiguous_braces_ = false;
+            bool has_negation_ = false;
+        };
+
+        /**
+         * @brief Returns one codepoint from each of the ranges of
+         *      codepoints that the automata treat identically.
+         */
+        std::vector<char32_t> get_alphabet(const CharAutomaton& a,
+                                           const CharAutomaton& b)
+        {
+            // Each ASCII character is its own range, as case-insensitive
+            // matching treats letters differently from everything else.
+            std::vector<char32_t> result;
+            for (char32_t ch = 0; ch <= 0x80; ++ch)
+                result.push_back(ch);
+            a.add_boundaries(result);
+            b.add_boundaries(result);
+            std::ranges::sort(result);
+            result.erase(std::unique(result.begin(), result.end()), result.end());
+            while (!result.empty() && result.back() > MAX_CODEPOINT)
+                result.pop_back();
+            // Strings never contain the null character.
+            result.erase(result.begin());
+            return result;
+        }
+    }
+
+    bool is_subset(const GlobElements& a, bool a_case_sensitive,
+                   const GlobElements& b, bool b_case_sensitive)
+    {
+        // Case-insensitive strings can't be a subset of case-sensitive
+        // ones, unless they don't contain letters, which isn't worth
+        // checking.
+        if (!a_case_sensitive && b_case_sensitive)
+            return false;
+
+        // The automaton for a may match more strings than GlobMatcher,
+        // which only makes the result more cautious. The automaton for b
+        // must be exact.
+        CharAutomaton a_automaton(a, a_case_sensitive);
+        CharAutomaton b_automaton(b, b_case_sensitive);
+        if (!a_automaton.is_complete() || !b_automaton.is_exact())
+            return false;
+
+        const auto alphabet = get_alphabet(a_automaton, b_automaton);
+
+        // Explores pairs of a set of states in a and the corresponding
+        // set of states in b. a isn't a subset of b if there is a pair
+        // where a has reached its accepting state and b hasn't.
+        using StatePair = std::pair<std::vector<uint32_t>, std::vector<uint32_t>>;
+        std::set<StatePair> visited;
+        std::deque<StatePair> queue;
+        queue.emplace_back(a_automaton.start(), b_automaton.start());
+        visited.insert(queue.front());
+
+        std::vector<uint32_t> next_a, next_b;
+        while (!queue.empty())
+        {
+            auto [states_a, states_b] = std::move(queue.front());
+            queue.pop_front();
+            if (a_automaton.is_match(states_a) && !b_automaton.is_match(states_b))
+                return false;
+
+            for (auto ch : alphabet)
+            {
+                a_automaton.advance(states_a, ch, next_a);
+                if (next_a.empty())
+                    continue;
+                b_automaton.advance(states_b, ch, next_b);
+                StatePair pair(next_a, next_b);
+                if (visited.insert(pair).second)
+                {
+                    if (visited.size() > MAX_STATE_PAIRS)
+                        return false;
+                    queue.push_back(std::move(pair));
+                }
+            }
+        }
+        return true;
+    }
+}
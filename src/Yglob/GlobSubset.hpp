@@ -0,0 +1,25 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include "GlobElements.hpp"
+
+namespace Yglob
+{
+    /**
+     * @brief Returns true if every string that matches @a a also
+     *      matches @a b.
+     *
+     * Both patterns are compiled into character-level automata, and the
+     * check explores their product. A false result means that the
+     * patterns either aren't subsets, or that they are too complex to
+     * check, e.g. case-insensitive patterns with non-ASCII letters.
+     */
+    [[nodiscard]]
+    bool is_subset(const GlobElements& a, bool a_case_sensitive,
+                   const GlobElements& b, bool b_case_sensitive);
+}
@@ -0,0 +1,541 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yglob/GlobWatcher.hpp"
+
+#include "Yglob/YglobException.hpp"
+
+#ifdef __linux__
+    #include <algorithm>
+    #include <map>
+    #include <unordered_map>
+    #include <poll.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+    #include "ComponentTrie.hpp"
+    #include "DirectoryReader.hpp"
+    #include "EntryFilter.hpp"
+    #include "FlagConversion.hpp"
+    #include "MultiPatternWalker.hpp"
+#endif
+
+namespace Yglob
+{
+#ifdef __linux__
+    namespace
+    {
+        constexpr uint32_t WATCH_MASK = IN_CREATE | IN_DELETE | IN_MOVED_FROM
+                                        | IN_MOVED_TO | IN_ONLYDIR;
+
+        std::filesystem::path from_string(std::string_view str)
+        {
+            return {std::u8string_view(reinterpret_cast<const char8_t*>(str.data()),
+                                       str.size())};
+        }
+
+        /**
+         * @brief Returns true if @a path is @a dir or a path below it.
+         */
+        bool is_in_tree(const std::filesystem::path& path,
+                        const std::filesystem::path& dir)
+        {
+            return std::mismatch(dir.begin(), dir.end(),
+                                 path.begin(), path.end()).first == dir.end();
+        }
+
+        /**
+         * @brief Returns the range of elements in [@a begin, @a end),
+         *      which is sorted by path, whose paths are @a dir or are
+         *      below it.
+         */
+        template <typename It, typename GetPath>
+        std::pair<It, It> find_tree(It begin, It end,
+                                    const std::filesystem::path& dir,
+                                    GetPath get_path)
+        {
+            auto first = std::partition_point(begin, end, [&](const auto& v)
+            {
+                return get_path(v) < dir;
+            });
+            auto last = std::partition_point(first, end, [&](const auto& v)
+            {
+                return is_in_tree(get_path(v), dir);
+            });
+            return {first, last};
+        }
+    }
+
+    class GlobWatcher::GlobWatcherImpl
+    {
+    public:
+        GlobWatcherImpl(const std::vector<std::filesystem::path>& glob_paths,
+                        const std::vector<std::string>& exclude_patterns,
+                        PathIteratorFlags flags)
+            : flags_(flags),
+              options_(to_directory_options(flags)),
+              filter_(make_entry_filter(exclude_patterns, flags))
+        {
+            for (size_t i = 0; i < glob_paths.size(); ++i)
+            {
+                trie_.add(glob_paths[i], to_glob_flags(flags),
+                          to_literal_flags(flags), i);
+            }
+
+            if (trie_.node(0).has_successors())
+            {
+                auto& [dir, nodes] = starts_.emplace_back();
+                trie_.add_with_closure(0, nodes);
+            }
+            for (const auto& [root, node] : trie_.roots())
+            {
+                auto& [dir, nodes] = starts_.emplace_back();
+                dir = from_string(root);
+                trie_.add_with_closure(node, nodes);
+            }
+
+            fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (fd_ == -1)
+                YGLOB_THROW("Unable to create an inotify instance.");
+
+            try
+            {
+                paths_ = scan_all();
+            }
+            catch (...)
+            {
+                close(fd_);
+                throw;
+            }
+        }
+
+        GlobWatcherImpl(const GlobWatcherImpl&) = delete;
+
+        ~GlobWatcherImpl()
+        {
+            close(fd_);
+        }
+
+        GlobWatcherImpl& operator=(const GlobWatcherImpl&) = delete;
+
+        [[nodiscard]]
+        const std::vector<std::filesystem::path>& paths() const
+        {
+            return paths_;
+        }
+
+        std::vector<GlobEvent> poll(std::chrono::milliseconds timeout)
+        {
+            pollfd fds = {fd_, POLLIN, 0};
+            if (::poll(&fds, 1, int(timeout.count())) <= 0)
+                return {};
+
+            std::vector<GlobEvent> events;
+            bool overflowed = false;
+            alignas(inotify_event) char buffer[16384];
+            while (true)
+            {
+                auto size = read(fd_, buffer, sizeof(buffer));
+                if (size <= 0)
+                    break;
+
+                for (ssize_t i = 0; i < size;)
+                {
+                    const auto* event = reinterpret_cast<const inotify_event*>(buffer + i);
+                    i += ssize_t(sizeof(inotify_event) + event->len);
+                    if (event->mask & IN_Q_OVERFLOW)
+                        overflowed = true;
+                    else if (!overflowed)
+                        handle_event(*event, events);
+                }
+            }
+
+            for (auto& move : pending_moves_)
+                add_events(GlobEventType::DELETED, move.paths, events);
+            pending_moves_.clear();
+            if (overflowed)
+                rescan(events);
+            return events;
+        }
+
+        [[nodiscard]]
+        int native_handle() const
+        {
+            return fd_;
+        }
+
+        [[nodiscard]]
+        size_t watch_count() const
+        {
+            return watches_.size();
+        }
+    private:
+        struct Watch
+        {
+            std::filesystem::path dir;
+            ComponentTrie::NodeList nodes;
+        };
+
+        /**
+         * @brief A path that was moved out of a watched directory, and
+         *      the matching paths that were below it.
+         */
+        struct PendingMove
+        {
+            uint32_t cookie = 0;
+            std::filesystem::path path;
+            std::vector<std::filesystem::path> paths;
+        };
+
+        std::vector<std::filesystem::path> scan_all()
+        {
+            std::vector<std::filesystem::path> result;
+            for (const auto& [dir, nodes] : starts_)
+            {
+                watch(dir, nodes);
+                scan(dir, nodes, result);
+            }
+            std::ranges::sort(result);
+            result.erase(std::unique(result.begin(), result.end()), result.end());
+            return result;
+        }
+
+        void rescan(std::vector<GlobEvent>& events)
+        {
+            for (const auto& [wd, _] : watches_)
+                inotify_rm_watch(fd_, wd);
+            watches_.clear();
+            watch_dirs_.clear();
+
+            auto old_paths = std::move(paths_);
+            paths_ = scan_all();
+
+            std::vector<std::filesystem::path> diff;
+            std::ranges::set_difference(old_paths, paths_, std::back_inserter(diff));
+            add_events(GlobEventType::DELETED, diff, events);
+            diff.clear();
+            std::ranges::set_difference(paths_, old_paths, std::back_inserter(diff));
+            add_events(GlobEventType::CREATED, diff, events);
+        }
+
+        void watch(const std::filesystem::path& dir,
+                   const ComponentTrie::NodeList& nodes)
+        {
+            auto wd = inotify_add_watch(fd_, dir.empty() ? "." : dir.c_str(),
+                                        WATCH_MASK);
+            if (wd == -1)
+                return;
+            // Directories that are reached through several paths, for
+            // instance by symbolic links, are only watched through the
+            // first.
+            if (watches_.try_emplace(wd, Watch{dir, nodes}).second)
+                watch_dirs_.emplace(dir, wd);
+        }
+
+        /**
+         * @brief Watches the directories below @a dir that can lead to
+         *      matches and appends the matching paths to @a paths.
+         */
+        void scan(const std::filesystem::path& dir,
+                  const ComponentTrie::NodeList& nodes,
+                  std::vector<std::filesystem::path>& paths)
+        {
+            try
+            {
+                for (auto& reader : make_directory_readers(trie_, dir, nodes,
+                                                           options_, nullptr))
+                {
+                    while (reader.next())
+                        visit(reader, nodes, paths);
+                }
+            }
+            catch (std::filesystem::filesystem_error&)
+            {
+                // The directory may have been removed before it was read.
+                std::error_code ec;
+                if (std::filesystem::exists(dir.empty() ? "." : dir, ec))
+                    throw;
+            }
+        }
+
+        void visit(const DirectoryReader& entry,
+                   const ComponentTrie::NodeList& nodes,
+                   std::vector<std::filesystem::path>& paths)
+        {
+            ComponentTrie::NodeList next_nodes;
+            trie_.advance(nodes, entry.name(), next_nodes);
+            if (next_nodes.empty())
+                return;
+
+            if (filter_ && filter_->is_excluded(entry))
+                return;
+
+            bool is_match = false;
+            bool has_successors = false;
+            bool has_any_path = false;
+            for (auto index : next_nodes)
+            {
+                const auto& node = trie_.node(index);
+                is_match = is_match || !node.patterns.empty();
+                has_successors = has_successors || node.has_successors();
+                has_any_path = has_any_path || node.is_any_path;
+            }
+
+            const auto is_directory = entry.is_directory();
+            if (is_match && is_acceptable(entry, is_directory))
+                paths.push_back(entry.path());
+
+            // Like PathIterator, `**` doesn't follow symbolic links to
+            // directories.
+            if (is_directory && has_successors
+                && !(has_any_path && entry.is_symlink()))
+            {
+                watch(entry.path(), next_nodes);
+                scan(entry.path(), next_nodes, paths);
+            }
+        }
+
+        [[nodiscard]]
+        bool is_acceptable(const DirectoryReader& entry, bool is_directory) const
+        {
+            if (bool(flags_ & PathIteratorFlags::NO_DIRECTORIES) && is_directory)
+                return false;
+            if (bool(flags_ & PathIteratorFlags::NO_FILES) && entry.is_regular_file())
+                return false;
+            return true;
+        }
+
+        void handle_event(const inotify_event& event, std::vector<GlobEvent>& events)
+        {
+            if (event.mask & IN_IGNORED)
+            {
+                remove_watch(event.wd);
+                return;
+            }
+
+            auto it = watches_.find(event.wd);
+            if (it == watches_.end() || event.len == 0)
+                return;
+
+            // Copy the watch, as handling the event can change watches_.
+            auto [dir, nodes] = it->second;
+            std::string name(event.name);
+            auto path = dir.empty() ? from_string(name) : dir / from_string(name);
+
+            if (event.mask & (IN_DELETE | IN_MOVED_FROM))
+            {
+                auto removed = remove_tree(path);
+                if (event.mask & IN_MOVED_FROM)
+                    pending_moves_.push_back({event.cookie, path, std::move(removed)});
+                else
+                    add_events(GlobEventType::DELETED, removed, events);
+                return;
+            }
+
+            std::vector<std::filesystem::path> added;
+            DirectoryReader reader(dir, {name});
+            if (reader.next())
+                visit(reader, nodes, added);
+            std::ranges::sort(added);
+            added.erase(std::remove_if(added.begin(), added.end(), [&](auto& p)
+                                       {
+                                           return !insert_path(p);
+                                       }),
+                        added.end());
+
+            auto move = std::ranges::find_if(pending_moves_, [&](auto& m)
+            {
+                return (event.mask & IN_MOVED_TO) && m.cookie == event.cookie;
+            });
+            if (move == pending_moves_.end())
+            {
+                add_events(GlobEventType::CREATED, added, events);
+                return;
+            }
+
+            auto removed = std::move(move->paths);
+            auto old_dir = std::move(move->path);
+            pending_moves_.erase(move);
+            for (auto& new_path : added)
+            {
+                auto old_path = old_dir;
+                if (new_path != path)
+                    old_path /= new_path.lexically_relative(path);
+                auto r = std::ranges::lower_bound(removed, old_path);
+                if (r != removed.end() && *r == old_path)
+                {
+                    events.push_back({GlobEventType::MOVED, std::move(new_path),
+                                      std::move(*r)});
+                    removed.erase(r);
+                }
+                else
+                {
+                    events.push_back({GlobEventType::CREATED, std::move(new_path), {}});
+                }
+            }
+            add_events(GlobEventType::DELETED, removed, events);
+        }
+
+        /**
+         * @brief Inserts @a path in paths_, returns false if it was there
+         *      already.
+         */
+        bool insert_path(const std::filesystem::path& path)
+        {
+            auto it = std::ranges::lower_bound(paths_, path);
+            if (it != paths_.end() && *it == path)
+                return false;
+            paths_.insert(it, path);
+            return true;
+        }
+
+        /**
+         * @brief Removes @a path and the paths below it from paths_ and
+         *      stops watching the directories there.
+         *
+         * @return The paths that were removed, sorted.
+         */
+        std::vector<std::filesystem::path> remove_tree(const std::filesystem::path& path)
+        {
+            auto [wfirst, wlast] = find_tree(watch_dirs_.begin(), watch_dirs_.end(),
+                                             path, [](auto& w) -> auto& {return w.first;});
+            for (auto it = wfirst; it != wlast; ++it)
+            {
+                inotify_rm_watch(fd_, it->second);
+                watches_.erase(it->second);
+            }
+            watch_dirs_.erase(wfirst, wlast);
+
+            auto [first, last] = find_tree(paths_.begin(), paths_.end(), path,
+                                           [](auto& p) -> auto& {return p;});
+            std::vector<std::filesystem::path> result(std::make_move_iterator(first),
+                                                      std::make_move_iterator(last));
+            paths_.erase(first, last);
+            return result;
+        }
+
+        void remove_watch(int wd)
+        {
+            auto it = watches_.find(wd);
+            if (it == watches_.end())
+                return;
+            auto dir_it = watch_dirs_.find(it->second.dir);
+            if (dir_it != watch_dirs_.end() && dir_it->second == wd)
+                watch_dirs_.erase(dir_it);
+            watches_.erase(it);
+        }
+
+        static void add_events(GlobEventType type,
+                               std::vector<std::filesystem::path>& paths,
+                               std::vector<GlobEvent>& events)
+        {
+            for (auto& path : paths)
+                events.push_back({type, std::move(path), {}});
+        }
+
+        ComponentTrie trie_;
+        PathIteratorFlags flags_;
+        std::filesystem::directory_options options_;
+        std::shared_ptr<EntryFilter> filter_;
+        /**
+         * @brief The directories where the matching starts and their
+         *      initial nodes.
+         */
+        std::vector<std::pair<std::filesystem::path, ComponentTrie::NodeList>> starts_;
+        int fd_ = -1;
+        std::unordered_map<int, Watch> watches_;
+        std::map<std::filesystem::path, int> watch_dirs_;
+        std::vector<std::filesystem::path> paths_;
+        std::vector<PendingMove> pending_moves_;
+    };
+#else
+    class GlobWatcher::GlobWatcherImpl
+    {
+    public:
+        GlobWatcherImpl(const std::vector<std::filesystem::path>&,
+                        const std::vector<std::string>&,
+                        PathIteratorFlags)
+        {
+            YGLOB_THROW("GlobWatcher is only available on Linux.");
+        }
+
+        [[nodiscard]]
+        const std::vector<std::filesystem::path>& paths() const
+        {
+            return paths_;
+        }
+
+        std::vector<GlobEvent> poll(std::chrono::milliseconds)
+        {
+            return {};
+        }
+
+        [[nodiscard]]
+        int native_handle() const
+        {
+            return -1;
+        }
+
+        [[nodiscard]]
+        size_t watch_count() const
+        {
+            return 0;
+        }
+    private:
+        std::vector<std::filesystem::path> paths_;
+    };
+#endif
+
+    GlobWatcher::GlobWatcher() = default;
+
+    GlobWatcher::GlobWatcher(const std::filesystem::path& glob_path,
+                             PathIteratorFlags flags)
+        : GlobWatcher(std::vector{glob_path}, {}, flags)
+    {}
+
+    GlobWatcher::GlobWatcher(const std::vector<std::filesystem::path>& glob_paths,
+                             const std::vector<std::string>& exclude_patterns,
+                             PathIteratorFlags flags)
+        : impl_(std::make_unique<GlobWatcherImpl>(glob_paths, exclude_patterns,
+                                                  flags))
+    {}
+
+    GlobWatcher::GlobWatcher(GlobWatcher&& rhs) noexcept = default;
+
+    GlobWatcher::~GlobWatcher() = default;
+
+    GlobWatcher& GlobWatcher::operator=(GlobWatcher&& rhs) noexcept = default;
+
+    bool GlobWatcher::is_supported()
+    {
+#ifdef __linux__
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    const std::vector<std::filesystem::path>& GlobWatcher::paths() const
+    {
+        static const std::vector<std::filesystem::path> empty_paths;
+        return impl_ ? impl_->paths() : empty_paths;
+    }
+
+    std::vector<GlobEvent> GlobWatcher::poll(std::chrono::milliseconds timeout)
+    {
+        return impl_ ? impl_->poll(timeout) : std::vector<GlobEvent>();
+    }
+
+    int GlobWatcher::native_handle() const
+    {
+        return impl_ ? impl_->native_handle() : -1;
+    }
+
+    size_t GlobWatcher::watch_count() const
+    {
+        return impl_ ? impl_->watch_count() : 0;
+    }
+}
@@ -0,0 +1,320 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yglob/IgnoreFilter.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <unordered_map>
+#include <Ystring/Algorithms.hpp>
+#include "IgnoreRules.hpp"
+#include "PathComponents.hpp"
+
+namespace Yglob
+{
+    namespace
+    {
+        std::string to_string(const std::filesystem::path& path)
+        {
+            return std::string(ystring::to_string_view(path.generic_u8string()));
+        }
+
+        std::filesystem::path from_string(std::string_view str)
+        {
+            return {std::u8string_view(reinterpret_cast<const char8_t*>(str.data()),
+                                       str.size())};
+        }
+
+        std::filesystem::path normalized_absolute(const std::filesystem::path& path)
+        {
+            auto result = std::filesystem::absolute(path).lexically_normal();
+            if (!result.has_filename() && result.has_relative_path())
+                result = result.parent_path();
+            return result;
+        }
+
+        bool is_within(const std::filesystem::path& path,
+                       const std::filesystem::path& dir)
+        {
+            auto [it, _] = std::mismatch(dir.begin(), dir.end(),
+                                         path.begin(), path.end());
+            return it == dir.end();
+        }
+
+        /**
+         * @brief Splits @a path into the parent directory and the file name.
+         */
+        std::pair<std::string_view, std::string_view>
+        split_last(std::string_view path)
+        {
+            auto rest = path;
+            auto root = extract_root(rest);
+            while (!rest.empty() && is_path_separator(rest.back()))
+                rest.remove_suffix(1);
+
+            auto i = rest.size();
+            while (i > 0 && !is_path_separator(rest[i - 1]))
+                --i;
+            auto name = rest.substr(i);
+            while (i > 0 && is_path_separator(rest[i - 1]))
+                --i;
+            if (i == 0)
+                return {root, name};
+            return {path.substr(0, root.size() + i), name};
+        }
+
+        template <typename Func>
+        auto with_string_view(const std::filesystem::path& path, Func func)
+        {
+            if constexpr (std::is_same_v<std::filesystem::path::value_type, char>)
+            {
+                return func(std::string_view(path.native()));
+            }
+            else
+            {
+                auto u8str = path.generic_u8string();
+                return func(ystring::to_string_view(u8str));
+            }
+        }
+    }
+
+    class IgnoreFilter::IgnoreFilterImpl
+    {
+    public:
+        explicit IgnoreFilterImpl(std::vector<std::string> file_names)
+            : file_names_(std::move(file_names))
+        {}
+
+        void add_rules(const std::filesystem::path& directory,
+                       std::string_view text)
+        {
+            auto& rules = extra_rules_[to_string(normalized_absolute(directory))];
+            rules.append(text);
+            rules.push_back('\n');
+            chains_.clear();
+            tops_.clear();
+        }
+
+        bool is_ignored(std::string_view path, bool is_directory)
+        {
+            auto [dir, name] = split_last(path);
+            // Make sure the top directory is found from the path's own
+            // directory.
+            std::ignore = get_chain(dir);
+
+            std::vector<std::string_view> parents;
+            while (!dir.empty())
+            {
+                auto [parent_dir, parent_name] = split_last(dir);
+                if (parent_name.empty())
+                    break;
+                parents.push_back(dir);
+                dir = parent_dir;
+            }
+
+            // Check the parent directories from the top and down.
+            for (auto it = parents.rbegin(); it != parents.rend(); ++it)
+            {
+                if (is_ignored_entry(*it, true))
+                    return true;
+            }
+            return is_ignored_entry(path, is_directory);
+        }
+
+        bool is_ignored_entry(std::string_view path, bool is_directory)
+        {
+            auto [dir, name] = split_last(path);
+            if (name.empty() || name == "." || name == "..")
+                return false;
+
+            const auto& chain = get_chain(dir);
+            for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+            {
+                buffer_ = it->prefix;
+                if (!buffer_.empty())
+                    buffer_.push_back('/');
+                buffer_.append(name);
+                auto verdict = it->rules->match(buffer_, is_directory);
+                if (verdict != IgnoreVerdict::NONE)
+                    return verdict == IgnoreVerdict::IGNORED;
+            }
+            return false;
+        }
+    private:
+        struct Level
+        {
+            std::shared_ptr<const IgnoreRules> rules;
+            /**
+             * @brief The path from the directory containing the rules to
+             *      the directory the chain belongs to.
+             */
+            std::string prefix;
+        };
+
+        using Chain = std::vector<Level>;
+
+        /**
+         * @brief Returns the rules that apply to the entries in @a dir,
+         *      starting with those with the lowest precedence.
+         */
+        const Chain& get_chain(std::string_view dir)
+        {
+            if (auto it = chains_.find(dir); it != chains_.end())
+                return it->second;
+
+            auto abs_dir = normalized_absolute(dir.empty() ? std::filesystem::path(".")
+                                                           : from_string(dir));
+            auto abs_key = to_string(abs_dir);
+            if (abs_key != dir)
+            {
+                auto chain = get_chain(abs_key);
+                return chains_.emplace(std::string(dir), std::move(chain)).first->second;
+            }
+
+            Chain chain;
+            auto parent = abs_dir.parent_path();
+            if (abs_dir != find_top(abs_dir, abs_key) && parent != abs_dir)
+            {
+                const auto& parent_chain = get_chain(to_string(parent));
+                auto name = to_string(abs_dir.filename());
+                for (const auto& level : parent_chain)
+                {
+                    auto prefix = level.prefix.empty() ? name
+                                                       : level.prefix + '/' + name;
+                    chain.push_back({level.rules, std::move(prefix)});
+                }
+            }
+
+            if (auto rules = load_rules(abs_dir, abs_key))
+                chain.push_back({std::move(rules), {}});
+
+            return chains_.emplace(std::move(abs_key), std::move(chain)).first->second;
+        }
+
+        /**
+         * @brief Returns the directory where the search for ignore files
+         *      from @a dir stops.
+         *
+         * The top of each directory passed on the way up is cached, so
+         * finding the tops of all the directories in a tree only looks
+         * for .git once per directory.
+         */
+        const std::filesystem::path& find_top(const std::filesystem::path& dir,
+                                              const std::string& key)
+        {
+            if (auto it = tops_.find(key); it != tops_.end())
+                return it->second;
+
+            std::vector<std::string> keys;
+            std::error_code ec;
+            for (auto path = dir; ; path = path.parent_path())
+            {
+                auto path_key = to_string(path);
+                if (auto it = tops_.find(path_key); it != tops_.end())
+                    return add_top(keys, it->second);
+                keys.push_back(std::move(path_key));
+                if (std::filesystem::exists(path / ".git", ec))
+                    return add_top(keys, path);
+                if (path == path.parent_path())
+                    break;
+            }
+
+            // Without a repository, the outermost directory with
+            // explicitly added rules is the top. The directories above
+            // dir aren't cached, as they would be their own tops.
+            auto result = dir;
+            for (const auto& [rules_key, _] : extra_rules_)
+            {
+                auto rules_dir = from_string(rules_key);
+                if (is_within(result, rules_dir))
+                    result = std::move(rules_dir);
+            }
+            keys.resize(1);
+            return add_top(keys, result);
+        }
+
+        const std::filesystem::path& add_top(const std::vector<std::string>& keys,
+                                             const std::filesystem::path& top)
+        {
+            // top may refer to a value in tops_, copy it before inserting.
+            auto top_copy = top;
+            for (const auto& key : keys)
+                tops_.insert_or_assign(key, top_copy);
+            return tops_.find(keys.front())->second;
+        }
+
+        std::shared_ptr<const IgnoreRules>
+        load_rules(const std::filesystem::path& dir, const std::string& key)
+        {
+            auto rules = std::make_shared<IgnoreRules>();
+            if (auto it = extra_rules_.find(key); it != extra_rules_.end())
+                rules->add_rules(it->second);
+
+            for (const auto& file_name : file_names_)
+            {
+                std::ifstream stream(dir / file_name, std::ios::binary);
+                if (!stream)
+                    continue;
+                std::string text((std::istreambuf_iterator<char>(stream)),
+                                 std::istreambuf_iterator<char>());
+                rules->add_rules(text);
+            }
+
+            if (rules->empty())
+                return nullptr;
+            return rules;
+        }
+
+        std::vector<std::string> file_names_;
+        /**
+         * @brief The top directory of each directory whose top has been
+         *      found.
+         */
+        std::unordered_map<std::string, std::filesystem::path> tops_;
+        std::unordered_map<std::string, Chain, StringHash, std::equal_to<>> chains_;
+        std::unordered_map<std::string, std::string> extra_rules_;
+        std::string buffer_;
+    };
+
+    IgnoreFilter::IgnoreFilter()
+        : IgnoreFilter({".gitignore", ".ignore"})
+    {}
+
+    IgnoreFilter::IgnoreFilter(std::vector<std::string> file_names)
+        : impl_(std::make_unique<IgnoreFilterImpl>(std::move(file_names)))
+    {}
+
+    IgnoreFilter::IgnoreFilter(IgnoreFilter&& rhs) noexcept = default;
+
+    IgnoreFilter::~IgnoreFilter() = default;
+
+    IgnoreFilter& IgnoreFilter::operator=(IgnoreFilter&& rhs) noexcept = default;
+
+    void IgnoreFilter::add_rules(const std::filesystem::path& directory,
+                                 std::string_view text)
+    {
+        impl_->add_rules(directory, text);
+    }
+
+    bool IgnoreFilter::is_ignored(const std::filesystem::path& path,
+                                  bool is_directory)
+    {
+        return with_string_view(path, [&](std::string_view s)
+        {
+            return impl_->is_ignored(s, is_directory);
+        });
+    }
+
+    bool IgnoreFilter::is_ignored_entry(const std::filesystem::path& path,
+                                        bool is_directory)
+    {
+        return with_string_view(path, [&](std::string_view s)
+        {
+            return impl_->is_ignored_entry(s, is_directory);
+        });
+    }
+}
@@ -0,0 +1,141 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "IgnoreRules.hpp"
+
+#include <ranges>
+#include "Yglob/GlobMatcher.hpp"
+
+namespace Yglob
+{
+    namespace
+    {
+        const auto IGNORE_GLOB_FLAGS = GlobFlags::CASE_SENSITIVE
+                                           | GlobFlags::NO_BRACES;
+
+        void remove_trailing_spaces(std::string_view& line)
+        {
+            while (!line.empty() && line.back() == ' ')
+            {
+                if (line.size() >= 2 && line[line.size() - 2] == '\\')
+                    break;
+                line.remove_suffix(1);
+            }
+        }
+
+        /**
+         * @brief Converts a component of a gitignore pattern to the glob
+         *      syntax used by Yglob.
+         */
+        std::string convert_component(std::string_view name)
+        {
+            std::string result;
+            if (!is_glob_pattern(name, IGNORE_GLOB_FLAGS))
+            {
+                // Literal components are compared as they are, remove
+                // the escapes.
+                for (size_t i = 0; i < name.size(); ++i)
+                {
+                    if (name[i] == '\\' && i + 1 < name.size())
+                        ++i;
+                    result.push_back(name[i]);
+                }
+                return result;
+            }
+
+            // Sets are negated with '!' in gitignore files.
+            for (size_t i = 0; i < name.size(); ++i)
+            {
+                result.push_back(name[i]);
+                if (name[i] == '\\' && i + 1 < name.size())
+                    result.push_back(name[++i]);
+                else if (name[i] == '[' && i + 1 < name.size() && name[i + 1] == '!')
+                    result.push_back(name[++i] == '!' ? '^' : name[i]);
+            }
+            return result;
+        }
+    }
+
+    void IgnoreRules::add_rules(std::string_view text)
+    {
+        for (auto line : std::views::split(text, '\n'))
+            add_rule(std::string_view(line.begin(), line.end()));
+    }
+
+    void IgnoreRules::add_rule(std::string_view line)
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        remove_trailing_spaces(line);
+        if (line.empty() || line[0] == '#')
+            return;
+
+        Rule rule;
+        if (line[0] == '!')
+        {
+            rule.negated = true;
+            line.remove_prefix(1);
+        }
+
+        while (!line.empty() && line.back() == '/')
+        {
+            rule.directory_only = true;
+            line.remove_suffix(1);
+        }
+
+        if (line.empty())
+            return;
+
+        // Patterns with a separator at the start or in the middle are
+        // relative to the ignore file's directory, the others can match
+        // at any level below it.
+        std::string pattern;
+        if (line[0] == '/')
+            line.remove_prefix(1);
+        else if (line.find('/') == std::string_view::npos)
+            pattern = "**/";
+
+        for (auto part : std::views::split(line, '/'))
+        {
+            std::string_view name(part.begin(), part.end());
+            if (name.empty())
+                continue;
+            if (name == "**")
+                pattern += "**";
+            else
+                pattern += convert_component(name);
+            pattern.push_back('/');
+        }
+        pattern.pop_back();
+
+        // A trailing `**` matches everything inside the directory, but not
+        // the directory itself.
+        if (pattern.ends_with("/**"))
+            pattern += "/*";
+
+        patterns_.add(std::string_view(pattern), IGNORE_GLOB_FLAGS);
+        rules_.push_back(rule);
+    }
+
+    IgnoreVerdict IgnoreRules::match(std::string_view path,
+                                     bool is_directory) const
+    {
+        if (rules_.empty())
+            return IgnoreVerdict::NONE;
+
+        auto indexes = patterns_.find_all(path);
+        for (auto index : std::views::reverse(indexes))
+        {
+            const auto& rule = rules_[index];
+            if (rule.directory_only && !is_directory)
+                continue;
+            return rule.negated ? IgnoreVerdict::INCLUDED
+                                : IgnoreVerdict::IGNORED;
+        }
+        return IgnoreVerdict::NONE;
+    }
+}
@@ -0,0 +1,63 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <string_view>
+#include <vector>
+#include "Yglob/PathMatcherSet.hpp"
+
+namespace Yglob
+{
+    enum class IgnoreVerdict
+    {
+        NONE,
+        IGNORED,
+        INCLUDED
+    };
+
+    /**
+     * @brief The rules in one directory's ignore files.
+     *
+     * The rules use the same syntax and semantics as .gitignore files.
+     */
+    class IgnoreRules
+    {
+    public:
+        /**
+         * @brief Adds the rules in @a text, one rule per line.
+         */
+        void add_rules(std::string_view text);
+
+        /**
+         * @brief Adds a single rule. Blank lines and comments are ignored.
+         */
+        void add_rule(std::string_view line);
+
+        [[nodiscard]]
+        bool empty() const
+        {
+            return rules_.empty();
+        }
+
+        /**
+         * @brief Returns the verdict of the last rule that matches
+         *      @a path, which must be relative to the directory
+         *      containing the ignore files.
+         */
+        [[nodiscard]]
+        IgnoreVerdict match(std::string_view path, bool is_directory) const;
+    private:
+        struct Rule
+        {
+            bool negated = false;
+            bool directory_only = false;
+        };
+
+        PathMatcherSet patterns_;
+        std::vector<Rule> rules_;
+    };
+}
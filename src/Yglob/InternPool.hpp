@@ -0,0 +1,85 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "PathComponents.hpp"
+
+namespace Yglob
+{
+    /**
+     * @brief Lets objects that are made from the same key share a single
+     *      immutable instance.
+     *
+     * The pool only holds weak references, an instance is destroyed when
+     * the last object that uses it is. InternPool is thread safe.
+     */
+    template <typename T>
+    class InternPool
+    {
+    public:
+        /**
+         * @brief Returns the instance for @a key, calling @a make to
+         *      create it if there is none.
+         *
+         * @a make is called without holding the pool's lock, and it may
+         * throw.
+         */
+        template <typename Factory>
+        [[nodiscard]]
+        std::shared_ptr<const T> get(std::string_view key, Factory make)
+        {
+            {
+                std::scoped_lock lock(mutex_);
+                auto it = items_.find(key);
+                if (it != items_.end())
+                {
+                    if (auto item = it->second.lock())
+                        return item;
+                }
+            }
+
+            std::shared_ptr<const T> item = make();
+
+            std::scoped_lock lock(mutex_);
+            auto [it, inserted] = items_.try_emplace(std::string(key), item);
+            if (!inserted)
+            {
+                // Another thread may have made the same instance meanwhile.
+                if (auto existing = it->second.lock())
+                    return existing;
+                it->second = item;
+            }
+            else if (items_.size() >= sweep_size_)
+            {
+                sweep();
+            }
+            return item;
+        }
+    private:
+        /**
+         * @brief Removes the keys whose instances have been destroyed.
+         */
+        void sweep()
+        {
+            std::erase_if(items_, [](auto& entry)
+            {
+                return entry.second.expired();
+            });
+            sweep_size_ = std::max<size_t>(64, 2 * items_.size());
+        }
+
+        std::mutex mutex_;
+        std::unordered_map<std::string, std::weak_ptr<const T>,
+                           StringHash, std::equal_to<>> items_;
+        size_t sweep_size_ = 64;
+    };
+}
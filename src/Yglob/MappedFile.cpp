@@ -0,0 +1,135 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "MappedFile.hpp"
+
+#include <utility>
+#include "Yglob/YglobException.hpp"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Yglob
+{
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::filesystem::path& path)
+    {
+        auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                                nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            YGLOB_THROW("Unable to open file.");
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            YGLOB_THROW("Unable to get the file size.");
+        }
+
+        size_ = size_t(size.QuadPart);
+        if (size_ != 0)
+        {
+            mapping_ = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0,
+                                          nullptr);
+            if (mapping_)
+            {
+                data_ = static_cast<const char*>(
+                    MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+            }
+        }
+        CloseHandle(file);
+        if (size_ != 0 && !data_)
+        {
+            unmap();
+            YGLOB_THROW("Unable to map file into memory.");
+        }
+    }
+
+    void MappedFile::unmap()
+    {
+        if (data_)
+            UnmapViewOfFile(data_);
+        if (mapping_)
+            CloseHandle(mapping_);
+        data_ = nullptr;
+        mapping_ = nullptr;
+        size_ = 0;
+    }
+#else
+    MappedFile::MappedFile(const std::filesystem::path& path)
+    {
+        auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            YGLOB_THROW("Unable to open file.");
+
+        struct stat st = {};
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            YGLOB_THROW("Unable to get the file size.");
+        }
+
+        size_ = size_t(st.st_size);
+        if (size_ != 0)
+        {
+            auto data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+            if (data != MAP_FAILED)
+                data_ = static_cast<const char*>(data);
+        }
+        ::close(fd);
+        if (size_ != 0 && !data_)
+        {
+            size_ = 0;
+            YGLOB_THROW("Unable to map file into memory.");
+        }
+    }
+
+    void MappedFile::unmap()
+    {
+        if (data_)
+            ::munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+#endif
+
+    MappedFile::MappedFile(MappedFile&& rhs) noexcept
+        : data_(std::exchange(rhs.data_, nullptr)),
+          size_(std::exchange(rhs.size_, 0))
+#ifdef _WIN32
+        , mapping_(std::exchange(rhs.mapping_, nullptr))
+#endif
+    {}
+
+    MappedFile::~MappedFile()
+    {
+        unmap();
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            unmap();
+            data_ = std::exchange(rhs.data_, nullptr);
+            size_ = std::exchange(rhs.size_, 0);
+#ifdef _WIN32
+            mapping_ = std::exchange(rhs.mapping_, nullptr);
+#endif
+        }
+        return *this;
+    }
+}
@@ -0,0 +1,49 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <string_view>
+
+namespace Yglob
+{
+    /**
+     * @brief A read-only memory mapping of an entire file.
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+
+        /**
+         * @brief Maps the file at @a path into memory.
+         *
+         * Throws YglobException if the file can't be opened or mapped.
+         */
+        explicit MappedFile(const std::filesystem::path& path);
+
+        MappedFile(MappedFile&& rhs) noexcept;
+
+        ~MappedFile();
+
+        MappedFile& operator=(MappedFile&& rhs) noexcept;
+
+        [[nodiscard]]
+        std::string_view data() const
+        {
+            return {data_, size_};
+        }
+    private:
+        void unmap();
+
+        const char* data_ = nullptr;
+        size_t size_ = 0;
+#ifdef _WIN32
+        void* mapping_ = nullptr;
+#endif
+    };
+}
@@ -45,7 +45,7 @@ namespace Yglob
     {
         struct StartsWithVisitor
         {
-            bool operator()(const std::string& s) const
+            bool operator()(const std::pmr::string& s) const
             {
                 if (detail::starts_with(str, s, case_sensitive))
                 {
@@ -98,6 +98,13 @@ namespace Yglob
                 return true;
             }
 
+            bool operator()(const ExtGlob&) const
+            {
+                // Patterns with extended globs are matched by
+                // ExtGlobAutomaton.
+                return false;
+            }
+
             std::string_view& str;
             bool case_sensitive;
         };
@@ -111,7 +118,7 @@ namespace Yglob
     {
         struct EndsWithVisitor
         {
-            bool operator()(const std::string& s) const
+            bool operator()(const std::pmr::string& s) const
             {
                 if (detail::ends_with(str, s, case_sensitive))
                 {
@@ -161,6 +168,13 @@ namespace Yglob
                 return true;
             }
 
+            bool operator()(const ExtGlob&) const
+            {
+                // Patterns with extended globs are matched by
+                // ExtGlobAutomaton.
+                return false;
+            }
+
             std::string_view& str;
             bool case_sensitive;
         };
@@ -170,7 +184,7 @@ namespace Yglob
 
     // NOLINTBEGIN(misc-no-recursion)
 
-    bool match_fwd(const std::span <GlobElement> parts,
+    bool match_fwd(const std::span<const GlobElement> parts,
                    std::string_view& str,
                    const bool case_sensitive,
                    const bool is_subpattern)
@@ -198,7 +212,7 @@ namespace Yglob
         return false;
     }
 
-    bool search_fwd(const std::span <GlobElement> parts,
+    bool search_fwd(const std::span<const GlobElement> parts,
                     std::string_view& str,
                     const bool case_sensitive,
                     const bool is_subpattern)
@@ -220,7 +234,7 @@ namespace Yglob
         return false;
     }
 
-    bool match_end(const std::span <GlobElement> parts,
+    bool match_end(const std::span<const GlobElement> parts,
                    std::string_view& str,
                    const bool case_sensitive)
     {
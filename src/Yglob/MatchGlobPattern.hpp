@@ -11,14 +11,14 @@
 
 namespace Yglob
 {
-    bool match_fwd(std::span<GlobElement> parts, std::string_view& str,
+    bool match_fwd(std::span<const GlobElement> parts, std::string_view& str,
                    bool case_sensitive,
                    bool is_subpattern);
 
-    bool search_fwd(std::span<GlobElement> parts, std::string_view& str,
+    bool search_fwd(std::span<const GlobElement> parts, std::string_view& str,
                     bool case_sensitive,
                     bool is_subpattern);
 
-    bool match_end(std::span<GlobElement> parts, std::string_view& str,
+    bool match_end(std::span<const GlobElement> parts, std::string_view& str,
                    bool case_sensitive);
 }
@@ -0,0 +1,177 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yglob/MemoryFileSystem.hpp"
+
+#include <unordered_map>
+#include <Ystring/Algorithms.hpp>
+#include "Yglob/YglobException.hpp"
+
+namespace Yglob
+{
+    namespace
+    {
+        /**
+         * @brief Returns the normalized generic form of @a path, without
+         *      a trailing separator.
+         */
+        std::string to_key(const std::filesystem::path& path)
+        {
+            auto str = path.lexically_normal().generic_u8string();
+            std::string key(ystring::to_string_view(str));
+            if (key == ".")
+                key.clear();
+            else if (key.size() > 1 && key.back() == '/')
+                key.pop_back();
+            return key;
+        }
+
+        bool is_root(std::string_view key)
+        {
+            return key.empty() || key == "/";
+        }
+
+        /**
+         * @brief Splits @a key into the parent directory's key and the
+         *      file name.
+         */
+        std::pair<std::string_view, std::string_view> split(std::string_view key)
+        {
+            auto pos = key.rfind('/');
+            if (pos == std::string_view::npos)
+                return {{}, key};
+            return {key.substr(0, std::max<size_t>(pos, 1)), key.substr(pos + 1)};
+        }
+    }
+
+    class MemoryFileSystem::MemoryFileSystemImpl
+    {
+    public:
+        void add(const std::string& key, std::filesystem::file_type type)
+        {
+            using std::filesystem::file_type;
+            if (is_root(key))
+            {
+                if (type != file_type::directory)
+                    YGLOB_THROW("The root of a MemoryFileSystem must be a directory.");
+                nodes_.try_emplace(key, Node{type, std::make_shared<Listing>()});
+                return;
+            }
+
+            if (auto it = nodes_.find(key); it != nodes_.end())
+            {
+                if (it->second.type == file_type::directory
+                    && type == file_type::directory)
+                {
+                    return;
+                }
+                YGLOB_THROW("The MemoryFileSystem already has a file at the given path.");
+            }
+
+            auto [parent, name] = split(key);
+            std::string parent_key(parent);
+            add(parent_key, file_type::directory);
+
+            // Listings that have been handed out are left unchanged.
+            auto& listing = nodes_.find(parent_key)->second.listing;
+            if (listing.use_count() > 1)
+                listing = std::make_shared<Listing>(*listing);
+            listing->push_back({std::string(name), type, false});
+
+            std::shared_ptr<Listing> entries;
+            if (type == file_type::directory)
+                entries = std::make_shared<Listing>();
+            nodes_.emplace(key, Node{type, std::move(entries)});
+            ++size_;
+        }
+
+        [[nodiscard]]
+        size_t size() const
+        {
+            return size_;
+        }
+
+        std::shared_ptr<const Listing>
+        list_directory(const std::filesystem::path& directory) const
+        {
+            auto key = to_key(directory);
+            auto it = nodes_.find(key);
+            if (it == nodes_.end())
+            {
+                if (is_root(key))
+                    return std::make_shared<Listing>();
+                throw std::filesystem::filesystem_error(
+                    "MemoryFileSystem::list_directory", directory,
+                    std::make_error_code(std::errc::no_such_file_or_directory));
+            }
+            if (!it->second.listing)
+            {
+                throw std::filesystem::filesystem_error(
+                    "MemoryFileSystem::list_directory", directory,
+                    std::make_error_code(std::errc::not_a_directory));
+            }
+            return it->second.listing;
+        }
+
+        [[nodiscard]]
+        Status status(const std::filesystem::path& path) const
+        {
+            auto key = to_key(path);
+            if (auto it = nodes_.find(key); it != nodes_.end())
+                return {it->second.type, false};
+            if (is_root(key))
+                return {std::filesystem::file_type::directory, false};
+            return {std::filesystem::file_type::not_found, false};
+        }
+    private:
+        struct Node
+        {
+            std::filesystem::file_type type;
+            /**
+             * @brief The entries in the directory, null for other files.
+             */
+            std::shared_ptr<Listing> listing;
+        };
+
+        std::unordered_map<std::string, Node> nodes_;
+        size_t size_ = 0;
+    };
+
+    MemoryFileSystem::MemoryFileSystem()
+        : impl_(std::make_unique<MemoryFileSystemImpl>())
+    {}
+
+    MemoryFileSystem::~MemoryFileSystem() = default;
+
+    void MemoryFileSystem::add_file(const std::filesystem::path& path,
+                                    std::filesystem::file_type type)
+    {
+        impl_->add(to_key(path), type);
+    }
+
+    void MemoryFileSystem::add_directory(const std::filesystem::path& path)
+    {
+        impl_->add(to_key(path), std::filesystem::file_type::directory);
+    }
+
+    size_t MemoryFileSystem::size() const
+    {
+        return impl_->size();
+    }
+
+    std::shared_ptr<const FileSystem::Listing>
+    MemoryFileSystem::list_directory(const std::filesystem::path& directory,
+                                     std::filesystem::directory_options)
+    {
+        return impl_->list_directory(directory);
+    }
+
+    FileSystem::Status MemoryFileSystem::status(const std::filesystem::path& path)
+    {
+        return impl_->status(path);
+    }
+}
@@ -0,0 +1,42 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <string>
+#include <vector>
+
+namespace Yglob
+{
+    /**
+     * @brief Returns the number of bytes @a str has allocated on the
+     *      heap, which is zero for short strings that fit inside the
+     *      string object.
+     */
+    template <typename Alloc>
+    [[nodiscard]]
+    size_t get_heap_usage(
+        const std::basic_string<char, std::char_traits<char>, Alloc>& str)
+    {
+        auto begin = reinterpret_cast<const char*>(&str);
+        auto end = begin + sizeof(str);
+        if (begin <= str.data() && str.data() < end)
+            return 0;
+        return str.capacity() + 1;
+    }
+
+    /**
+     * @brief Returns the number of bytes @a vec has allocated on the
+     *      heap for its elements, not including what the elements have
+     *      allocated themselves.
+     */
+    template <typename T, typename Alloc>
+    [[nodiscard]]
+    size_t get_heap_usage(const std::vector<T, Alloc>& vec)
+    {
+        return vec.capacity() * sizeof(T);
+    }
+}
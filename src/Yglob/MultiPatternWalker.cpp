@@ -0,0 +1,245 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "MultiPatternWalker.hpp"
+
+#include <algorithm>
+#include <Ystring/Algorithms.hpp>
+#include "Yglob/YglobException.hpp"
+#include "FlagConversion.hpp"
+
+namespace Yglob
+{
+    namespace
+    {
+        std::filesystem::path from_string(std::string_view str)
+        {
+            return {std::u8string_view(reinterpret_cast<const char8_t*>(str.data()),
+                                       str.size())};
+        }
+
+        constexpr uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325u;
+        constexpr uint64_t FNV_PRIME = 0x100000001B3u;
+
+        /**
+         * @brief Adds a path component to @a hash with FNV-1a, the hash
+         *      must be the same in every process that shares a traversal.
+         */
+        uint64_t add_to_hash(uint64_t hash, std::string_view name)
+        {
+            for (auto c : name)
+                hash = (hash ^ uint8_t(c)) * FNV_PRIME;
+            return (hash ^ uint8_t('/')) * FNV_PRIME;
+        }
+    }
+
+    ShardSelector::ShardSelector(const Shard& shard)
+        : shard_(shard)
+    {
+        if (shard_.index >= shard_.count)
+            YGLOB_THROW("The shard index must be less than the shard count.");
+        if (shard_.depth == 0)
+            YGLOB_THROW("The shard depth must be at least 1.");
+    }
+
+    ShardState ShardSelector::start() const
+    {
+        return {0, FNV_OFFSET_BASIS, shard_.count == 1};
+    }
+
+    ShardState ShardSelector::get_state(const ShardState& dir,
+                                        const DirectoryReader& reader) const
+    {
+        if (dir.is_owned)
+            return dir;
+
+        ShardState result;
+        result.depth = dir.depth + (reader.is_lookup() ? 0 : 1);
+        result.hash = add_to_hash(dir.hash, reader.name());
+        result.is_owned = result.depth >= shard_.depth && is_in_shard(result);
+        return result;
+    }
+
+    bool ShardSelector::is_in_shard(const ShardState& state) const
+    {
+        return state.is_owned || state.hash % shard_.count == shard_.index;
+    }
+
+    bool ShardSelector::must_enter(const ShardState& state) const
+    {
+        return state.is_owned || state.depth < shard_.depth;
+    }
+
+    MultiPatternWalker::MultiPatternWalker(
+            const std::vector<std::filesystem::path>& glob_paths,
+            PathIteratorFlags flags,
+            std::shared_ptr<EntryFilter> filter,
+            std::shared_ptr<FileSystem> file_system,
+            const Shard& shard,
+            std::pmr::memory_resource* resource)
+        : flags_(flags),
+          options_(to_directory_options(flags)),
+          filter_(std::move(filter)),
+          file_system_(std::move(file_system)),
+          shards_(shard),
+          stack_(resource),
+          next_nodes_(resource)
+    {
+        const auto start = shards_.start();
+        for (size_t i = 0; i < glob_paths.size(); ++i)
+        {
+            trie_.add(glob_paths[i], to_glob_flags(flags),
+                      to_literal_flags(flags), i);
+        }
+
+        // The relative glob paths are walked first, then the absolute ones
+        // in the order their roots first appeared in.
+        for (auto it = trie_.roots().rbegin(); it != trie_.roots().rend(); ++it)
+        {
+            ComponentTrie::NodeList nodes(resource);
+            trie_.add_with_closure(it->second, nodes);
+            push_frame(from_string(it->first), nodes, start);
+        }
+
+        if (trie_.node(0).has_successors())
+        {
+            ComponentTrie::NodeList nodes(resource);
+            trie_.add_with_closure(0, nodes);
+            push_frame({}, nodes, start);
+        }
+    }
+
+    bool MultiPatternWalker::next()
+    {
+        while (!stack_.empty())
+        {
+            if (stop_condition_ && stop_condition_->is_stopped())
+            {
+                stack_.clear();
+                return false;
+            }
+
+            auto& frame = stack_.back();
+            auto& entry = frame.reader;
+            if (!entry.next())
+            {
+                stack_.pop_back();
+                continue;
+            }
+
+            trie_.advance(frame.nodes, entry.name(), next_nodes_);
+            if (next_nodes_.empty())
+                continue;
+
+            if (filter_ && filter_->is_excluded(entry))
+                continue;
+
+            pattern_indexes_.clear();
+            bool has_successors = false;
+            bool has_any_path = false;
+            for (auto index : next_nodes_)
+            {
+                const auto& node = trie_.node(index);
+                pattern_indexes_.insert(pattern_indexes_.end(),
+                                        node.patterns.begin(),
+                                        node.patterns.end());
+                has_successors = has_successors || node.has_successors();
+                has_any_path = has_any_path || node.is_any_path;
+            }
+
+            const auto shard = shards_.get_state(frame.shard, entry);
+            const auto is_directory = entry.is_directory();
+            const auto is_acceptable_entry = !pattern_indexes_.empty()
+                                             && shards_.is_in_shard(shard)
+                                             && is_acceptable(entry, is_directory);
+            // Like recursive_directory_iterator, `**` doesn't follow
+            // symbolic links to directories, which could lead to cycles.
+            if (is_acceptable_entry)
+                current_path_ = entry.path();
+            if (is_directory && has_successors
+                && !(has_any_path && entry.is_symlink())
+                && shards_.must_enter(shard))
+            {
+                push_frame(entry.path(), next_nodes_, shard);
+            }
+
+            if (is_acceptable_entry)
+            {
+                std::ranges::sort(pattern_indexes_);
+                pattern_indexes_.erase(std::unique(pattern_indexes_.begin(),
+                                                   pattern_indexes_.end()),
+                                       pattern_indexes_.end());
+                return true;
+            }
+        }
+        current_path_.clear();
+        pattern_indexes_.clear();
+        return false;
+    }
+
+    void MultiPatternWalker::push_frame(std::filesystem::path dir,
+                                        const ComponentTrie::NodeList& nodes,
+                                        const ShardState& shard)
+    {
+        auto readers = make_directory_readers(trie_, dir, nodes, options_,
+                                              file_system_.get());
+        for (auto it = readers.rbegin(); it != readers.rend(); ++it)
+        {
+            stack_.push_back({ComponentTrie::NodeList(nodes, stack_.get_allocator()),
+                              std::move(*it), shard});
+        }
+    }
+
+    bool MultiPatternWalker::is_acceptable(const DirectoryReader& entry,
+                                           bool is_directory) const
+    {
+        if (bool(flags_ & PathIteratorFlags::NO_DIRECTORIES) && is_directory)
+            return false;
+        if (bool(flags_ & PathIteratorFlags::NO_FILES) && entry.is_regular_file())
+        {
+            return false;
+        }
+        return true;
+    }
+
+    std::vector<DirectoryReader>
+    make_directory_readers(const ComponentTrie& trie,
+                           const std::filesystem::path& dir,
+                           const ComponentTrie::NodeList& nodes,
+                           std::filesystem::directory_options options,
+                           FileSystem* file_system)
+    {
+        const bool plain_names_only = std::ranges::all_of(nodes, [&](auto i)
+        {
+            return trie.node(i).has_only_plain_names();
+        });
+
+        std::vector<std::string> names;
+        for (auto i : nodes)
+        {
+            for (const auto& [name, _] : trie.node(i).literals)
+            {
+                if (plain_names_only || name == "..")
+                    names.push_back(name);
+            }
+        }
+        std::ranges::sort(names);
+        names.erase(std::unique(names.begin(), names.end()), names.end());
+
+        std::vector<DirectoryReader> result;
+        if (plain_names_only)
+        {
+            result.emplace_back(dir, std::move(names), file_system);
+            return result;
+        }
+
+        result.emplace_back(dir, options, file_system);
+        if (!names.empty())
+            result.emplace_back(dir, std::move(names), file_system);
+        return result;
+    }
+}
@@ -0,0 +1,180 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include "Yglob/Flags.hpp"
+#include "Yglob/PathIterator.hpp"
+#include "ComponentTrie.hpp"
+#include "DirectoryReader.hpp"
+#include "EntryFilter.hpp"
+#include "StopCondition.hpp"
+
+namespace Yglob
+{
+    /**
+     * @brief Where a directory is relative to the shards of a
+     *      traversal.
+     */
+    struct ShardState
+    {
+        /**
+         * @brief The number of directories above this one that have
+         *      been read, rather than looked up, since the start.
+         */
+        size_t depth = 0;
+        /**
+         * @brief The hash of the path from the start.
+         */
+        uint64_t hash = 0;
+        /**
+         * @brief True if the directory belongs to the current shard,
+         *      and everything below it does too.
+         */
+        bool is_owned = false;
+    };
+
+    /**
+     * @brief Decides which entries of a traversal belong to a Shard.
+     *
+     * The walkers that support shards share this, so a traversal is
+     * split the same way whether it is walked sequentially or in
+     * parallel.
+     */
+    class ShardSelector
+    {
+    public:
+        explicit ShardSelector(const Shard& shard);
+
+        /**
+         * @brief The state of the directories a traversal starts in.
+         */
+        [[nodiscard]]
+        ShardState start() const;
+
+        /**
+         * @brief Returns the shard state of the current entry in
+         *      @a reader, which reads a directory with state @a dir.
+         */
+        [[nodiscard]]
+        ShardState get_state(const ShardState& dir,
+                             const DirectoryReader& reader) const;
+
+        [[nodiscard]]
+        bool is_in_shard(const ShardState& state) const;
+
+        /**
+         * @brief True if a directory with @a state must be entered,
+         *      either because it belongs to the shard or because the
+         *      shard's directories can be below it.
+         */
+        [[nodiscard]]
+        bool must_enter(const ShardState& state) const;
+    private:
+        Shard shard_;
+    };
+
+    /**
+     * @brief Finds the paths that match any of several glob paths while
+     *      reading each directory at most once.
+     *
+     * The glob paths are stored in a ComponentTrie, and the walk keeps
+     * the trie nodes that are active in each directory. A directory is
+     * only entered if some node can advance further, and directories
+     * where the active nodes only have plain names as successors are not
+     * read at all, the names are looked up directly instead.
+     *
+     * The stack of directories and their node lists are allocated from
+     * the memory resource given to the constructor, the trie, the paths
+     * and the directory readers' buffers on the global heap.
+     */
+    class MultiPatternWalker
+    {
+    public:
+        MultiPatternWalker(const std::vector<std::filesystem::path>& glob_paths,
+                           PathIteratorFlags flags,
+                           std::shared_ptr<EntryFilter> filter,
+                           std::shared_ptr<FileSystem> file_system = {},
+                           const Shard& shard = {},
+                           std::pmr::memory_resource* resource
+                               = std::pmr::get_default_resource());
+
+        bool next();
+
+        void set_stop_condition(std::shared_ptr<StopCondition> condition)
+        {
+            stop_condition_ = std::move(condition);
+        }
+
+        [[nodiscard]]
+        const std::filesystem::path& path() const
+        {
+            return current_path_;
+        }
+
+        /**
+         * @brief The indexes of the glob paths that matched the current
+         *      path, in ascending order.
+         */
+        [[nodiscard]]
+        const std::vector<size_t>& pattern_indexes() const
+        {
+            return pattern_indexes_;
+        }
+    private:
+        struct Frame
+        {
+            ComponentTrie::NodeList nodes;
+            /**
+             * @brief Reads the directory, or looks up the names in it
+             *      directly if they are all known in advance.
+             */
+            DirectoryReader reader;
+            ShardState shard;
+        };
+
+        void push_frame(std::filesystem::path dir,
+                        const ComponentTrie::NodeList& nodes,
+                        const ShardState& shard);
+
+        [[nodiscard]]
+        bool is_acceptable(const DirectoryReader& entry,
+                           bool is_directory) const;
+
+        ComponentTrie trie_;
+        PathIteratorFlags flags_;
+        std::filesystem::directory_options options_;
+        std::shared_ptr<EntryFilter> filter_;
+        std::shared_ptr<FileSystem> file_system_;
+        ShardSelector shards_;
+        std::shared_ptr<StopCondition> stop_condition_;
+        std::pmr::vector<Frame> stack_;
+        ComponentTrie::NodeList next_nodes_;
+        std::filesystem::path current_path_;
+        std::vector<size_t> pattern_indexes_;
+    };
+
+    /**
+     * @brief Returns the readers for the entries in @a dir that can
+     *      advance @a nodes.
+     *
+     * If all the successors of the nodes are plain names, the names are
+     * looked up instead of reading the directory. Directory listings
+     * don't include "..", so it is always looked up, by the last reader.
+     */
+    [[nodiscard]]
+    std::vector<DirectoryReader>
+    make_directory_readers(const ComponentTrie& trie,
+                           const std::filesystem::path& dir,
+                           const ComponentTrie::NodeList& nodes,
+                           std::filesystem::directory_options options,
+                           FileSystem* file_system);
+}
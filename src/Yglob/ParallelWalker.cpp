@@ -0,0 +1,664 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParallelWalker.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include "ComponentTrie.hpp"
+#include "FlagConversion.hpp"
+#include "MultiPatternWalker.hpp"
+
+namespace Yglob
+{
+    using Match = ParallelWalker::Match;
+
+    namespace
+    {
+        std::filesystem::path from_string(std::string_view str)
+        {
+            return {std::u8string_view(reinterpret_cast<const char8_t*>(str.data()),
+                                       str.size())};
+        }
+
+        enum class TaskStatus
+        {
+            QUEUED,
+            RUNNING,
+            DONE
+        };
+
+        struct Task
+        {
+            explicit Task(std::shared_ptr<std::atomic<size_t>> task_count)
+                : task_count(std::move(task_count))
+            {
+                ++*this->task_count;
+            }
+
+            ~Task()
+            {
+                --*task_count;
+            }
+
+            Task(const Task&) = delete;
+
+            Task& operator=(const Task&) = delete;
+
+            /**
+             * @brief The walker's count of tasks, shared because tasks
+             *      that are waiting for a thread can outlive the walker.
+             */
+            std::shared_ptr<std::atomic<size_t>> task_count;
+            std::filesystem::path dir;
+            ComponentTrie::NodeList nodes;
+            ShardState shard;
+            TaskStatus status = TaskStatus::QUEUED;
+            // The results, only kept in ordered mode. The children are
+            // paired with the number of matches that precede them.
+            std::vector<Match> matches;
+            std::vector<std::pair<size_t, std::shared_ptr<Task>>> children;
+        };
+
+        /**
+         * @brief A matching entry or a subdirectory to walk, or both.
+         */
+        struct Entry
+        {
+            std::string name;
+            std::optional<Match> match;
+            std::shared_ptr<Task> child;
+        };
+    }
+
+    class ParallelWalker::ParallelWalkerImpl
+        : public std::enable_shared_from_this<ParallelWalkerImpl>
+    {
+    public:
+        ParallelWalkerImpl(const std::vector<std::filesystem::path>& glob_paths,
+                           PathIteratorFlags flags,
+                           std::shared_ptr<EntryFilter> filter,
+                           std::shared_ptr<FileSystem> file_system,
+                           const ParallelOptions& options,
+                           const Shard& shard)
+            : flags_(flags),
+              options_(to_directory_options(flags)),
+              filter_(std::move(filter)),
+              file_system_(std::move(file_system)),
+              shards_(shard),
+              queue_size_(std::max<size_t>(options.queue_size, 1)),
+              is_ordered_(options.ordered)
+        {
+            for (size_t i = 0; i < glob_paths.size(); ++i)
+            {
+                trie_.add(glob_paths[i], to_glob_flags(flags),
+                          to_literal_flags(flags), i);
+            }
+        }
+
+        void set_executor(std::function<void(std::function<void()>)> executor)
+        {
+            executor_ = std::move(executor);
+        }
+
+        void set_stop_condition(std::shared_ptr<StopCondition> condition)
+        {
+            stop_condition_ = std::move(condition);
+        }
+
+        /**
+         * @brief Creates the tasks for the roots of the glob paths and
+         *      hands them to the executor, unless that has been done
+         *      already.
+         */
+        void start()
+        {
+            std::call_once(is_started_, [this] {schedule_roots();});
+        }
+
+        void stop()
+        {
+            {
+                std::scoped_lock lock(mutex_);
+                is_stopped_ = true;
+            }
+            can_start_.notify_all();
+            has_results_.notify_all();
+        }
+
+        bool next()
+        {
+            start();
+            auto result = is_ordered_ ? next_ordered() : next_unordered();
+            if (!result)
+            {
+                current_ = {};
+                rethrow_error();
+            }
+            return result;
+        }
+
+        bool next_batch(std::vector<Match>& batch)
+        {
+            start();
+            if (take_batch(batch))
+                return true;
+            rethrow_error();
+            return false;
+        }
+
+        [[nodiscard]]
+        const Match& current() const
+        {
+            return current_;
+        }
+
+        [[nodiscard]]
+        size_t task_count() const
+        {
+            return *task_count_;
+        }
+    private:
+        struct Cursor
+        {
+            std::shared_ptr<Task> task;
+            size_t match = 0;
+            size_t child = 0;
+            size_t released = 0;
+        };
+
+        [[nodiscard]]
+        std::shared_ptr<Task> make_task() const
+        {
+            return std::make_shared<Task>(task_count_);
+        }
+
+        void schedule_roots()
+        {
+            // The relative glob paths are walked first, then the absolute
+            // ones in the order their roots first appeared in.
+            auto root = make_task();
+            root->status = TaskStatus::DONE;
+            if (trie_.node(0).has_successors())
+            {
+                auto task = make_task();
+                task->shard = shards_.start();
+                trie_.add_with_closure(0, task->nodes);
+                root->children.emplace_back(0, std::move(task));
+            }
+            for (const auto& [name, node] : trie_.roots())
+            {
+                auto task = make_task();
+                task->dir = from_string(name);
+                task->shard = shards_.start();
+                trie_.add_with_closure(node, task->nodes);
+                root->children.emplace_back(0, std::move(task));
+            }
+
+            if (is_ordered_)
+                cursors_.push_back({root});
+            for (const auto& [_, task] : root->children)
+                schedule(task);
+        }
+
+        [[nodiscard]]
+        bool is_condition_met() const
+        {
+            return stop_condition_ && stop_condition_->is_stopped();
+        }
+
+        /**
+         * @brief Waits until @a predicate is true, or the stop condition
+         *      becomes true, which stops the walk.
+         *
+         * The stop condition is polled because a deadline can pass
+         * while every thread is busy reading a directory.
+         */
+        template <typename Predicate>
+        void wait_for_results(std::unique_lock<std::mutex>& lock,
+                              Predicate predicate)
+        {
+            if (!stop_condition_)
+            {
+                has_results_.wait(lock, predicate);
+                return;
+            }
+
+            using namespace std::chrono_literals;
+            while (!has_results_.wait_for(lock, 10ms, predicate))
+            {
+                if (stop_condition_->is_stopped())
+                {
+                    is_stopped_ = true;
+                    can_start_.notify_all();
+                    has_results_.notify_all();
+                    return;
+                }
+            }
+        }
+
+        bool next_unordered()
+        {
+            while (batch_index_ == batch_.size())
+            {
+                if (!take_batch(batch_))
+                    return false;
+                batch_index_ = 0;
+            }
+            current_ = std::move(batch_[batch_index_++]);
+            return true;
+        }
+
+        bool take_batch(std::vector<Match>& batch)
+        {
+            std::unique_lock lock(mutex_);
+            wait_for_results(lock, [&]
+            {
+                return !batches_.empty() || active_tasks_ == 0 || is_stopped_;
+            });
+            if (batches_.empty() || is_stopped_)
+                return false;
+            batch = std::move(batches_.front());
+            batches_.pop_front();
+            release(batch.size());
+            return true;
+        }
+
+        void rethrow_error()
+        {
+            std::scoped_lock lock(mutex_);
+            if (error_)
+                std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+
+        bool next_ordered()
+        {
+            while (!cursors_.empty())
+            {
+                auto& cursor = cursors_.back();
+                auto& task = *cursor.task;
+                if (cursor.child < task.children.size()
+                    && task.children[cursor.child].first == cursor.match)
+                {
+                    // The child is only referenced by its cursor from
+                    // now on, so it and everything below it are released
+                    // as soon as the walk has passed it.
+                    auto child = std::move(task.children[cursor.child++].second);
+                    {
+                        std::scoped_lock lock(mutex_);
+                        release(cursor.match - cursor.released);
+                        cursor.released = cursor.match;
+                    }
+                    if (!wait_for(child))
+                        return false;
+                    cursors_.push_back({std::move(child)});
+                    continue;
+                }
+
+                if (cursor.match < task.matches.size())
+                {
+                    current_ = std::move(task.matches[cursor.match++]);
+                    return true;
+                }
+
+                {
+                    std::scoped_lock lock(mutex_);
+                    release(cursor.match - cursor.released);
+                }
+                task.matches = {};
+                task.children = {};
+                cursors_.pop_back();
+            }
+            return false;
+        }
+
+        /**
+         * @brief Waits until @a task is done, or runs it on this thread
+         *      if no other thread has started on it.
+         */
+        bool wait_for(const std::shared_ptr<Task>& task)
+        {
+            std::unique_lock lock(mutex_);
+            if (task->status == TaskStatus::QUEUED)
+            {
+                task->status = TaskStatus::RUNNING;
+                lock.unlock();
+                execute(task);
+                lock.lock();
+                // Wakes the thread that was going to run the task.
+                can_start_.notify_all();
+            }
+            wait_for_results(lock, [&]
+            {
+                return task->status == TaskStatus::DONE || is_stopped_;
+            });
+            return !is_stopped_;
+        }
+
+        /**
+         * @brief Makes room for more results. The caller must hold the
+         *      lock.
+         */
+        void release(size_t count)
+        {
+            if (count == 0)
+                return;
+            buffered_ -= count;
+            can_start_.notify_all();
+        }
+
+        void schedule(const std::shared_ptr<Task>& task)
+        {
+            {
+                std::scoped_lock lock(mutex_);
+                if (is_stopped_)
+                    return;
+                ++active_tasks_;
+            }
+
+            if (!is_ordered_)
+            {
+                executor_([self = shared_from_this(), task]
+                {
+                    self->run(task);
+                });
+                return;
+            }
+
+            // In ordered mode the tasks are owned by their parents. A task
+            // that has been released has been run by next() and passed,
+            // and mustn't be kept alive while it waits for a thread.
+            executor_([self = shared_from_this(), weak_task = std::weak_ptr(task)]
+            {
+                if (auto task = weak_task.lock())
+                {
+                    self->run(task);
+                    return;
+                }
+                std::scoped_lock lock(self->mutex_);
+                self->finish_task();
+            });
+        }
+
+        void run(const std::shared_ptr<Task>& task)
+        {
+            {
+                std::unique_lock lock(mutex_);
+                // In ordered mode, next() may have run the task already,
+                // and then there is no reason to wait for room.
+                can_start_.wait(lock, [&]
+                {
+                    return buffered_ < queue_size_ || is_stopped_
+                           || task->status != TaskStatus::QUEUED;
+                });
+                if (is_stopped_ || task->status != TaskStatus::QUEUED)
+                {
+                    finish_task();
+                    return;
+                }
+                task->status = TaskStatus::RUNNING;
+            }
+            execute(task);
+            std::scoped_lock lock(mutex_);
+            finish_task();
+        }
+
+        /**
+         * @brief Counts a task as done. The caller must hold the lock.
+         */
+        void finish_task()
+        {
+            if (--active_tasks_ == 0)
+                has_results_.notify_all();
+        }
+
+        void execute(const std::shared_ptr<Task>& task)
+        {
+            std::vector<Entry> entries;
+            try
+            {
+                read_directory(*task, entries);
+            }
+            catch (...)
+            {
+                std::scoped_lock lock(mutex_);
+                if (!error_)
+                    error_ = std::current_exception();
+                is_stopped_ = true;
+                task->status = TaskStatus::DONE;
+                can_start_.notify_all();
+                has_results_.notify_all();
+                return;
+            }
+
+            if (is_ordered_)
+                std::ranges::stable_sort(entries, {}, &Entry::name);
+
+            std::vector<Match> matches;
+            std::vector<std::pair<size_t, std::shared_ptr<Task>>> children;
+            for (auto& entry : entries)
+            {
+                if (entry.match)
+                    matches.push_back(std::move(*entry.match));
+                if (entry.child)
+                {
+                    if (is_ordered_)
+                        children.emplace_back(matches.size(), entry.child);
+                    schedule(entry.child);
+                }
+            }
+
+            std::scoped_lock lock(mutex_);
+            buffered_ += matches.size();
+            if (is_ordered_)
+            {
+                task->matches = std::move(matches);
+                task->children = std::move(children);
+            }
+            else if (!matches.empty())
+            {
+                batches_.push_back(std::move(matches));
+            }
+            task->status = TaskStatus::DONE;
+            has_results_.notify_all();
+        }
+
+        void read_directory(const Task& task, std::vector<Entry>& entries)
+        {
+            auto readers = make_directory_readers(trie_, task.dir, task.nodes,
+                                                  options_, file_system_.get());
+            ComponentTrie::NodeList next_nodes;
+            for (auto& reader : readers)
+            {
+                while (reader.next())
+                {
+                    if (is_condition_met())
+                    {
+                        stop();
+                        return;
+                    }
+
+                    trie_.advance(task.nodes, reader.name(), next_nodes);
+                    if (next_nodes.empty())
+                        continue;
+
+                    if (filter_)
+                    {
+                        std::scoped_lock lock(filter_mutex_);
+                        if (filter_->is_excluded(reader))
+                            continue;
+                    }
+
+                    Entry entry;
+                    if (is_ordered_)
+                        entry.name = reader.name();
+                    add_entry(reader, next_nodes,
+                              shards_.get_state(task.shard, reader), entry);
+                    if (entry.match || entry.child)
+                        entries.push_back(std::move(entry));
+                }
+            }
+        }
+
+        void add_entry(const DirectoryReader& reader,
+                       const ComponentTrie::NodeList& nodes,
+                       const ShardState& shard,
+                       Entry& entry) const
+        {
+            std::vector<size_t> pattern_indexes;
+            bool has_successors = false;
+            bool has_any_path = false;
+            for (auto index : nodes)
+            {
+                const auto& node = trie_.node(index);
+                pattern_indexes.insert(pattern_indexes.end(),
+                                       node.patterns.begin(),
+                                       node.patterns.end());
+                has_successors = has_successors || node.has_successors();
+                has_any_path = has_any_path || node.is_any_path;
+            }
+
+            const auto is_directory = reader.is_directory();
+            if (!pattern_indexes.empty() && shards_.is_in_shard(shard)
+                && is_acceptable(reader, is_directory))
+            {
+                std::ranges::sort(pattern_indexes);
+                pattern_indexes.erase(std::unique(pattern_indexes.begin(),
+                                                  pattern_indexes.end()),
+                                      pattern_indexes.end());
+                entry.match = Match{reader.path(), std::move(pattern_indexes)};
+            }
+
+            // Like recursive_directory_iterator, `**` doesn't follow
+            // symbolic links to directories, which could lead to cycles.
+            if (is_directory && has_successors
+                && !(has_any_path && reader.is_symlink())
+                && shards_.must_enter(shard))
+            {
+                entry.child = make_task();
+                entry.child->dir = reader.path();
+                entry.child->nodes = nodes;
+                entry.child->shard = shard;
+            }
+        }
+
+        [[nodiscard]]
+        bool is_acceptable(const DirectoryReader& entry,
+                           bool is_directory) const
+        {
+            if (bool(flags_ & PathIteratorFlags::NO_DIRECTORIES) && is_directory)
+                return false;
+            if (bool(flags_ & PathIteratorFlags::NO_FILES) && entry.is_regular_file())
+                return false;
+            return true;
+        }
+
+        ComponentTrie trie_;
+        PathIteratorFlags flags_;
+        std::filesystem::directory_options options_;
+        std::shared_ptr<EntryFilter> filter_;
+        std::mutex filter_mutex_;
+        std::shared_ptr<FileSystem> file_system_;
+        ShardSelector shards_;
+        std::function<void(std::function<void()>)> executor_;
+        std::shared_ptr<StopCondition> stop_condition_;
+        std::once_flag is_started_;
+        size_t queue_size_;
+        bool is_ordered_;
+        std::shared_ptr<std::atomic<size_t>> task_count_
+            = std::make_shared<std::atomic<size_t>>(0);
+
+        std::mutex mutex_;
+        std::condition_variable can_start_;
+        std::condition_variable has_results_;
+        size_t buffered_ = 0;
+        size_t active_tasks_ = 0;
+        bool is_stopped_ = false;
+        std::exception_ptr error_;
+        std::deque<std::vector<Match>> batches_;
+
+        // Only used by the thread that calls next().
+        std::vector<Match> batch_;
+        size_t batch_index_ = 0;
+        std::vector<Cursor> cursors_;
+        Match current_;
+    };
+
+    ParallelWalker::ParallelWalker(
+            const std::vector<std::filesystem::path>& glob_paths,
+            PathIteratorFlags flags,
+            std::shared_ptr<EntryFilter> filter,
+            std::shared_ptr<FileSystem> file_system,
+            const ParallelOptions& options,
+            const Shard& shard)
+        : impl_(std::make_shared<ParallelWalkerImpl>(glob_paths, flags,
+                                                     std::move(filter),
+                                                     std::move(file_system),
+                                                     options, shard))
+    {
+        if (options.executor)
+        {
+            impl_->set_executor(options.executor);
+            return;
+        }
+
+        auto thread_count = options.thread_count;
+        if (thread_count == 0)
+            thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+        pool_ = std::make_unique<WorkStealingPool>(thread_count);
+        impl_->set_executor([pool = pool_.get()](std::function<void()> task)
+        {
+            pool->submit(std::move(task));
+        });
+    }
+
+    ParallelWalker::~ParallelWalker()
+    {
+        impl_->stop();
+    }
+
+    void ParallelWalker::set_stop_condition(std::shared_ptr<StopCondition> condition)
+    {
+        impl_->set_stop_condition(std::move(condition));
+    }
+
+    bool ParallelWalker::next()
+    {
+        return impl_->next();
+    }
+
+    bool ParallelWalker::next_batch(std::vector<Match>& batch)
+    {
+        return impl_->next_batch(batch);
+    }
+
+    void ParallelWalker::stop()
+    {
+        impl_->stop();
+    }
+
+    const std::filesystem::path& ParallelWalker::path() const
+    {
+        return impl_->current().path;
+    }
+
+    const std::vector<size_t>& ParallelWalker::pattern_indexes() const
+    {
+        return impl_->current().pattern_indexes;
+    }
+
+    size_t ParallelWalker::task_count() const
+    {
+        return impl_->task_count();
+    }
+}
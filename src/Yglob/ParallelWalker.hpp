@@ -0,0 +1,117 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <memory>
+#include <vector>
+#include "Yglob/PathIterator.hpp"
+#include "EntryFilter.hpp"
+#include "StopCondition.hpp"
+#include "WorkStealingPool.hpp"
+
+namespace Yglob
+{
+    /**
+     * @brief Finds the paths that match any of several glob paths, like
+     *      MultiPatternWalker, but reads the directories on several
+     *      threads.
+     *
+     * Each directory is a task that reads the directory, matches its
+     * entries and adds a task for each subdirectory that can contain
+     * matches. The tasks run on a WorkStealingPool or on the executor
+     * given in the ParallelOptions, and next() takes the matches from a
+     * shared buffer.
+     *
+     * Threads stop starting new directories while the buffer holds more
+     * than ParallelOptions::queue_size paths. In ordered mode next()
+     * reads the directory it needs itself if no thread has started on
+     * it, so a full buffer can't stall the walk. The directories it has
+     * finished are released along with their matches.
+     *
+     * A Shard is split with the same ShardSelector as in
+     * MultiPatternWalker, so the shards of a parallel walk are the same
+     * as those of a sequential one.
+     */
+    class ParallelWalker
+    {
+    public:
+        struct Match
+        {
+            std::filesystem::path path;
+            std::vector<size_t> pattern_indexes;
+        };
+
+        ParallelWalker(const std::vector<std::filesystem::path>& glob_paths,
+                       PathIteratorFlags flags,
+                       std::shared_ptr<EntryFilter> filter,
+                       std::shared_ptr<FileSystem> file_system,
+                       const ParallelOptions& options,
+                       const Shard& shard = {});
+
+        ~ParallelWalker();
+
+        ParallelWalker(const ParallelWalker&) = delete;
+
+        ParallelWalker& operator=(const ParallelWalker&) = delete;
+
+        /**
+         * @brief Makes the walker stop when @a condition becomes true.
+         *
+         * Must be called before the first call to next() or
+         * next_batch(), the directories aren't read until then.
+         */
+        void set_stop_condition(std::shared_ptr<StopCondition> condition);
+
+        bool next();
+
+        /**
+         * @brief Replaces @a batch with the matches from one of the
+         *      directories that have been read, waiting if necessary.
+         *
+         * Unlike next(), this function can be called from several
+         * threads at once, but the two can't be mixed and it must not be
+         * used in ordered mode. Returns false when there are no more
+         * matches, or when the walker has been stopped.
+         */
+        bool next_batch(std::vector<Match>& batch);
+
+        /**
+         * @brief Stops the reading of directories and wakes the threads
+         *      that wait in next_batch().
+         *
+         * Can be called from any thread.
+         */
+        void stop();
+
+        [[nodiscard]]
+        const std::filesystem::path& path() const;
+
+        /**
+         * @brief The indexes of the glob paths that matched the current
+         *      path, in ascending order.
+         */
+        [[nodiscard]]
+        const std::vector<size_t>& pattern_indexes() const;
+
+        /**
+         * @brief Returns the number of directory tasks in memory,
+         *      including those that have been read but not yet produced.
+         *
+         * In ordered mode, the tasks the walk has passed are released,
+         * so the number depends on the width of the tree and
+         * ParallelOptions::queue_size rather than its size.
+         */
+        [[nodiscard]]
+        size_t task_count() const;
+    private:
+        class ParallelWalkerImpl;
+        std::shared_ptr<ParallelWalkerImpl> impl_;
+        // Declared after impl_ so that the threads are stopped first.
+        std::unique_ptr<WorkStealingPool> pool_;
+    };
+}
@@ -7,6 +7,7 @@
 //****************************************************************************
 #include "ParseGlobPattern.hpp"
 
+#include <algorithm>
 #include <ranges>
 #include <Ystring/Algorithms.hpp>
 #include <Ystring/Unescape.hpp>
@@ -14,12 +15,30 @@
 
 namespace Yglob
 {
+    namespace
+    {
+        bool is_ext_glob_start(std::string_view pattern,
+                               const GlobParserOptions& options)
+        {
+            if (!options.support_ext_globs || pattern.size() < 2
+                || pattern[1] != '(')
+            {
+                return false;
+            }
+            return std::string_view("@?*+!").find(pattern[0])
+                   != std::string_view::npos;
+        }
+    }
+
     TokenType next_token_type(std::string_view pattern,
                               const GlobParserOptions& options)
     {
         if (pattern.empty())
             return TokenType::NONE;
 
+        if (is_ext_glob_start(pattern, options))
+            return TokenType::OPEN_EXT_GLOB;
+
         switch (pattern[0])
         {
         case '?':
@@ -45,6 +64,14 @@ namespace Yglob
             if (pattern[0] == ',')
                 return TokenType::COMMA;
         }
+
+        if (options.is_ext_glob_subpattern)
+        {
+            if (pattern[0] == ')')
+                return TokenType::END_PARENTHESIS;
+            if (pattern[0] == '|')
+                return TokenType::BAR;
+        }
         return TokenType::CHAR;
     }
 
@@ -104,23 +131,29 @@ namespace Yglob
         YGLOB_THROW("Unmatched '[' in glob pattern.");
     }
 
-    std::string extract_string(std::string_view& pattern,
-                               const GlobParserOptions& options)
+    std::pmr::string extract_string(std::string_view& pattern,
+                                    const GlobParserOptions& options,
+                                    std::pmr::memory_resource* resource)
     {
-        std::string result;
+        std::pmr::string result(resource);
         while (!pattern.empty())
         {
             if (pattern[0] == '\\')
             {
-                auto ch = ystring::unescape_next(pattern);
-                ystring::append(result, ch.value());
+                // A single encoded codepoint fits in the string object.
+                std::string encoded;
+                ystring::append(encoded, ystring::unescape_next(pattern).value());
+                result += encoded;
             }
             else if (pattern[0] == '?'
                      || pattern[0] == '*'
                      || (options.support_sets && pattern[0] == '[')
                      || (options.support_braces && pattern[0] == '{')
                      || (options.is_subpattern
-                         && (pattern[0] == '}' || pattern[0] == ',')))
+                         && (pattern[0] == '}' || pattern[0] == ','))
+                     || (options.is_ext_glob_subpattern
+                         && (pattern[0] == ')' || pattern[0] == '|'))
+                     || is_ext_glob_start(pattern, options))
             {
                 break;
             }
@@ -133,19 +166,23 @@ namespace Yglob
         return result;
     }
 
-    StarElement extract_stars(std::string_view& pattern)
+    StarElement extract_stars(std::string_view& pattern,
+                              const GlobParserOptions& options)
     {
-        while (!pattern.empty() && pattern[0] == '*')
+        while (!pattern.empty() && pattern[0] == '*'
+               && !is_ext_glob_start(pattern, options))
         {
             pattern.remove_prefix(1);
         }
         return {};
     }
 
-    QmarkElement extract_qmarks(std::string_view& pattern)
+    QmarkElement extract_qmarks(std::string_view& pattern,
+                                const GlobParserOptions& options)
     {
         QmarkElement result;
-        while (!pattern.empty() && pattern[0] == '?')
+        while (!pattern.empty() && pattern[0] == '?'
+               && !is_ext_glob_start(pattern, options))
         {
             result.length++;
             pattern.remove_prefix(1);
@@ -156,9 +193,11 @@ namespace Yglob
     // NOLINTBEGIN(misc-no-recursion)
 
     MultiGlob extract_multi_glob(std::string_view& pattern,
-                                 GlobParserOptions options)
+                                 GlobParserOptions options,
+                                 std::pmr::memory_resource* resource)
     {
         options.is_subpattern = true;
+        options.is_ext_glob_subpattern = false;
 
         MultiGlob result;
         while (!pattern.empty())
@@ -168,7 +207,8 @@ namespace Yglob
             case TokenType::OPEN_BRACE:
             case TokenType::COMMA:
                 pattern.remove_prefix(1);
-                result.patterns.push_back(parse_glob_pattern(pattern, options));
+                result.patterns.push_back(parse_glob_pattern(pattern, options,
+                                                             resource));
                 break;
             case TokenType::END_BRACE:
                 if (result.patterns.empty())
@@ -183,12 +223,78 @@ namespace Yglob
         YGLOB_THROW("Unmatched '{' in glob pattern.");
     }
 
+    ExtGlob extract_ext_glob(std::string_view& pattern,
+                             GlobParserOptions options,
+                             std::pmr::memory_resource* resource)
+    {
+        options.is_subpattern = false;
+        options.is_ext_glob_subpattern = true;
+
+        ExtGlob result;
+        switch (pattern[0])
+        {
+        case '?':
+            result.kind = ExtGlobKind::ZERO_OR_ONE;
+            break;
+        case '*':
+            result.kind = ExtGlobKind::ZERO_OR_MORE;
+            break;
+        case '+':
+            result.kind = ExtGlobKind::ONE_OR_MORE;
+            break;
+        case '!':
+            result.kind = ExtGlobKind::NONE_OF;
+            break;
+        default:
+            result.kind = ExtGlobKind::ONE;
+            break;
+        }
+
+        // Remove the operator and '('.
+        pattern.remove_prefix(2);
+        while (true)
+        {
+            result.alternatives.patterns.push_back(
+                parse_glob_pattern(pattern, options, resource));
+            switch (next_token_type(pattern, options))
+            {
+            case TokenType::BAR:
+                pattern.remove_prefix(1);
+                break;
+            case TokenType::END_PARENTHESIS:
+                pattern.remove_prefix(1);
+                return result;
+            default:
+                YGLOB_THROW("Unmatched '(' in glob pattern.");
+            }
+        }
+    }
+
     [[nodiscard]]
-    bool has_star(const std::vector<GlobElement>& parts);
+    bool has_ext_glob(const GlobElements& pattern)
+    {
+        return std::ranges::any_of(pattern.parts, [](auto& part)
+        {
+            if (std::holds_alternative<ExtGlob>(part))
+                return true;
+            if (const auto multi_pattern = std::get_if<MultiGlob>(&part))
+            {
+                return std::ranges::any_of(multi_pattern->patterns,
+                                           [](auto& p) {return has_ext_glob(*p);});
+            }
+            return false;
+        });
+    }
+
+    [[nodiscard]]
+    bool has_star(const std::pmr::vector<GlobElement>& parts);
 
     [[nodiscard]]
     bool has_star(const GlobElement& part)
     {
+        // Extended globs can match strings of different lengths.
+        if (std::holds_alternative<ExtGlob>(part))
+            return true;
         if (const auto multi_pattern = std::get_if<MultiGlob>(&part))
         {
             for (const auto& pattern: multi_pattern->patterns)
@@ -201,7 +307,7 @@ namespace Yglob
     }
 
     [[nodiscard]]
-    bool has_star(const std::vector<GlobElement>& parts)
+    bool has_star(const std::pmr::vector<GlobElement>& parts)
     {
         return std::ranges::any_of(parts, [](auto& p) {return has_star(p);});
     }
@@ -219,45 +325,61 @@ namespace Yglob
 
     std::unique_ptr<GlobElements>
     parse_glob_pattern(std::string_view& pattern,
-                       const GlobParserOptions& options)
+                       const GlobParserOptions& options,
+                       std::pmr::memory_resource* resource)
     {
-        auto result = std::make_unique<GlobElements>();
+        auto result = std::make_unique<GlobElements>(resource);
+        parse_glob_pattern(pattern, options, *result);
+        return result;
+    }
 
+    void parse_glob_pattern(std::string_view& pattern,
+                            const GlobParserOptions& options,
+                            GlobElements& result)
+    {
+        auto* resource = result.parts.get_allocator().resource();
         bool done = false;
         while (!done)
         {
             switch (next_token_type(pattern, options))
             {
             case TokenType::CHAR:
-                result->parts.emplace_back(extract_string(pattern, options));
+                result.parts.emplace_back(extract_string(pattern, options,
+                                                         resource));
                 break;
             case TokenType::QUESTION_MARK:
-                result->parts.emplace_back(extract_qmarks(pattern));
+                result.parts.emplace_back(extract_qmarks(pattern, options));
                 break;
             case TokenType::STAR:
-                result->parts.emplace_back(extract_stars(pattern));
+                result.parts.emplace_back(extract_stars(pattern, options));
                 break;
             case TokenType::OPEN_BRACKET:
-                result->parts.emplace_back(extract_char_set(pattern));
+                result.parts.emplace_back(extract_char_set(pattern));
                 break;
             case TokenType::OPEN_BRACE:
-                result->parts.emplace_back(extract_multi_glob(pattern,
-                                                              options));
+                result.parts.emplace_back(extract_multi_glob(pattern,
+                                                             options,
+                                                             resource));
+                break;
+            case TokenType::OPEN_EXT_GLOB:
+                result.parts.emplace_back(extract_ext_glob(pattern,
+                                                           options,
+                                                           resource));
                 break;
             case TokenType::COMMA:
             case TokenType::END_BRACE:
+            case TokenType::BAR:
+            case TokenType::END_PARENTHESIS:
             default:
-                if (result->parts.empty())
-                    result->parts.emplace_back(EmptyElement());
+                if (result.parts.empty())
+                    result.parts.emplace_back(EmptyElement());
                 done = true;
                 break;
             }
         }
 
         if (!options.is_subpattern)
-            optimize(*result);
-
-        return result;
+            optimize(result);
     }
 
     // NOLINTEND(misc-no-recursion)
@@ -15,11 +15,27 @@ namespace Yglob
         bool support_braces = true;
         bool support_sets = true;
         bool is_subpattern = false;
+        bool support_ext_globs = false;
+        /**
+         * @brief True while parsing the alternatives in an extended
+         *      glob, where '|' and ')' end the alternative.
+         */
+        bool is_ext_glob_subpattern = false;
     };
 
     std::unique_ptr<GlobElements>
     parse_glob_pattern(std::string_view& pattern,
-                       const GlobParserOptions& options);
+                       const GlobParserOptions& options,
+                       std::pmr::memory_resource* resource
+                           = std::pmr::get_default_resource());
+
+    /**
+     * @brief Parses @a pattern into @a result, whose parts must be
+     *      empty, allocating the parts from @a result's memory resource.
+     */
+    void parse_glob_pattern(std::string_view& pattern,
+                            const GlobParserOptions& options,
+                            GlobElements& result);
 
     enum class TokenType
     {
@@ -30,7 +46,10 @@ namespace Yglob
         OPEN_BRACKET,
         OPEN_BRACE,
         COMMA,
-        END_BRACE
+        END_BRACE,
+        OPEN_EXT_GLOB,
+        BAR,
+        END_PARENTHESIS
     };
 
     TokenType next_token_type(std::string_view pattern,
@@ -38,13 +57,30 @@ namespace Yglob
 
     ystring::CodepointSet extract_char_set(std::string_view& pattern);
 
-    std::string extract_string(std::string_view& pattern,
-                               const GlobParserOptions& options);
+    std::pmr::string extract_string(std::string_view& pattern,
+                                    const GlobParserOptions& options,
+                                    std::pmr::memory_resource* resource
+                                        = std::pmr::get_default_resource());
 
-    StarElement extract_stars(std::string_view& pattern);
+    StarElement extract_stars(std::string_view& pattern,
+                              const GlobParserOptions& options = {});
 
-    QmarkElement extract_qmarks(std::string_view& pattern);
+    QmarkElement extract_qmarks(std::string_view& pattern,
+                                const GlobParserOptions& options = {});
 
     MultiGlob extract_multi_glob(std::string_view& pattern,
-                                 GlobParserOptions options);
+                                 GlobParserOptions options,
+                                 std::pmr::memory_resource* resource
+                                     = std::pmr::get_default_resource());
+
+    ExtGlob extract_ext_glob(std::string_view& pattern,
+                             GlobParserOptions options,
+                             std::pmr::memory_resource* resource
+                                 = std::pmr::get_default_resource());
+
+    /**
+     * @brief Returns true if @a pattern contains extended globs.
+     */
+    [[nodiscard]]
+    bool has_ext_glob(const GlobElements& pattern);
 }
@@ -0,0 +1,261 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "PathAutomaton.hpp"
+
+#include <algorithm>
+#include <Ystring/Algorithms.hpp>
+#include "MemoryUsage.hpp"
+#include "PathComponents.hpp"
+
+namespace Yglob
+{
+    namespace
+    {
+        LiteralElement make_literal(std::string_view name, bool case_sensitive,
+                                    std::pmr::memory_resource* resource)
+        {
+            if (!case_sensitive && is_ascii(name))
+                return {std::pmr::string(fold_ascii(name), resource), true};
+            return {std::pmr::string(name, resource), false};
+        }
+
+        bool has_cased_letters(std::string_view str)
+        {
+            return !is_ascii(str)
+                   || std::ranges::any_of(str, [](char ch)
+                      {
+                          return ('A' <= ch && ch <= 'Z')
+                                 || ('a' <= ch && ch <= 'z');
+                      });
+        }
+
+        bool equal(std::string_view str, const LiteralElement& literal,
+                   bool case_sensitive)
+        {
+            if (literal.folded)
+                return equal_folded_ascii(str, literal.name);
+            return case_sensitive
+                   ? str == literal.name
+                   : ystring::case_insensitive::equal(str, literal.name);
+        }
+    }
+
+    PathPattern split_path_pattern(const std::filesystem::path& pattern)
+    {
+        PathPattern result;
+        auto normal_pattern = pattern.lexically_normal();
+        result.root = std::string(ystring::to_string_view(
+            normal_pattern.root_path().generic_u8string()));
+
+        for (const auto& part : normal_pattern.relative_path())
+        {
+            auto name_u8 = part.generic_u8string();
+            auto name = ystring::to_string_view(name_u8);
+            if (name.empty() || name == ".")
+                continue;
+            // Consecutive `**` are equivalent to a single one.
+            if (name == "**" && !result.names.empty()
+                && result.names.back() == "**")
+            {
+                continue;
+            }
+            result.names.emplace_back(name);
+        }
+        return result;
+    }
+
+    PathElement make_path_element(std::string_view name, GlobFlags flags,
+                                  std::pmr::memory_resource* resource)
+    {
+        if (name == "**")
+            return AnyPath{};
+        if (is_glob_pattern(name, flags))
+        {
+            // Glob components on the default resource are shared with
+            // other matchers.
+            if (resource == std::pmr::get_default_resource())
+                return GlobMatcher(name, flags);
+            return GlobMatcher(name, flags, resource);
+        }
+        return make_literal(name, bool(flags & GlobFlags::CASE_SENSITIVE),
+                            resource);
+    }
+
+    PathAutomaton::PathAutomaton(const std::filesystem::path& pattern,
+                                 GlobFlags flags,
+                                 std::pmr::memory_resource* resource)
+        : elements_(resource),
+          case_sensitive_(bool(flags & GlobFlags::CASE_SENSITIVE))
+    {
+        auto [root, names] = split_path_pattern(pattern);
+        root_ = std::move(root);
+        elements_.reserve(names.size());
+        for (const auto& name : names)
+            elements_.push_back(make_path_element(name, flags, resource));
+    }
+
+    size_t PathAutomaton::memory_usage() const
+    {
+        auto result = sizeof(PathAutomaton) + get_heap_usage(root_)
+                      + get_heap_usage(elements_);
+        for (const auto& element : elements_)
+        {
+            if (const auto* literal = std::get_if<LiteralElement>(&element))
+                result += get_heap_usage(literal->name);
+            else if (const auto* glob = std::get_if<GlobMatcher>(&element))
+                result += glob->memory_usage() - sizeof(GlobMatcher);
+        }
+        return result;
+    }
+
+    StateSet PathAutomaton::start(std::string_view root) const
+    {
+        StateSet result(elements_.size() + 1, resource());
+        if (!root_.empty())
+        {
+            if (!is_same_root(root, root_, case_sensitive_))
+                return result;
+        }
+        else if (!root.empty() && !is_any_path(0))
+        {
+            // Relative patterns only match absolute paths if they
+            // start with `**`.
+            return result;
+        }
+
+        add_state(result, 0);
+        return result;
+    }
+
+    void PathAutomaton::advance(const StateSet& from,
+                                std::string_view component,
+                                StateSet& to) const
+    {
+        if (to.size() != from.size())
+            to = StateSet(from.size(), to.get_allocator());
+        else
+            to.clear();
+
+        const auto n = elements_.size();
+        for (auto i = from.find_next(0); i < n; i = from.find_next(i + 1))
+        {
+            if (is_any_path(i))
+                add_state(to, i);
+            else if (match(elements_[i], component))
+                add_state(to, i + 1);
+        }
+    }
+
+    bool PathAutomaton::match(const PathElement& element,
+                              std::string_view name) const
+    {
+        if (const auto* literal = std::get_if<LiteralElement>(&element))
+            return equal(name, *literal, case_sensitive_);
+        return std::get<GlobMatcher>(element).match(name);
+    }
+
+    void PathAutomaton::add_state(StateSet& states, size_t i) const
+    {
+        states.set(i);
+        while (is_any_path(i))
+            states.set(++i);
+    }
+
+    bool PathAutomaton::is_subset_of(const PathAutomaton& other) const
+    {
+        // A relative pattern that starts with `**` also matches absolute
+        // paths, which other must then match too. Both automatons start
+        // in the same states for those paths as for relative ones, so
+        // the exploration below covers them as well.
+        if (can_match_any_root() && !other.can_match_any_root())
+            return false;
+
+        // Explores pairs of a state in this automaton and the states
+        // other is guaranteed to be in at the same point.
+        const auto n = elements_.size();
+        std::vector<std::vector<StateSet>> visited(n + 1);
+        std::vector<std::pair<size_t, StateSet>> stack;
+
+        auto push = [&](size_t i, const StateSet& states)
+        {
+            for (auto j = i; ; ++j)
+            {
+                if (std::ranges::find(visited[j], states) == visited[j].end())
+                {
+                    visited[j].push_back(states);
+                    stack.emplace_back(j, states);
+                }
+                if (!is_any_path(j))
+                    break;
+            }
+        };
+
+        push(0, other.start(root_));
+        StateSet next;
+        while (!stack.empty())
+        {
+            auto [i, states] = std::move(stack.back());
+            stack.pop_back();
+            if (i == n)
+            {
+                if (!other.is_match(states))
+                    return false;
+                continue;
+            }
+
+            other.advance(states, elements_[i], case_sensitive_, next);
+            push(is_any_path(i) ? i : i + 1, next);
+        }
+        return true;
+    }
+
+    void PathAutomaton::advance(const StateSet& from,
+                                const PathElement& element,
+                                bool case_sensitive,
+                                StateSet& to) const
+    {
+        to = StateSet(from.size());
+        const auto n = elements_.size();
+        for (auto i = from.find_next(0); i < n; i = from.find_next(i + 1))
+        {
+            if (is_any_path(i))
+                add_state(to, i);
+            else if (is_subset(element, case_sensitive, elements_[i]))
+                add_state(to, i + 1);
+        }
+    }
+
+    bool PathAutomaton::is_subset(const PathElement& element,
+                                  bool case_sensitive,
+                                  const PathElement& other) const
+    {
+        if (const auto* literal = std::get_if<LiteralElement>(&element))
+        {
+            // A case-insensitive name matches all its variants, which
+            // other only matches if it is also case-insensitive.
+            if (!case_sensitive && case_sensitive_
+                && has_cased_letters(literal->name))
+            {
+                return false;
+            }
+            return match(other, literal->name);
+        }
+
+        const auto* other_glob = std::get_if<GlobMatcher>(&other);
+        if (!other_glob)
+            return false;
+
+        if (const auto* glob = std::get_if<GlobMatcher>(&element))
+            return Yglob::is_subset(*glob, *other_glob);
+
+        // element is `**` which consumes any name.
+        GlobMatcher any_name("*", case_sensitive ? GlobFlags::CASE_SENSITIVE
+                                                 : GlobFlags::DEFAULT);
+        return Yglob::is_subset(any_name, *other_glob);
+    }
+}
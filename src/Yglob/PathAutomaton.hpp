@@ -0,0 +1,220 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <memory_resource>
+#include <string>
+#include <variant>
+#include <vector>
+#include "Yglob/GlobMatcher.hpp"
+#include "StateSet.hpp"
+
+namespace Yglob
+{
+    struct AnyPath
+    {};
+
+    struct LiteralElement
+    {
+        /**
+         * @brief The name, converted to lower case if it only consists
+         *      of ASCII characters and the match is case-insensitive.
+         */
+        std::pmr::string name;
+        bool folded = false;
+    };
+
+    using PathElement = std::variant<LiteralElement, AnyPath, GlobMatcher>;
+
+    struct PathPattern
+    {
+        /**
+         * @brief The root of an absolute pattern, e.g. "/" or "C:/".
+         */
+        std::string root;
+        /**
+         * @brief The directory and file names, consecutive `**` are
+         *      replaced by a single one.
+         */
+        std::vector<std::string> names;
+    };
+
+    /**
+     * @brief Normalizes @a pattern and splits it into its root and
+     *      component names.
+     */
+    [[nodiscard]]
+    PathPattern split_path_pattern(const std::filesystem::path& pattern);
+
+    /**
+     * @brief Returns the element for the component @a name.
+     *
+     * Literal names and glob patterns are allocated from @a resource.
+     */
+    [[nodiscard]]
+    PathElement make_path_element(std::string_view name, GlobFlags flags,
+                                  std::pmr::memory_resource* resource
+                                      = std::pmr::get_default_resource());
+
+    /**
+     * @brief A non-deterministic finite automaton where each transition
+     *      consumes a complete path component.
+     *
+     * State i means that element i is the next one to be matched, and
+     * state N, where N is the number of elements, is the accepting state.
+     * A `**` element is a state with a transition to itself for every
+     * component and an empty transition to the following state.
+     *
+     * The elements, and the state sets returned by start() and
+     * advance(), are allocated from the memory resource given to the
+     * constructor. The root, and the temporary names used while the
+     * pattern is split, are allocated on the global heap.
+     */
+    class PathAutomaton
+    {
+    public:
+        PathAutomaton() = default;
+
+        PathAutomaton(const std::filesystem::path& pattern, GlobFlags flags,
+                      std::pmr::memory_resource* resource
+                          = std::pmr::get_default_resource());
+
+        /**
+         * @brief Returns the initial states for a path with the given
+         *      root, which is empty for relative paths.
+         *
+         * The returned set is empty if the pattern can't match paths with
+         * @a root.
+         */
+        [[nodiscard]]
+        StateSet start(std::string_view root) const;
+
+        /**
+         * @brief Assigns the states reached from @a from by consuming
+         *      @a component to @a to.
+         *
+         * @a to keeps its allocator.
+         */
+        void advance(const StateSet& from, std::string_view component,
+                     StateSet& to) const;
+
+        [[nodiscard]]
+        bool is_match(const StateSet& states) const
+        {
+            return states.test(elements_.size());
+        }
+
+        /**
+         * @brief Returns true if @a states can reach the accepting state
+         *      by consuming at least one more component.
+         */
+        [[nodiscard]]
+        bool can_match_more(const StateSet& states) const
+        {
+            return states.find_next(0) < elements_.size();
+        }
+
+        /**
+         * @brief Returns true if any path starting with the components
+         *      consumed so far is a match, i.e. the only remaining
+         *      element in one of the states is a trailing `**`.
+         */
+        [[nodiscard]]
+        bool matches_everything(const StateSet& states) const
+        {
+            return has_trailing_any_path()
+                   && states.test(elements_.size() - 1);
+        }
+
+        /**
+         * @brief Returns true if every path that matches this automaton
+         *      also matches @a other.
+         *
+         * Each element is compared with the elements of @a other it can
+         * be matched against, so the result is false if a component
+         * that matches an element here could match different elements
+         * in @a other depending on the component.
+         */
+        [[nodiscard]]
+        bool is_subset_of(const PathAutomaton& other) const;
+
+        [[nodiscard]]
+        const std::string& root() const
+        {
+            return root_;
+        }
+
+        [[nodiscard]]
+        const std::pmr::vector<PathElement>& elements() const
+        {
+            return elements_;
+        }
+
+        [[nodiscard]]
+        std::pmr::memory_resource* resource() const
+        {
+            return elements_.get_allocator().resource();
+        }
+
+        [[nodiscard]]
+        bool case_sensitive() const
+        {
+            return case_sensitive_;
+        }
+
+        /**
+         * @brief Returns the approximate number of bytes used by the
+         *      automaton, including the object itself.
+         */
+        [[nodiscard]]
+        size_t memory_usage() const;
+    private:
+        [[nodiscard]]
+        bool is_any_path(size_t i) const
+        {
+            return i < elements_.size()
+                   && std::holds_alternative<AnyPath>(elements_[i]);
+        }
+
+        /**
+         * @brief Returns true if the pattern is relative and starts with
+         *      `**`, and therefore matches paths with any root.
+         */
+        [[nodiscard]]
+        bool can_match_any_root() const
+        {
+            return root_.empty() && is_any_path(0);
+        }
+
+        [[nodiscard]]
+        bool has_trailing_any_path() const
+        {
+            return !elements_.empty() && is_any_path(elements_.size() - 1);
+        }
+
+        [[nodiscard]]
+        bool match(const PathElement& element, std::string_view name) const;
+
+        void add_state(StateSet& states, size_t i) const;
+
+        /**
+         * @brief Like advance, but the states in @a to are the ones that
+         *      are reached for all components that match @a element.
+         */
+        void advance(const StateSet& from, const PathElement& element,
+                     bool case_sensitive, StateSet& to) const;
+
+        [[nodiscard]]
+        bool is_subset(const PathElement& element, bool case_sensitive,
+                       const PathElement& other) const;
+
+        std::string root_;
+        std::pmr::vector<PathElement> elements_;
+        bool case_sensitive_ = true;
+    };
+}
@@ -0,0 +1,124 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "PathComponents.hpp"
+
+namespace Yglob
+{
+    namespace
+    {
+        constexpr char to_lower_ascii(char ch)
+        {
+            return 'A' <= ch && ch <= 'Z' ? char(ch + ('a' - 'A')) : ch;
+        }
+
+        size_t skip_separators(std::string_view str, size_t pos)
+        {
+            while (pos < str.size() && is_path_separator(str[pos]))
+                ++pos;
+            return pos;
+        }
+    }
+
+    std::string_view extract_root(std::string_view& path)
+    {
+        size_t pos = 0;
+#ifdef _WIN32
+        if (path.size() >= 2 && path[1] == ':'
+            && (('A' <= path[0] && path[0] <= 'Z')
+                || ('a' <= path[0] && path[0] <= 'z')))
+        {
+            pos = 2;
+        }
+#endif
+        pos = skip_separators(path, pos);
+        auto root = path.substr(0, pos);
+        path.remove_prefix(pos);
+        return root;
+    }
+
+    bool next_component(std::string_view& path, std::string_view& component)
+    {
+        while (!path.empty())
+        {
+            size_t end = 0;
+            while (end < path.size() && !is_path_separator(path[end]))
+                ++end;
+            component = path.substr(0, end);
+            path.remove_prefix(skip_separators(path, end));
+            if (!component.empty() && component != ".")
+                return true;
+        }
+        return false;
+    }
+
+    bool is_same_root(std::string_view a, std::string_view b,
+                      bool case_sensitive)
+    {
+        size_t i = 0, j = 0;
+        while (i < a.size() && j < b.size())
+        {
+            if (is_path_separator(a[i]) && is_path_separator(b[j]))
+            {
+                i = skip_separators(a, i);
+                j = skip_separators(b, j);
+            }
+            else if (a[i] == b[j]
+                     || (!case_sensitive
+                         && to_lower_ascii(a[i]) == to_lower_ascii(b[j])))
+            {
+                ++i;
+                ++j;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return i == a.size() && j == b.size();
+    }
+
+    bool is_ascii(std::string_view str)
+    {
+        for (auto ch : str)
+        {
+            if (static_cast<unsigned char>(ch) >= 0x80)
+                return false;
+        }
+        return true;
+    }
+
+    std::string fold_ascii(std::string_view str)
+    {
+        std::string result(str);
+        for (auto& ch : result)
+            ch = to_lower_ascii(ch);
+        return result;
+    }
+
+    std::string_view fold_ascii(std::string_view str,
+                                char* buffer, size_t buffer_size)
+    {
+        if (str.size() > buffer_size)
+            return {};
+        for (size_t i = 0; i < str.size(); ++i)
+            buffer[i] = to_lower_ascii(str[i]);
+        return {buffer, str.size()};
+    }
+
+    bool equal_folded_ascii(std::string_view str, std::string_view folded)
+    {
+        if (str.size() != folded.size())
+            return false;
+        for (size_t i = 0; i < str.size(); ++i)
+        {
+            if (to_lower_ascii(str[i]) != folded[i])
+                return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,98 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <functional>
+#include <string>
+#include <string_view>
+
+/** @file
+  * @brief Functions for splitting paths into components without
+  *     creating std::filesystem::path instances.
+  */
+
+namespace Yglob
+{
+    [[nodiscard]]
+    constexpr bool is_path_separator(char ch)
+    {
+#ifdef _WIN32
+        return ch == '/' || ch == '\\';
+#else
+        return ch == '/';
+#endif
+    }
+
+    /**
+     * @brief Removes the root (e.g. "/" or "C:/") from the start of
+     *      @a path and returns it.
+     *
+     * Returns an empty string if @a path is relative.
+     */
+    std::string_view extract_root(std::string_view& path);
+
+    /**
+     * @brief Removes the first component from @a path and assigns it
+     *      to @a component.
+     *
+     * Empty components and "." are skipped.
+     *
+     * @return false if there are no more components in @a path.
+     */
+    bool next_component(std::string_view& path, std::string_view& component);
+
+    /**
+     * @brief Returns true if @a a and @a b are the same root, ignoring
+     *      differences in directory separators.
+     */
+    [[nodiscard]]
+    bool is_same_root(std::string_view a, std::string_view b,
+                      bool case_sensitive);
+
+    [[nodiscard]]
+    bool is_ascii(std::string_view str);
+
+    /**
+     * @brief Converts the ASCII letters in @a str to lower case.
+     */
+    [[nodiscard]]
+    std::string fold_ascii(std::string_view str);
+
+    /**
+     * @brief Compares @a str with @a folded which has already been
+     *      converted with fold_ascii.
+     *
+     * @a folded must only consist of ASCII characters.
+     */
+    [[nodiscard]]
+    bool equal_folded_ascii(std::string_view str, std::string_view folded);
+
+    /**
+     * @brief Converts the ASCII letters in @a str to lower case and
+     *      writes the result to @a buffer.
+     *
+     * @return The folded string, or an empty string if @a str doesn't
+     *      fit in @a buffer.
+     */
+    [[nodiscard]]
+    std::string_view fold_ascii(std::string_view str,
+                                char* buffer, size_t buffer_size);
+
+    /**
+     * @brief Hash function that lets unordered containers with string
+     *      keys be searched with string views.
+     */
+    struct StringHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view str) const
+        {
+            return std::hash<std::string_view>{}(str);
+        }
+    };
+}
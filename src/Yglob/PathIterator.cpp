@@ -6,10 +6,18 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #include "Yglob/PathIterator.hpp"
+#include <algorithm>
 #include <Ystring/Algorithms.hpp>
 #include "Yglob/GlobMatcher.hpp"
 #include "Yglob/PathMatcher.hpp"
+#include "Yglob/PathMatcherSet.hpp"
+#include "FileStatusBatch.hpp"
+#include "FlagConversion.hpp"
+#include "MultiPatternWalker.hpp"
+#include "ParallelWalker.hpp"
 #include "PathPartIterator.hpp"
+#include "Prefetcher.hpp"
+#include "StopCondition.hpp"
 
 namespace Yglob
 {
@@ -27,42 +35,66 @@ namespace Yglob
         }
 
         void handle_plain_path(std::vector<std::unique_ptr<PathPartIterator>>& iterators,
-                               std::filesystem::path& path)
+                               std::filesystem::path& path,
+                               const std::shared_ptr<EntryFilter>& filter,
+                               const std::shared_ptr<FileSystem>& file_system)
         {
             if (!path.empty())
             {
                 iterators.emplace_back(
                     std::make_unique<SinglePathIterator>(std::move(path),
-                                                         iterators.empty()));
+                                                         iterators.empty(),
+                                                         filter,
+                                                         file_system));
                 path = std::filesystem::path();
             }
         }
 
-        GlobFlags to_glob_flags(PathIteratorFlags flags)
+        /**
+         * @brief Returns a matcher allocated from @a resource, or one
+         *      that shares its compiled pattern if @a resource is null.
+         */
+        template <typename Matcher, typename Pattern>
+        Matcher make_matcher(const Pattern& pattern, GlobFlags flags,
+                             std::pmr::memory_resource* resource)
         {
-            GlobFlags result = {};
-            if (bool(flags & PathIteratorFlags::CASE_SENSITIVE_GLOBS))
-                result |= GlobFlags::CASE_SENSITIVE;
-            if (bool(flags & PathIteratorFlags::NO_BRACES))
-                result |= GlobFlags::NO_BRACES;
-            if (bool(flags & PathIteratorFlags::NO_SETS))
-                result |= GlobFlags::NO_SETS;
-            return result;
+            if (resource)
+                return Matcher(pattern, flags, resource);
+            return Matcher(pattern, flags);
         }
 
-        std::filesystem::directory_options
-        to_directory_options(PathIteratorFlags flags)
+        template <typename Member, typename Value>
+        PathIteratorOptions make_options(Member PathIteratorOptions::* member,
+                                         Value value)
         {
-            std::filesystem::directory_options result = {};
-            if (!bool(flags & PathIteratorFlags::THROW_IF_ACCESS_DENIED))
-                result |= std::filesystem::directory_options::skip_permission_denied;
+            PathIteratorOptions result;
+            result.*member = std::move(value);
             return result;
         }
 
+        /**
+         * @brief Returns true if a single glob path must be walked like
+         *      several, because only the walkers read directories in
+         *      parallel or split a traversal into shards.
+         *
+         * Shards other than the default are always walked, so that the
+         * walker can reject invalid ones.
+         */
+        bool needs_walker(const PathIteratorOptions& options)
+        {
+            const auto& shard = options.shard;
+            return options.parallel
+                   || shard.index != 0 || shard.count != 1 || shard.depth != 1;
+        }
+
         std::vector<std::unique_ptr<PathPartIterator>>
         parse_glob_path(const std::filesystem::path& path,
-                        PathIteratorFlags flags)
+                        const std::vector<std::string>& exclude_patterns,
+                        PathIteratorFlags flags,
+                        const std::shared_ptr<FileSystem>& file_system,
+                        std::pmr::memory_resource* resource)
         {
+            auto filter = make_entry_filter(exclude_patterns, flags);
             std::vector<std::unique_ptr<PathPartIterator>> result;
             std::filesystem::path plain_path;
 
@@ -72,31 +104,34 @@ namespace Yglob
                 auto name = it->generic_u8string();
                 if (name == u8"**")
                 {
-                    handle_plain_path(result, plain_path);
+                    handle_plain_path(result, plain_path, filter, file_system);
                     result.emplace_back(std::make_unique<DoubleStarIterator>(
-                        PathMatcher(make_path(++it, end, u8"**"),
-                                    to_glob_flags(flags)),
-                        to_directory_options(flags)));
+                        make_matcher<PathMatcher>(make_path(++it, end, u8"**"),
+                                                  to_glob_flags(flags), resource),
+                        to_directory_options(flags),
+                        filter, file_system));
                     if (result.size() == 1)
-                        result.back()->set_base_path(".");
+                        result.back()->set_base_path({});
                     break;
                 }
 
                 std::optional<GlobFlags> glob_flags;
                 if (case_insensitive_paths && !it->has_root_path())
                     glob_flags = GlobFlags::NO_SETS | GlobFlags::NO_BRACES;
-                else if (is_glob_pattern(ystring::to_string_view(name)))
+                else if (is_glob_pattern(ystring::to_string_view(name),
+                                         to_glob_flags(flags)))
                     glob_flags = to_glob_flags(flags);
 
                 if (glob_flags)
                 {
-                    handle_plain_path(result, plain_path);
+                    handle_plain_path(result, plain_path, filter, file_system);
                     result.emplace_back(std::make_unique<GlobIterator>(
-                        GlobMatcher(ystring::to_string_view(name),
-                                    *glob_flags),
-                        to_directory_options(flags)));
+                        make_matcher<GlobMatcher>(ystring::to_string_view(name),
+                                                  *glob_flags, resource),
+                        to_directory_options(flags),
+                        filter, file_system));
                     if (result.size() == 1)
-                        result.back()->set_base_path(".");
+                        result.back()->set_base_path({});
                 }
                 else
                 {
@@ -104,7 +139,7 @@ namespace Yglob
                 }
             }
 
-            handle_plain_path(result, plain_path);
+            handle_plain_path(result, plain_path, filter, file_system);
             return result;
         }
     }
@@ -112,14 +147,83 @@ namespace Yglob
     class PathIterator::PathIteratorImpl
     {
     public:
-        explicit PathIteratorImpl(const std::filesystem::path& glob_path,
-                                  PathIteratorFlags flags)
-            : iterators_(parse_glob_path(glob_path, flags)),
+        PathIteratorImpl(const std::filesystem::path& glob_path,
+                         const std::vector<std::string>& exclude_patterns,
+                         PathIteratorFlags flags,
+                         const PathIteratorOptions& options)
+            : iterators_(parse_glob_path(glob_path, exclude_patterns, flags,
+                                         options.file_system, options.resource)),
+              file_system_(options.file_system),
               flags_(flags)
+        {
+            share_stop_condition();
+        }
+
+        PathIteratorImpl(const std::vector<std::filesystem::path>& glob_paths,
+                         const std::vector<std::string>& exclude_patterns,
+                         PathIteratorFlags flags,
+                         const PathIteratorOptions& options)
+            : flags_(flags)
+        {
+            auto filter = make_entry_filter(exclude_patterns, flags);
+            if (options.parallel)
+            {
+                parallel_walker_ = std::make_unique<ParallelWalker>(
+                    glob_paths, flags, std::move(filter), options.file_system,
+                    *options.parallel, options.shard);
+            }
+            else
+            {
+                walker_ = std::make_unique<MultiPatternWalker>(
+                    glob_paths, flags, std::move(filter), options.file_system,
+                    options.shard,
+                    options.resource ? options.resource
+                                     : std::pmr::get_default_resource());
+            }
+            share_stop_condition();
+        }
+
+        PathIteratorImpl(PathIterator source, size_t max_buffered)
+            : stop_condition_(source.impl_
+                              ? source.impl_->stop_condition_
+                              : std::make_shared<StopCondition>()),
+              prefetcher_(std::make_unique<Prefetcher>(std::move(source),
+                                                       max_buffered)),
+              flags_(PathIteratorFlags::DEFAULT)
         {}
 
         bool next()
         {
+            if (status_ != IterationStatus::IN_PROGRESS)
+                return false;
+            if (!stop_condition_->is_stopped() && next_path())
+                return true;
+            status_ = stop_condition_->reason();
+            if (status_ == IterationStatus::IN_PROGRESS)
+                status_ = IterationStatus::COMPLETED;
+            return false;
+        }
+
+        [[nodiscard]]
+        StopCondition& stop_condition()
+        {
+            return *stop_condition_;
+        }
+
+        [[nodiscard]]
+        IterationStatus status() const
+        {
+            return status_;
+        }
+
+        bool next_path()
+        {
+            if (prefetcher_)
+                return prefetcher_->next();
+            if (parallel_walker_)
+                return parallel_walker_->next();
+            if (walker_)
+                return walker_->next();
             if (iterators_.empty())
                 return false;
             while (iterators_.back()->next())
@@ -158,12 +262,56 @@ namespace Yglob
         [[nodiscard]]
         const std::filesystem::path& path() const
         {
+            if (prefetcher_)
+                return prefetcher_->path();
+            if (parallel_walker_)
+                return parallel_walker_->path();
+            if (walker_)
+                return walker_->path();
             return iterators_.back()->path();
         }
 
+        [[nodiscard]]
+        std::string_view view() const
+        {
+            if constexpr (std::is_same_v<std::filesystem::path::value_type, char>)
+            {
+                return path().native();
+            }
+            else
+            {
+                auto str = path().generic_u8string();
+                view_buffer_.assign(ystring::to_string_view(str));
+                return view_buffer_;
+            }
+        }
+
+        [[nodiscard]]
+        const std::vector<size_t>& pattern_indexes() const
+        {
+            static const std::vector<size_t> first_pattern = {0};
+            if (prefetcher_)
+                return prefetcher_->pattern_indexes();
+            if (parallel_walker_)
+                return parallel_walker_->pattern_indexes();
+            if (walker_)
+                return walker_->pattern_indexes();
+            return first_pattern;
+        }
+
     private:
         using Container = std::vector<std::unique_ptr<PathPartIterator>>;
 
+        void share_stop_condition()
+        {
+            for (const auto& iterator : iterators_)
+                iterator->set_stop_condition(stop_condition_);
+            if (walker_)
+                walker_->set_stop_condition(stop_condition_);
+            if (parallel_walker_)
+                parallel_walker_->set_stop_condition(stop_condition_);
+        }
+
         bool find_prev_with_next(Container::const_iterator& it) const
         {
             while (it != iterators_.cbegin())
@@ -180,19 +328,135 @@ namespace Yglob
         {
             auto no_files = bool(flags_ & PathIteratorFlags::NO_FILES);
             auto no_dirs = bool(flags_ & PathIteratorFlags::NO_DIRECTORIES);
-            return (!no_files || !std::filesystem::is_regular_file(path))
-                   && (!no_dirs || !std::filesystem::is_directory(path));
+            if (!no_files && !no_dirs)
+                return true;
+            auto type = file_system_ ? file_system_->status(path).type
+                                     : get_file_status(path).type;
+            return (!no_files || type != std::filesystem::file_type::regular)
+                   && (!no_dirs || type != std::filesystem::file_type::directory);
         }
 
+        std::shared_ptr<StopCondition> stop_condition_ = std::make_shared<StopCondition>();
         std::vector<std::unique_ptr<PathPartIterator>> iterators_;
+        std::unique_ptr<MultiPatternWalker> walker_;
+        std::unique_ptr<ParallelWalker> parallel_walker_;
+        std::unique_ptr<Prefetcher> prefetcher_;
+        // Only used with iterators_.
+        std::shared_ptr<FileSystem> file_system_;
         PathIteratorFlags flags_;
+        IterationStatus status_ = IterationStatus::IN_PROGRESS;
+        mutable std::string view_buffer_;
     };
 
     PathIterator::PathIterator() = default;
 
     PathIterator::PathIterator(const std::filesystem::path& glob_path,
                                PathIteratorFlags flags)
-        : impl_(std::make_unique<PathIteratorImpl>(glob_path, flags))
+        : PathIterator(glob_path, {}, flags)
+    {}
+
+    PathIterator::PathIterator(const std::filesystem::path& glob_path,
+                               const std::vector<std::string>& exclude_patterns,
+                               PathIteratorFlags flags)
+        : PathIterator(glob_path, exclude_patterns, flags, std::shared_ptr<FileSystem>())
+    {}
+
+    PathIterator::PathIterator(const std::vector<std::filesystem::path>& glob_paths,
+                               PathIteratorFlags flags)
+        : PathIterator(glob_paths, {}, flags)
+    {}
+
+    PathIterator::PathIterator(const std::vector<std::filesystem::path>& glob_paths,
+                               const std::vector<std::string>& exclude_patterns,
+                               PathIteratorFlags flags)
+        : PathIterator(glob_paths, exclude_patterns, flags, std::shared_ptr<FileSystem>())
+    {}
+
+    PathIterator::PathIterator(const std::filesystem::path& glob_path,
+                               const std::vector<std::string>& exclude_patterns,
+                               PathIteratorFlags flags,
+                               std::shared_ptr<FileSystem> file_system)
+        : PathIterator(glob_path, exclude_patterns, flags,
+                       make_options(&PathIteratorOptions::file_system,
+                                    std::move(file_system)))
+    {}
+
+    PathIterator::PathIterator(const std::vector<std::filesystem::path>& glob_paths,
+                               const std::vector<std::string>& exclude_patterns,
+                               PathIteratorFlags flags,
+                               std::shared_ptr<FileSystem> file_system)
+        : PathIterator(glob_paths, exclude_patterns, flags,
+                       make_options(&PathIteratorOptions::file_system,
+                                    std::move(file_system)))
+    {}
+
+    PathIterator::PathIterator(const std::filesystem::path& glob_path,
+                               const std::vector<std::string>& exclude_patterns,
+                               PathIteratorFlags flags,
+                               std::pmr::memory_resource* resource)
+        : PathIterator(glob_path, exclude_patterns, flags,
+                       make_options(&PathIteratorOptions::resource, resource))
+    {}
+
+    PathIterator::PathIterator(const std::vector<std::filesystem::path>& glob_paths,
+                               const std::vector<std::string>& exclude_patterns,
+                               PathIteratorFlags flags,
+                               std::pmr::memory_resource* resource)
+        : PathIterator(glob_paths, exclude_patterns, flags,
+                       make_options(&PathIteratorOptions::resource, resource))
+    {}
+
+    PathIterator::PathIterator(const std::filesystem::path& glob_path,
+                               const std::vector<std::string>& exclude_patterns,
+                               PathIteratorFlags flags,
+                               const ParallelOptions& parallel)
+        : PathIterator(glob_path, exclude_patterns, flags,
+                       make_options(&PathIteratorOptions::parallel, parallel))
+    {}
+
+    PathIterator::PathIterator(const std::vector<std::filesystem::path>& glob_paths,
+                               const std::vector<std::string>& exclude_patterns,
+                               PathIteratorFlags flags,
+                               const ParallelOptions& parallel)
+        : PathIterator(glob_paths, exclude_patterns, flags,
+                       make_options(&PathIteratorOptions::parallel, parallel))
+    {}
+
+    PathIterator::PathIterator(const std::filesystem::path& glob_path,
+                               const std::vector<std::string>& exclude_patterns,
+                               PathIteratorFlags flags,
+                               const Shard& shard)
+        : PathIterator(glob_path, exclude_patterns, flags,
+                       make_options(&PathIteratorOptions::shard, shard))
+    {}
+
+    PathIterator::PathIterator(const std::vector<std::filesystem::path>& glob_paths,
+                               const std::vector<std::string>& exclude_patterns,
+                               PathIteratorFlags flags,
+                               const Shard& shard)
+        : PathIterator(glob_paths, exclude_patterns, flags,
+                       make_options(&PathIteratorOptions::shard, shard))
+    {}
+
+    PathIterator::PathIterator(const std::filesystem::path& glob_path,
+                               const std::vector<std::string>& exclude_patterns,
+                               PathIteratorFlags flags,
+                               const PathIteratorOptions& options)
+        : impl_(needs_walker(options)
+                ? std::make_unique<PathIteratorImpl>(std::vector{glob_path},
+                                                     exclude_patterns,
+                                                     flags, options)
+                : std::make_unique<PathIteratorImpl>(glob_path,
+                                                     exclude_patterns,
+                                                     flags, options))
+    {}
+
+    PathIterator::PathIterator(const std::vector<std::filesystem::path>& glob_paths,
+                               const std::vector<std::string>& exclude_patterns,
+                               PathIteratorFlags flags,
+                               const PathIteratorOptions& options)
+        : impl_(std::make_unique<PathIteratorImpl>(glob_paths, exclude_patterns,
+                                                   flags, options))
     {}
 
     PathIterator::~PathIterator() = default;
@@ -218,4 +482,55 @@ namespace Yglob
         static const std::filesystem::path empty_path;
         return impl_ ? impl_->path() : empty_path;
     }
+
+    void PathIterator::set_stop_token(std::stop_token token)
+    {
+        if (impl_)
+            impl_->stop_condition().set_stop_token(std::move(token));
+    }
+
+    void PathIterator::set_deadline(std::chrono::steady_clock::time_point deadline)
+    {
+        if (impl_)
+            impl_->stop_condition().set_deadline(deadline);
+    }
+
+    IterationStatus PathIterator::status() const
+    {
+        return impl_ ? impl_->status() : IterationStatus::COMPLETED;
+    }
+
+    std::string_view PathIterator::view() const
+    {
+        return impl_ ? impl_->view() : std::string_view();
+    }
+
+    const std::vector<size_t>& PathIterator::pattern_indexes() const
+    {
+        static const std::vector<size_t> empty_indexes;
+        return impl_ ? impl_->pattern_indexes() : empty_indexes;
+    }
+
+    PathIterator PathIterator::prefetching(PathIterator source,
+                                           size_t max_buffered)
+    {
+        PathIterator result;
+        result.impl_ = std::make_unique<PathIteratorImpl>(std::move(source),
+                                                          max_buffered);
+        return result;
+    }
+
+    RefreshedGlob PathIterator::refresh(const GlobSnapshot& previous)
+    {
+        RefreshedGlob result{GlobSnapshot(previous.glob_paths(),
+                                          previous.exclude_patterns(),
+                                          previous.flags(),
+                                          previous.make_cache()),
+                             {}, {}};
+        std::ranges::set_difference(result.snapshot.paths(), previous.paths(),
+                                    std::back_inserter(result.added));
+        std::ranges::set_difference(previous.paths(), result.snapshot.paths(),
+                                    std::back_inserter(result.removed));
+        return result;
+    }
 }
@@ -0,0 +1,183 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yglob/PathList.hpp"
+
+#include <algorithm>
+#include <Ystring/Algorithms.hpp>
+#include "Yglob/PathIterator.hpp"
+#include "Yglob/YglobException.hpp"
+#include "MemoryUsage.hpp"
+
+namespace Yglob
+{
+    namespace
+    {
+        /**
+         * @brief The number of paths in each block. Random access decodes
+         *      up to this many paths, larger blocks only save the space
+         *      of their offsets.
+         */
+        constexpr size_t BLOCK_SIZE = 16;
+
+        void write_length(std::string& data, size_t value)
+        {
+            while (value >= 0x80)
+            {
+                data.push_back(char(0x80u | (value & 0x7Fu)));
+                value >>= 7;
+            }
+            data.push_back(char(value));
+        }
+
+        size_t read_length(std::string_view data, size_t& offset)
+        {
+            size_t value = 0;
+            for (unsigned shift = 0;; shift += 7)
+            {
+                auto byte = uint8_t(data[offset++]);
+                value |= size_t(byte & 0x7Fu) << shift;
+                if (byte < 0x80)
+                    return value;
+            }
+        }
+
+        std::filesystem::path from_string(std::string_view str)
+        {
+            return {std::u8string_view(reinterpret_cast<const char8_t*>(str.data()),
+                                       str.size())};
+        }
+    }
+
+    PathList::Iterator::Iterator(const PathList* list, size_t index)
+        : list_(list),
+          index_(index)
+    {
+        if (index_ < list_->size_)
+            offset_ = list_->decode(0, current_);
+    }
+
+    PathList::Iterator& PathList::Iterator::operator++()
+    {
+        if (++index_ < list_->size_)
+            offset_ = list_->decode(offset_, current_);
+        return *this;
+    }
+
+    PathList::PathList() = default;
+
+    void PathList::push_back(std::string_view path)
+    {
+        size_t prefix = 0;
+        if (size_ % BLOCK_SIZE == 0)
+        {
+            block_offsets_.push_back(data_.size());
+        }
+        else
+        {
+            auto [it, _] = std::ranges::mismatch(path, last_);
+            prefix = size_t(it - path.begin());
+        }
+
+        write_length(data_, prefix);
+        write_length(data_, path.size() - prefix);
+        data_.append(path.substr(prefix));
+        last_ = path;
+        ++size_;
+    }
+
+    void PathList::push_back(const std::filesystem::path& path)
+    {
+        if constexpr (std::is_same_v<std::filesystem::path::value_type, char>)
+            push_back(std::string_view(path.native()));
+        else
+            push_back(ystring::to_string_view(path.generic_u8string()));
+    }
+
+    size_t PathList::size() const
+    {
+        return size_;
+    }
+
+    bool PathList::empty() const
+    {
+        return size_ == 0;
+    }
+
+    std::filesystem::path PathList::operator[](size_t index) const
+    {
+        std::string result;
+        return from_string(get(index, result));
+    }
+
+    std::string_view PathList::get(size_t index, std::string& result) const
+    {
+        if (index >= size_)
+            YGLOB_THROW("PathList index is out of range.");
+
+        auto offset = block_offsets_[index / BLOCK_SIZE];
+        result.clear();
+        for (size_t i = 0; i <= index % BLOCK_SIZE; ++i)
+            offset = decode(offset, result);
+        return result;
+    }
+
+    PathList::Iterator PathList::begin() const
+    {
+        return {this, 0};
+    }
+
+    PathList::Iterator PathList::end() const
+    {
+        return {this, size_};
+    }
+
+    void PathList::clear()
+    {
+        data_.clear();
+        block_offsets_.clear();
+        last_.clear();
+        size_ = 0;
+    }
+
+    void PathList::shrink_to_fit()
+    {
+        data_.shrink_to_fit();
+        block_offsets_.shrink_to_fit();
+    }
+
+    size_t PathList::memory_usage() const
+    {
+        return sizeof(PathList) + get_heap_usage(data_)
+               + get_heap_usage(block_offsets_) + get_heap_usage(last_);
+    }
+
+    size_t PathList::decode(size_t offset, std::string& path) const
+    {
+        auto prefix = read_length(data_, offset);
+        auto length = read_length(data_, offset);
+        path.resize(prefix);
+        path.append(data_, offset, length);
+        return offset + length;
+    }
+
+    PathList collect(PathIterator& iterator)
+    {
+        PathList result;
+        while (iterator.next())
+            result.push_back(iterator.view());
+        result.shrink_to_fit();
+        return result;
+    }
+
+    PathList collect(const std::filesystem::path& glob_path,
+                     PathIteratorFlags flags)
+    {
+        PathIterator iterator(glob_path, flags);
+        return collect(iterator);
+    }
+}
@@ -7,180 +7,392 @@
 //****************************************************************************
 #include "Yglob/PathMatcher.hpp"
 
-#include <variant>
-#include <vector>
-#include <span>
+#include <algorithm>
 #include <Ystring/Algorithms.hpp>
-#include "Yglob/GlobMatcher.hpp"
+#include "PathAutomaton.hpp"
+#include "PathComponents.hpp"
 
 namespace Yglob
 {
     namespace
     {
-        struct AnyPath
-        {};
-
-        using PathElement = std::variant<std::string, AnyPath, GlobMatcher>;
-
-        bool equal(std::string_view str, std::string_view cmp,
-                   bool case_sensitive)
-        {
-            return case_sensitive
-                   ? str == cmp
-                   : ystring::case_insensitive::equal(str, cmp);
-        }
-
         inline std::u8string_view to_u8string_view(std::string_view str)
         {
             static_assert(sizeof(char) == sizeof(char8_t));
             return {reinterpret_cast<const char8_t*>(str.data()), str.size()};
         }
-    }
 
-    class PathMatcher::PathMatcherImpl
-    {
-    public:
-        explicit PathMatcherImpl(std::filesystem::path pattern,
-                                 GlobFlags flags)
-            : case_sensitive_(bool(flags & GlobFlags::CASE_SENSITIVE))
+        /**
+         * @brief Calls @a func with @a path as a UTF-8 string view.
+         *
+         * Avoids copying the path when its native format is a char string.
+         */
+        template <typename Func>
+        bool with_string_view(const std::filesystem::path& path, Func func)
         {
-            pattern = pattern.lexically_normal();
-            while (true)
+            if constexpr (std::is_same_v<std::filesystem::path::value_type, char>)
+            {
+                return func(std::string_view(path.native()));
+            }
+            else
             {
-                auto filename_u8 = pattern.filename().generic_u8string();
-                auto filename_view = ystring::to_string_view(filename_u8);
-                if (filename_view == "**")
-                    elements_.emplace_back(AnyPath{});
-                else if (is_glob_pattern(filename_view))
-                    elements_.emplace_back(GlobMatcher(filename_view, flags));
-                else if (!filename_view.empty())
-                    elements_.emplace_back(std::string(filename_view));
-                auto parent_path = pattern.parent_path();
-                if (parent_path == pattern)
+                auto u8str = path.generic_u8string();
+                return func(ystring::to_string_view(u8str));
+            }
+        }
+
+        /**
+         * @brief The remaining components of a path stored in a string.
+         */
+        class StringComponents
+        {
+        public:
+            explicit StringComponents(std::string_view path)
+                : path_(path)
+            {}
+
+            std::string_view extract_root()
+            {
+                return Yglob::extract_root(path_);
+            }
+
+            bool next(std::string_view& component)
+            {
+                return next_component(path_, component);
+            }
+        private:
+            std::string_view path_;
+        };
+
+        /**
+         * @brief The remaining components of a path that has already been
+         *      split by the caller.
+         */
+        class SpanComponents
+        {
+        public:
+            explicit SpanComponents(std::span<const std::string_view> components)
+                : components_(components)
+            {}
+
+            std::string_view extract_root()
+            {
+                if (components_.empty())
+                    return {};
+                auto first = components_.front();
+                auto root = Yglob::extract_root(first);
+                if (root.empty() || !first.empty())
+                    return {};
+                components_ = components_.subspan(1);
+                return root;
+            }
+
+            bool next(std::string_view& component)
+            {
+                while (!components_.empty())
                 {
-                    if (!parent_path.empty())
-                    {
-                        filename_u8 = parent_path.generic_u8string();
-                        filename_view = ystring::to_string_view(filename_u8);
-                        elements_.emplace_back(std::string(filename_view));
-                    }
-                    break;
+                    component = components_.front();
+                    components_ = components_.subspan(1);
+                    if (!component.empty() && component != ".")
+                        return true;
                 }
-                pattern = parent_path;
+                return false;
             }
-        }
+        private:
+            std::span<const std::string_view> components_;
+        };
+    }
+
+    class PathMatcher::PathMatcherImpl
+    {
+    public:
+        PathMatcherImpl(const std::filesystem::path& pattern,
+                        GlobFlags flags,
+                        std::pmr::memory_resource* resource)
+            : automaton_(pattern, flags, resource)
+        {}
 
         [[nodiscard]]
-        bool match(const std::filesystem::path& path) const
+        const PathAutomaton& automaton() const
         {
-            std::span elements(elements_.data(), elements_.size());
-            return match(elements, path);
+            return automaton_;
         }
-    private:
-        // NOLINTBEGIN(misc-no-recursion)
 
+        template <typename Components>
         [[nodiscard]]
-        bool match(std::span<const PathElement> elements,
-                   std::filesystem::path path) const
+        bool match(Components components) const
         {
-            for (size_t i = 0; i < elements.size(); ++i)
+            auto states = automaton_.start(components.extract_root());
+            StateSet next_states(automaton_.resource());
+            std::string_view name;
+            while (components.next(name))
             {
-                const auto& element = elements[i];
-                auto filename = path.filename();
-                if (filename.empty())
-                    filename = path;
-                auto parent = path.parent_path();
-                if (std::holds_alternative<std::string>(element))
-                {
-                    auto str = std::get<std::string>(element);
-                    auto u8str = filename.generic_u8string();
-                    if (!equal(str, ystring::to_string_view(u8str), case_sensitive_))
-                        return false;
-                }
-                else if (std::holds_alternative<AnyPath>(element))
-                {
-                    return search(elements.subspan(i + 1), path);
-                }
-                else if (std::holds_alternative<GlobMatcher>(element))
-                {
-                    auto& matcher = std::get<GlobMatcher>(element);
-                    if (!matcher.match(ystring::to_string_view(filename.generic_u8string())))
-                        return false;
-                }
-                if (parent == path)
-                    return i == elements.size() - 1;
-                path = std::move(parent);
+                if (states.empty())
+                    return false;
+                if (automaton_.matches_everything(states))
+                    return true;
+                automaton_.advance(states, name, next_states);
+                std::swap(states, next_states);
             }
-            return path.empty() || path == ".";
+            return automaton_.is_match(states);
         }
 
+        template <typename Components>
         [[nodiscard]]
-        bool search(std::span<const PathElement> elements,
-                    std::filesystem::path path) const
+        bool may_match_below(Components components) const
         {
-            if (elements.empty())
-                return true;
+            return automaton_.can_match_more(consume(components));
+        }
 
-            while (true)
+        template <typename Components>
+        [[nodiscard]]
+        bool matches_all_below(Components components) const
+        {
+            return automaton_.matches_everything(consume(components));
+        }
+    private:
+        template <typename Components>
+        [[nodiscard]]
+        StateSet consume(Components& components) const
+        {
+            auto states = automaton_.start(components.extract_root());
+            StateSet next_states(automaton_.resource());
+            std::string_view name;
+            while (!states.empty() && components.next(name))
             {
-                if (match(elements, path))
-                    return true;
-                auto parent = path.parent_path();
-                if (parent == path)
-                    return false;
-                path = std::move(parent);
+                automaton_.advance(states, name, next_states);
+                std::swap(states, next_states);
             }
+            return states;
         }
 
-        // NOLINTEND(misc-no-recursion)
-
-        std::vector<PathElement> elements_;
-        bool case_sensitive_ = true;
+        PathAutomaton automaton_;
     };
 
     PathMatcher::PathMatcher() = default;
 
     PathMatcher::PathMatcher(std::string_view pattern, GlobFlags flags)
-        : impl_(std::make_unique<PathMatcherImpl>(pattern, flags))
+        : PathMatcher(std::filesystem::path(to_u8string_view(pattern)), flags)
     {}
 
     PathMatcher::PathMatcher(const std::filesystem::path& pattern,
                              GlobFlags flags)
-        : impl_(std::make_unique<PathMatcherImpl>(pattern, flags))
+        : impl_(std::make_shared<PathMatcherImpl>(
+            pattern, flags, std::pmr::get_default_resource()))
     {}
 
-    PathMatcher::PathMatcher(const PathMatcher& rhs)
+    PathMatcher::PathMatcher(std::string_view pattern, GlobFlags flags,
+                             std::pmr::memory_resource* resource)
+        : PathMatcher(std::filesystem::path(to_u8string_view(pattern)),
+                      flags, resource)
+    {}
+
+    PathMatcher::PathMatcher(const std::filesystem::path& pattern,
+                             GlobFlags flags,
+                             std::pmr::memory_resource* resource)
+        : impl_(std::allocate_shared<PathMatcherImpl>(
+            std::pmr::polymorphic_allocator<PathMatcherImpl>(resource),
+            pattern, flags, resource))
+    {}
+
+    PathMatcher::PathMatcher(const PathMatcher& rhs) = default;
+
+    PathMatcher::PathMatcher(PathMatcher&& rhs) noexcept = default;
+
+    PathMatcher::~PathMatcher() = default;
+
+    PathMatcher& PathMatcher::operator=(const PathMatcher& rhs) = default;
+
+    PathMatcher& PathMatcher::operator=(PathMatcher&& rhs) noexcept = default;
+
+    bool PathMatcher::match(std::string_view str) const
     {
-        impl_ = std::make_unique<PathMatcherImpl>(*rhs.impl_);
+        return impl_->match(StringComponents(str));
     }
 
-    PathMatcher::PathMatcher(PathMatcher&& rhs) noexcept
+    bool PathMatcher::match(const std::filesystem::path& str) const
     {
-        impl_ = std::move(rhs.impl_);
+        return with_string_view(str, [this](std::string_view s)
+        {
+            return match(s);
+        });
     }
 
-    PathMatcher::~PathMatcher() = default;
+    bool PathMatcher::match(std::span<const std::string_view> components) const
+    {
+        return impl_->match(SpanComponents(components));
+    }
 
-    PathMatcher& PathMatcher::operator=(const PathMatcher& rhs)
+    bool PathMatcher::may_match_below(std::string_view dir) const
     {
-        if (this != &rhs)
-            impl_ = std::make_unique<PathMatcherImpl>(*rhs.impl_);
-        return *this;
+        return impl_->may_match_below(StringComponents(dir));
     }
 
-    PathMatcher& PathMatcher::operator=(PathMatcher&& rhs) noexcept
+    bool PathMatcher::may_match_below(const std::filesystem::path& dir) const
     {
-        impl_ = std::move(rhs.impl_);
-        return *this;
+        return with_string_view(dir, [this](std::string_view s)
+        {
+            return may_match_below(s);
+        });
     }
 
-    bool PathMatcher::match(std::string_view str) const
+    bool PathMatcher::matches_all_below(std::string_view dir) const
     {
-        return match(std::filesystem::path(to_u8string_view(str)));
+        return impl_->matches_all_below(StringComponents(dir));
     }
 
-    bool PathMatcher::match(const std::filesystem::path& str) const
+    bool PathMatcher::matches_all_below(const std::filesystem::path& dir) const
+    {
+        return with_string_view(dir, [this](std::string_view s)
+        {
+            return matches_all_below(s);
+        });
+    }
+
+    size_t PathMatcher::memory_usage() const
     {
-        return impl_->match(str);
+        auto result = sizeof(PathMatcher);
+        if (impl_)
+            result += impl_->automaton().memory_usage();
+        return result;
+    }
+
+    bool is_subset(const PathMatcher& a, const PathMatcher& b)
+    {
+        return a.impl_->automaton().is_subset_of(b.impl_->automaton());
+    }
+
+    std::vector<std::string>
+    simplify_patterns(const std::vector<std::string>& patterns,
+                      GlobFlags flags)
+    {
+        std::vector<PathMatcher> matchers;
+        matchers.reserve(patterns.size());
+        for (const auto& pattern : patterns)
+            matchers.emplace_back(std::string_view(pattern), flags);
+
+        std::vector<std::string> result;
+        for (size_t i = 0; i < matchers.size(); ++i)
+        {
+            bool is_redundant = false;
+            for (size_t j = 0; j < matchers.size() && !is_redundant; ++j)
+            {
+                // Of two equivalent patterns, the one with the lower
+                // index is kept.
+                is_redundant = i != j
+                               && is_subset(matchers[i], matchers[j])
+                               && (j < i || !is_subset(matchers[j], matchers[i]));
+            }
+            if (!is_redundant)
+                result.push_back(patterns[i]);
+        }
+        return result;
+    }
+
+    struct IncrementalPathMatcher::IncrementalPathMatcherImpl
+    {
+        explicit IncrementalPathMatcherImpl(const PathAutomaton& automaton)
+            : automaton(automaton),
+              states(automaton.resource())
+        {}
+
+        bool match(std::string_view path)
+        {
+            const auto shared = size_t(std::ranges::mismatch(path, prev_path).in1
+                                       - path.begin());
+
+            auto rest = path;
+            const auto root = extract_root(rest);
+            if (depth == NO_DEPTH || root.size() != root_size
+                || shared < root_size)
+            {
+                depth = 0;
+                root_size = root.size();
+                resize_states(1);
+                states[0] = automaton.start(root);
+            }
+
+            // Keep the states for the components that are shared
+            // with the previous path.
+            size_t new_depth = 0;
+            while (new_depth < depth && is_shared(ends[new_depth], shared, path))
+                ++new_depth;
+            depth = new_depth;
+
+            rest = path.substr(depth == 0 ? root_size : ends[depth - 1]);
+            std::string_view component;
+            while (next_component(rest, component))
+            {
+                ends.resize(depth);
+                ends.push_back(size_t(component.data() + component.size()
+                                      - path.data()));
+                resize_states(depth + 2);
+                automaton.advance(states[depth], component, states[depth + 1]);
+                ++depth;
+            }
+
+            prev_path.assign(path);
+            return automaton.is_match(states[depth]);
+        }
+
+        static bool is_shared(size_t end, size_t shared, std::string_view path)
+        {
+            return end < shared
+                   || (end == shared
+                       && (end == path.size() || is_path_separator(path[end])));
+        }
+
+        void resize_states(size_t size)
+        {
+            if (states.size() < size)
+                states.resize(size);
+        }
+
+        static constexpr size_t NO_DEPTH = SIZE_MAX;
+
+        const PathAutomaton& automaton;
+        std::string prev_path;
+        size_t root_size = 0;
+        /**
+         * @brief The number of components in prev_path.
+         */
+        size_t depth = NO_DEPTH;
+        /**
+         * @brief The end offsets of the components in prev_path.
+         */
+        std::vector<size_t> ends;
+        /**
+         * @brief The states before and after each component in prev_path.
+         *
+         * Only the first depth + 1 entries are valid, the rest are kept
+         * to reuse their memory.
+         */
+        std::pmr::vector<StateSet> states;
+    };
+
+    IncrementalPathMatcher::IncrementalPathMatcher(const PathMatcher& matcher)
+        : impl_(std::make_unique<IncrementalPathMatcherImpl>(
+            matcher.impl_->automaton()))
+    {}
+
+    IncrementalPathMatcher::IncrementalPathMatcher(
+        IncrementalPathMatcher&& rhs) noexcept = default;
+
+    IncrementalPathMatcher::~IncrementalPathMatcher() = default;
+
+    IncrementalPathMatcher&
+    IncrementalPathMatcher::operator=(IncrementalPathMatcher&& rhs) noexcept = default;
+
+    bool IncrementalPathMatcher::match(std::string_view path)
+    {
+        return impl_->match(path);
+    }
+
+    bool IncrementalPathMatcher::match(const std::filesystem::path& path)
+    {
+        return with_string_view(path, [this](std::string_view s)
+        {
+            return match(s);
+        });
     }
 }
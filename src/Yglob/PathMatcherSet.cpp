@@ -0,0 +1,178 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yglob/PathMatcherSet.hpp"
+
+#include <algorithm>
+#include <Ystring/Algorithms.hpp>
+#include "ComponentTrie.hpp"
+#include "PathComponents.hpp"
+
+namespace Yglob
+{
+    namespace
+    {
+        inline std::u8string_view to_u8string_view(std::string_view str)
+        {
+            static_assert(sizeof(char) == sizeof(char8_t));
+            return {reinterpret_cast<const char8_t*>(str.data()), str.size()};
+        }
+
+        template <typename Func>
+        auto with_string_view(const std::filesystem::path& path, Func func)
+        {
+            if constexpr (std::is_same_v<std::filesystem::path::value_type, char>)
+            {
+                return func(std::string_view(path.native()));
+            }
+            else
+            {
+                auto u8str = path.generic_u8string();
+                return func(ystring::to_string_view(u8str));
+            }
+        }
+    }
+
+    PathMatcherSet::PathMatcherSet()
+        : trie_(std::make_unique<ComponentTrie>())
+    {}
+
+    PathMatcherSet::PathMatcherSet(const std::vector<std::string>& patterns,
+                                   GlobFlags flags)
+        : PathMatcherSet()
+    {
+        for (const auto& pattern : patterns)
+            add(std::string_view(pattern), flags);
+    }
+
+    PathMatcherSet::PathMatcherSet(const PathMatcherSet& rhs)
+        : trie_(std::make_unique<ComponentTrie>(*rhs.trie_)),
+          size_(rhs.size_)
+    {}
+
+    PathMatcherSet::PathMatcherSet(PathMatcherSet&& rhs) noexcept
+        : trie_(std::move(rhs.trie_)),
+          size_(rhs.size_)
+    {
+        rhs.size_ = 0;
+    }
+
+    PathMatcherSet::~PathMatcherSet() = default;
+
+    PathMatcherSet& PathMatcherSet::operator=(const PathMatcherSet& rhs)
+    {
+        if (this != &rhs)
+        {
+            trie_ = std::make_unique<ComponentTrie>(*rhs.trie_);
+            size_ = rhs.size_;
+        }
+        return *this;
+    }
+
+    PathMatcherSet& PathMatcherSet::operator=(PathMatcherSet&& rhs) noexcept
+    {
+        trie_ = std::move(rhs.trie_);
+        size_ = rhs.size_;
+        rhs.size_ = 0;
+        return *this;
+    }
+
+    size_t PathMatcherSet::add(std::string_view pattern, GlobFlags flags)
+    {
+        return add(std::filesystem::path(to_u8string_view(pattern)), flags);
+    }
+
+    size_t PathMatcherSet::add(const std::filesystem::path& pattern,
+                               GlobFlags flags)
+    {
+        if (!trie_)
+            trie_ = std::make_unique<ComponentTrie>();
+        trie_->add(pattern, flags, size_);
+        return size_++;
+    }
+
+    size_t PathMatcherSet::size() const
+    {
+        return size_;
+    }
+
+    bool PathMatcherSet::empty() const
+    {
+        return size_ == 0;
+    }
+
+    bool PathMatcherSet::match(std::string_view path) const
+    {
+        return find_first(path).has_value();
+    }
+
+    bool PathMatcherSet::match(const std::filesystem::path& path) const
+    {
+        return find_first(path).has_value();
+    }
+
+    std::optional<size_t> PathMatcherSet::find_first(std::string_view path) const
+    {
+        std::optional<size_t> result;
+        walk(path, [&](size_t index)
+        {
+            if (!result || index < *result)
+                result = index;
+        });
+        return result;
+    }
+
+    std::optional<size_t>
+    PathMatcherSet::find_first(const std::filesystem::path& path) const
+    {
+        return with_string_view(path, [this](std::string_view s)
+        {
+            return find_first(s);
+        });
+    }
+
+    std::vector<size_t> PathMatcherSet::find_all(std::string_view path) const
+    {
+        std::vector<size_t> result;
+        walk(path, [&](size_t index) {result.push_back(index);});
+        std::ranges::sort(result);
+        return result;
+    }
+
+    std::vector<size_t>
+    PathMatcherSet::find_all(const std::filesystem::path& path) const
+    {
+        return with_string_view(path, [this](std::string_view s)
+        {
+            return find_all(s);
+        });
+    }
+
+    template <typename Func>
+    void PathMatcherSet::walk(std::string_view path, Func func) const
+    {
+        if (!trie_ || size_ == 0)
+            return;
+
+        ComponentTrie::NodeList nodes;
+        ComponentTrie::NodeList next_nodes;
+        trie_->start(extract_root(path), nodes);
+
+        std::string_view component;
+        while (!nodes.empty() && next_component(path, component))
+        {
+            trie_->advance(nodes, component, next_nodes);
+            std::swap(nodes, next_nodes);
+        }
+
+        for (auto node : nodes)
+        {
+            for (auto index : trie_->node(node).patterns)
+                func(index);
+        }
+    }
+}
@@ -8,20 +8,45 @@
 //****************************************************************************
 #include "PathPartIterator.hpp"
 
+#include "FileStatusBatch.hpp"
+
 namespace Yglob
 {
+    PathPartIterator::PathPartIterator(std::shared_ptr<FileSystem> file_system)
+        : file_system_(std::move(file_system))
+    {}
+
     bool PathPartIterator::next_directory()
     {
         while (next())
         {
-            if (std::filesystem::is_directory(path()))
+            if (get_status(path()).type == std::filesystem::file_type::directory)
                 return true;
         }
         return false;
     }
 
-    SinglePathIterator::SinglePathIterator(std::filesystem::path path, bool has_next)
-        : path_(std::move(path)),
+    void PathPartIterator::set_stop_condition(std::shared_ptr<StopCondition> condition)
+    {
+        stop_condition_ = std::move(condition);
+    }
+
+    bool PathPartIterator::is_stopped() const
+    {
+        return stop_condition_ && stop_condition_->is_stopped();
+    }
+
+    FileSystem::Status PathPartIterator::get_status(const std::filesystem::path& path) const
+    {
+        return file_system_ ? file_system_->status(path) : get_file_status(path);
+    }
+
+    SinglePathIterator::SinglePathIterator(std::filesystem::path path, bool has_next,
+                                           std::shared_ptr<EntryFilter> filter,
+                                           std::shared_ptr<FileSystem> file_system)
+        : PathPartIterator(std::move(file_system)),
+          path_(std::move(path)),
+          filter_(std::move(filter)),
           has_next_(has_next)
     {
     }
@@ -38,8 +63,31 @@ namespace Yglob
             return false;
 
         has_next_ = false;
-        current_path_ = base_path_ / path_;
-        return exists(current_path_);
+        current_path_ = base_path_;
+        if (!filter_)
+        {
+            current_path_ /= path_;
+            return get_status(current_path_).exists();
+        }
+
+        // The base path has already been through the filter, but each
+        // of the components added here must be checked like the
+        // entries other iterators read.
+        auto last = --path_.end();
+        for (auto it = path_.begin(); it != last; ++it)
+        {
+            current_path_ /= *it;
+            if (it->has_filename() && filter_->is_excluded(current_path_, true))
+                return false;
+        }
+        current_path_ /= *last;
+        auto status = get_status(current_path_);
+        if (!status.exists())
+            return false;
+        return !last->has_filename()
+               || !filter_->is_excluded(
+                   current_path_,
+                   status.type == std::filesystem::file_type::directory);
     }
 
     const std::filesystem::path& SinglePathIterator::path() const
@@ -48,23 +96,25 @@ namespace Yglob
     }
 
     GlobIterator::GlobIterator(GlobMatcher matcher,
-                               std::filesystem::directory_options options)
-        : matcher_(std::move(matcher)),
-          options_(options)
+                               std::filesystem::directory_options options,
+                               std::shared_ptr<EntryFilter> filter,
+                               std::shared_ptr<FileSystem> file_system)
+        : PathPartIterator(std::move(file_system)),
+          matcher_(std::move(matcher)),
+          options_(options),
+          filter_(std::move(filter))
     {}
 
     bool GlobIterator::next()
     {
-        while (it_ != end_)
+        while (!is_stopped() && reader_.next())
         {
-            auto filename = it_->path().filename().generic_u8string();
-            if (matcher_.match(ystring::to_string_view(filename)))
+            if (matcher_.match(reader_.name())
+                && (!filter_ || !filter_->is_excluded(reader_)))
             {
-                current_path_ = it_->path();
-                ++it_;
+                current_path_ = reader_.path();
                 return true;
             }
-            ++it_;
         }
         return false;
     }
@@ -72,8 +122,7 @@ namespace Yglob
     void GlobIterator::set_base_path(std::filesystem::path base_path)
     {
         base_path_ = std::move(base_path);
-        it_ = std::filesystem::directory_iterator(base_path_, options_);
-        end_ = end(it_);
+        reader_ = DirectoryReader(base_path_, options_, file_system_.get());
     }
 
     const std::filesystem::path& GlobIterator::path() const
@@ -82,29 +131,73 @@ namespace Yglob
     }
 
     DoubleStarIterator::DoubleStarIterator(PathMatcher matcher,
-                                           std::filesystem::directory_options options)
-        : matcher_(std::move(matcher)),
-          options_(options)
+                                           std::filesystem::directory_options options,
+                                           std::shared_ptr<EntryFilter> filter,
+                                           std::shared_ptr<FileSystem> file_system)
+        : PathPartIterator(std::move(file_system)),
+          matcher_(std::move(matcher)),
+          options_(options),
+          filter_(std::move(filter))
     {}
 
     void DoubleStarIterator::set_base_path(std::filesystem::path base_path)
     {
         base_path_ = std::move(base_path);
-        it_ = std::filesystem::recursive_directory_iterator(base_path_, options_);
-        end_ = end(it_);
+        readers_.clear();
+        readers_.emplace_back(base_path_, options_, file_system_.get());
+        all_match_depth_ = -1;
     }
 
     bool DoubleStarIterator::next()
     {
-        while (it_ != end_)
+        while (!readers_.empty() && !is_stopped())
         {
-            if (matcher_.match(it_->path()))
+            auto& reader = readers_.back();
+            if (!reader.next())
             {
-                current_path_ = it_->path();
-                ++it_;
-                return true;
+                readers_.pop_back();
+                continue;
+            }
+
+            const int depth = int(readers_.size()) - 1;
+            if (all_match_depth_ >= depth)
+                all_match_depth_ = -1;
+
+            if (filter_ && filter_->is_excluded(reader))
+                continue;
+
+            // Inside a directory where everything matches there is no
+            // need to check the entries.
+            const bool is_match = all_match_depth_ >= 0
+                                  || matcher_.match(reader.path());
+
+            // Like recursive_directory_iterator, symbolic links to
+            // directories aren't followed.
+            bool descend = false;
+            if (reader.is_directory() && !reader.is_symlink())
+            {
+                if (all_match_depth_ >= 0)
+                {
+                    descend = true;
+                }
+                else if (matcher_.may_match_below(reader.path()))
+                {
+                    descend = true;
+                    if (matcher_.matches_all_below(reader.path()))
+                        all_match_depth_ = depth;
+                }
             }
-            ++it_;
+
+            if (is_match)
+                current_path_ = reader.path();
+            if (descend)
+            {
+                // Adding a reader invalidates the reference to reader.
+                std::filesystem::path dir = reader.path();
+                readers_.emplace_back(std::move(dir), options_, file_system_.get());
+            }
+            if (is_match)
+                return true;
         }
         return false;
     }
@@ -9,12 +9,22 @@
 #include <Ystring/Algorithms.hpp>
 #include "Yglob/GlobMatcher.hpp"
 #include "Yglob/PathMatcher.hpp"
+#include "DirectoryReader.hpp"
+#include "EntryFilter.hpp"
+#include "StopCondition.hpp"
 
 namespace Yglob
 {
     class PathPartIterator
     {
     public:
+        /**
+         * @brief Creates an iterator that reads from @a file_system, or
+         *      directly from the operating system's file system if it
+         *      is null.
+         */
+        explicit PathPartIterator(std::shared_ptr<FileSystem> file_system = {});
+
         virtual ~PathPartIterator() = default;
 
         virtual void set_base_path(std::filesystem::path base_path) = 0;
@@ -25,12 +35,26 @@ namespace Yglob
 
         [[nodiscard]]
         virtual const std::filesystem::path& path() const = 0;
+
+        void set_stop_condition(std::shared_ptr<StopCondition> condition);
+    protected:
+        [[nodiscard]]
+        bool is_stopped() const;
+
+        [[nodiscard]]
+        FileSystem::Status get_status(const std::filesystem::path& path) const;
+
+        std::shared_ptr<FileSystem> file_system_;
+    private:
+        std::shared_ptr<StopCondition> stop_condition_;
     };
 
     class SinglePathIterator : public PathPartIterator
     {
     public:
-        SinglePathIterator(std::filesystem::path path, bool has_next);
+        SinglePathIterator(std::filesystem::path path, bool has_next,
+                           std::shared_ptr<EntryFilter> filter = {},
+                           std::shared_ptr<FileSystem> file_system = {});
 
         void set_base_path(std::filesystem::path base_path) override;
 
@@ -43,6 +67,7 @@ namespace Yglob
         std::filesystem::path base_path_;
         std::filesystem::path path_;
         std::filesystem::path current_path_;
+        std::shared_ptr<EntryFilter> filter_;
         bool has_next_ = true;
     };
 
@@ -50,7 +75,9 @@ namespace Yglob
     {
     public:
         GlobIterator(GlobMatcher matcher,
-                     std::filesystem::directory_options options);
+                     std::filesystem::directory_options options,
+                     std::shared_ptr<EntryFilter> filter = {},
+                     std::shared_ptr<FileSystem> file_system = {});
 
         bool next() override;
 
@@ -60,19 +87,21 @@ namespace Yglob
         const std::filesystem::path& path() const override;
 
     private:
-        std::filesystem::directory_iterator it_;
-        std::filesystem::directory_iterator end_;
+        DirectoryReader reader_;
         std::filesystem::path base_path_;
         std::filesystem::path current_path_;
         GlobMatcher matcher_;
         std::filesystem::directory_options options_;
+        std::shared_ptr<EntryFilter> filter_;
     };
 
     class DoubleStarIterator : public PathPartIterator
     {
     public:
         DoubleStarIterator(PathMatcher matcher,
-                           std::filesystem::directory_options options);
+                           std::filesystem::directory_options options,
+                           std::shared_ptr<EntryFilter> filter = {},
+                           std::shared_ptr<FileSystem> file_system = {});
 
         void set_base_path(std::filesystem::path base_path) override;
 
@@ -82,11 +111,20 @@ namespace Yglob
         const std::filesystem::path& path() const override;
 
     private:
-        std::filesystem::recursive_directory_iterator it_;
-        std::filesystem::recursive_directory_iterator end_;
+        /**
+         * @brief The readers for the directories from base_path_ down to
+         *      the current one.
+         */
+        std::vector<DirectoryReader> readers_;
         std::filesystem::path base_path_;
         std::filesystem::path current_path_;
         PathMatcher matcher_;
         std::filesystem::directory_options options_;
+        std::shared_ptr<EntryFilter> filter_;
+        /**
+         * @brief The depth of the directory below which all entries
+         *      match, or -1.
+         */
+        int all_match_depth_ = -1;
     };
 }
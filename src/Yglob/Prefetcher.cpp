@@ -0,0 +1,102 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Prefetcher.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace Yglob
+{
+    Prefetcher::Prefetcher(PathIterator source, size_t max_buffered)
+        : source_(std::move(source)),
+          max_buffered_(std::max<size_t>(max_buffered, 1))
+    {}
+
+    Prefetcher::~Prefetcher()
+    {
+        {
+            std::scoped_lock lock(mutex_);
+            is_stopped_ = true;
+        }
+        can_produce_.notify_all();
+        if (thread_.joinable())
+            thread_.join();
+    }
+
+    bool Prefetcher::next()
+    {
+        // The thread is started here rather than in the constructor to
+        // let the caller finish configuring the source first.
+        if (!thread_.joinable())
+            thread_ = std::thread([this] {run();});
+
+        if (entries_.empty())
+        {
+            // Take everything that has been found so far, to lock the
+            // mutex once per batch rather than once per path.
+            std::unique_lock lock(mutex_);
+            taken_ = 0;
+            can_produce_.notify_all();
+            can_consume_.wait(lock, [&] {return !buffer_.empty() || is_done_;});
+            if (buffer_.empty())
+            {
+                current_ = {};
+                if (error_)
+                    std::rethrow_exception(std::exchange(error_, nullptr));
+                return false;
+            }
+            std::swap(entries_, buffer_);
+            taken_ = entries_.size();
+        }
+
+        current_ = std::move(entries_.front());
+        entries_.pop_front();
+        return true;
+    }
+
+    const std::filesystem::path& Prefetcher::path() const
+    {
+        return current_.path;
+    }
+
+    const std::vector<size_t>& Prefetcher::pattern_indexes() const
+    {
+        return current_.pattern_indexes;
+    }
+
+    void Prefetcher::run()
+    {
+        try
+        {
+            while (source_.next())
+            {
+                Entry entry{source_.path(), source_.pattern_indexes()};
+                std::unique_lock lock(mutex_);
+                can_produce_.wait(lock, [&]
+                {
+                    return buffer_.size() + taken_ < max_buffered_
+                           || is_stopped_;
+                });
+                if (is_stopped_)
+                    return;
+                buffer_.push_back(std::move(entry));
+                if (buffer_.size() == 1)
+                    can_consume_.notify_one();
+            }
+        }
+        catch (...)
+        {
+            std::scoped_lock lock(mutex_);
+            error_ = std::current_exception();
+        }
+
+        std::scoped_lock lock(mutex_);
+        is_done_ = true;
+        can_consume_.notify_one();
+    }
+}
@@ -0,0 +1,73 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include "Yglob/PathIterator.hpp"
+
+namespace Yglob
+{
+    /**
+     * @brief Runs a PathIterator on a background thread and buffers the
+     *      paths it produces, in the same order.
+     *
+     * The background thread stops when @a max_buffered paths have been
+     * found but not yet returned by next(), which bounds how far ahead
+     * of the consumer it reads.
+     */
+    class Prefetcher
+    {
+    public:
+        Prefetcher(PathIterator source, size_t max_buffered);
+
+        ~Prefetcher();
+
+        Prefetcher(const Prefetcher&) = delete;
+
+        Prefetcher& operator=(const Prefetcher&) = delete;
+
+        bool next();
+
+        [[nodiscard]]
+        const std::filesystem::path& path() const;
+
+        [[nodiscard]]
+        const std::vector<size_t>& pattern_indexes() const;
+    private:
+        struct Entry
+        {
+            std::filesystem::path path;
+            std::vector<size_t> pattern_indexes;
+        };
+
+        void run();
+
+        PathIterator source_;
+        size_t max_buffered_;
+
+        std::mutex mutex_;
+        std::condition_variable can_produce_;
+        std::condition_variable can_consume_;
+        std::deque<Entry> buffer_;
+        // The number of entries the consumer has taken from buffer_
+        // but not yet returned.
+        size_t taken_ = 0;
+        bool is_done_ = false;
+        bool is_stopped_ = false;
+        std::exception_ptr error_;
+
+        // Only used by the thread that calls next().
+        std::deque<Entry> entries_;
+        Entry current_;
+
+        std::thread thread_;
+    };
+}
@@ -0,0 +1,46 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yglob/RealFileSystem.hpp"
+
+#include <Ystring/Algorithms.hpp>
+#include "FileStatusBatch.hpp"
+
+namespace Yglob
+{
+    std::shared_ptr<const FileSystem::Listing>
+    RealFileSystem::list_directory(const std::filesystem::path& directory,
+                                   std::filesystem::directory_options options)
+    {
+        auto listing = std::make_shared<Listing>();
+        auto dir = directory.empty() ? std::filesystem::path(".") : directory;
+        for (const auto& entry : std::filesystem::directory_iterator(dir, options))
+        {
+            std::error_code ec;
+            auto name = entry.path().filename().generic_u8string();
+            Entry& result = listing->emplace_back();
+            result.name.assign(ystring::to_string_view(name));
+            // Only symbolic links and entries of unknown type require
+            // another system call, for the others the type is known from
+            // reading the directory.
+            result.is_symlink = entry.is_symlink(ec);
+            result.type = get_file_type(entry);
+        }
+        return listing;
+    }
+
+    FileSystem::Status RealFileSystem::status(const std::filesystem::path& path)
+    {
+        return get_file_status(path);
+    }
+
+    void RealFileSystem::get_statuses(const std::vector<std::filesystem::path>& paths,
+                                      std::vector<Status>& statuses)
+    {
+        get_file_statuses(paths, statuses);
+    }
+}
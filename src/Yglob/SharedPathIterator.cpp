@@ -0,0 +1,114 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yglob/SharedPathIterator.hpp"
+
+#include <mutex>
+#include "ParallelWalker.hpp"
+
+namespace Yglob
+{
+    namespace
+    {
+        ParallelOptions make_unordered(ParallelOptions options)
+        {
+            options.ordered = false;
+            return options;
+        }
+    }
+
+    class SharedPathIterator::SharedPathIteratorImpl
+    {
+    public:
+        SharedPathIteratorImpl(const std::vector<std::filesystem::path>& glob_paths,
+                               const std::vector<std::string>& exclude_patterns,
+                               PathIteratorFlags flags,
+                               const ParallelOptions& parallel)
+            : walker_(glob_paths, flags,
+                      make_entry_filter(exclude_patterns, flags), nullptr,
+                      make_unordered(parallel))
+        {}
+
+        bool try_next(std::filesystem::path& path)
+        {
+            // Threads that wait for the lock would otherwise wait for
+            // the next batch, there is no point in releasing it.
+            std::scoped_lock lock(mutex_);
+            while (index_ == batch_.size())
+            {
+                if (!walker_.next_batch(batch_))
+                    return false;
+                index_ = 0;
+            }
+            path = std::move(batch_[index_++].path);
+            return true;
+        }
+
+        bool try_next_batch(std::vector<std::filesystem::path>& paths)
+        {
+            paths.clear();
+            {
+                // Take what remains of the batch try_next() is using.
+                std::scoped_lock lock(mutex_);
+                for (; index_ < batch_.size(); ++index_)
+                    paths.push_back(std::move(batch_[index_].path));
+                if (!paths.empty())
+                    return true;
+            }
+
+            std::vector<ParallelWalker::Match> batch;
+            if (!walker_.next_batch(batch))
+                return false;
+            paths.reserve(batch.size());
+            for (auto& match : batch)
+                paths.push_back(std::move(match.path));
+            return true;
+        }
+
+        void stop()
+        {
+            walker_.stop();
+        }
+    private:
+        ParallelWalker walker_;
+        std::mutex mutex_;
+        std::vector<ParallelWalker::Match> batch_;
+        size_t index_ = 0;
+    };
+
+    SharedPathIterator::SharedPathIterator(const std::filesystem::path& glob_path,
+                                           PathIteratorFlags flags)
+        : SharedPathIterator(std::vector{glob_path}, {}, flags)
+    {}
+
+    SharedPathIterator::SharedPathIterator(
+            const std::vector<std::filesystem::path>& glob_paths,
+            const std::vector<std::string>& exclude_patterns,
+            PathIteratorFlags flags,
+            const ParallelOptions& parallel)
+        : impl_(std::make_unique<SharedPathIteratorImpl>(glob_paths,
+                                                         exclude_patterns,
+                                                         flags, parallel))
+    {}
+
+    SharedPathIterator::~SharedPathIterator() = default;
+
+    bool SharedPathIterator::try_next(std::filesystem::path& path)
+    {
+        return impl_->try_next(path);
+    }
+
+    bool SharedPathIterator::try_next_batch(std::vector<std::filesystem::path>& paths)
+    {
+        return impl_->try_next_batch(paths);
+    }
+
+    void SharedPathIterator::stop()
+    {
+        impl_->stop();
+    }
+}
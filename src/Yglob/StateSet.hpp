@@ -0,0 +1,155 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace Yglob
+{
+    /**
+     * @brief A set of automaton states.
+     *
+     * The first 64 states are stored inline, sets with more states
+     * allocate memory for the rest.
+     */
+    class StateSet
+    {
+    public:
+        using allocator_type = std::pmr::polymorphic_allocator<>;
+
+        static constexpr size_t NPOS = SIZE_MAX;
+
+        StateSet() = default;
+
+        explicit StateSet(const allocator_type& alloc)
+            : rest_(alloc)
+        {}
+
+        explicit StateSet(size_t size, const allocator_type& alloc = {})
+            : rest_(alloc),
+              size_(size)
+        {
+            if (size > BITS)
+                rest_.resize((size - 1) / BITS);
+        }
+
+        StateSet(const StateSet& rhs, const allocator_type& alloc)
+            : first_(rhs.first_),
+              rest_(rhs.rest_, alloc),
+              size_(rhs.size_)
+        {}
+
+        StateSet(StateSet&& rhs, const allocator_type& alloc)
+            : first_(rhs.first_),
+              rest_(std::move(rhs.rest_), alloc),
+              size_(rhs.size_)
+        {}
+
+        StateSet(const StateSet&) = default;
+
+        StateSet(StateSet&&) noexcept = default;
+
+        StateSet& operator=(const StateSet&) = default;
+
+        StateSet& operator=(StateSet&&) noexcept = default;
+
+        [[nodiscard]]
+        allocator_type get_allocator() const
+        {
+            return rest_.get_allocator();
+        }
+
+        [[nodiscard]]
+        size_t size() const
+        {
+            return size_;
+        }
+
+        [[nodiscard]]
+        bool test(size_t i) const
+        {
+            return (word(i) >> (i % BITS)) & 1u;
+        }
+
+        void set(size_t i)
+        {
+            word(i) |= uint64_t(1) << (i % BITS);
+        }
+
+        void reset(size_t i)
+        {
+            word(i) &= ~(uint64_t(1) << (i % BITS));
+        }
+
+        void clear()
+        {
+            first_ = 0;
+            for (auto& w : rest_)
+                w = 0;
+        }
+
+        [[nodiscard]]
+        bool empty() const
+        {
+            if (first_)
+                return false;
+            for (auto w : rest_)
+            {
+                if (w)
+                    return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Returns the index of the first state in the set that is
+         *      greater than or equal to @a i, or NPOS.
+         */
+        [[nodiscard]]
+        size_t find_next(size_t i) const
+        {
+            while (i < size_)
+            {
+                auto w = word(i) >> (i % BITS);
+                if (w)
+                    return i + size_t(std::countr_zero(w));
+                i = (i / BITS + 1) * BITS;
+            }
+            return NPOS;
+        }
+
+        StateSet& operator|=(const StateSet& rhs)
+        {
+            first_ |= rhs.first_;
+            for (size_t i = 0; i < rest_.size() && i < rhs.rest_.size(); ++i)
+                rest_[i] |= rhs.rest_[i];
+            return *this;
+        }
+
+        friend bool operator==(const StateSet&, const StateSet&) = default;
+    private:
+        static constexpr size_t BITS = 64;
+
+        [[nodiscard]]
+        uint64_t word(size_t i) const
+        {
+            return i < BITS ? first_ : rest_[i / BITS - 1];
+        }
+
+        uint64_t& word(size_t i)
+        {
+            return i < BITS ? first_ : rest_[i / BITS - 1];
+        }
+
+        uint64_t first_ = 0;
+        std::pmr::vector<uint64_t> rest_;
+        size_t size_ = 0;
+    };
+}
@@ -0,0 +1,83 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <stop_token>
+#include "Yglob/PathIterator.hpp"
+
+namespace Yglob
+{
+    /**
+     * @brief Decides when a traversal must stop before it is complete,
+     *      because a stop has been requested or a deadline has passed.
+     *
+     * The walkers check the condition before each directory entry. The
+     * stop token and deadline must be set before the traversal starts,
+     * after that is_stopped() can be called from any thread.
+     */
+    class StopCondition
+    {
+    public:
+        void set_stop_token(std::stop_token token)
+        {
+            token_ = std::move(token);
+            is_active_ = token_.stop_possible() || has_deadline_;
+        }
+
+        void set_deadline(std::chrono::steady_clock::time_point deadline)
+        {
+            deadline_ = deadline;
+            has_deadline_ = true;
+            is_active_ = true;
+        }
+
+        /**
+         * @brief Returns true if the traversal must stop.
+         *
+         * The first reason for stopping is remembered, and the condition
+         * remains true once it has become true.
+         */
+        [[nodiscard]]
+        bool is_stopped()
+        {
+            if (!is_active_)
+                return false;
+            if (reason_.load(std::memory_order_relaxed) != IterationStatus::IN_PROGRESS)
+                return true;
+
+            IterationStatus reason;
+            if (token_.stop_requested())
+                reason = IterationStatus::CANCELLED;
+            else if (has_deadline_ && std::chrono::steady_clock::now() >= deadline_)
+                reason = IterationStatus::TIMED_OUT;
+            else
+                return false;
+
+            auto expected = IterationStatus::IN_PROGRESS;
+            reason_.compare_exchange_strong(expected, reason);
+            return true;
+        }
+
+        /**
+         * @brief Returns CANCELLED or TIMED_OUT if is_stopped() has
+         *      returned true, otherwise IN_PROGRESS.
+         */
+        [[nodiscard]]
+        IterationStatus reason() const
+        {
+            return reason_.load();
+        }
+    private:
+        std::stop_token token_;
+        std::chrono::steady_clock::time_point deadline_;
+        bool has_deadline_ = false;
+        bool is_active_ = false;
+        std::atomic<IterationStatus> reason_ = IterationStatus::IN_PROGRESS;
+    };
+}
@@ -0,0 +1,701 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yglob/TreeIndex.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <span>
+#include <Ystring/Algorithms.hpp>
+#include "Yglob/YglobException.hpp"
+#include "ComponentTrie.hpp"
+#include "FileStamp.hpp"
+#include "FlagConversion.hpp"
+#include "MappedFile.hpp"
+#include "PathComponents.hpp"
+
+namespace Yglob
+{
+    namespace
+    {
+        constexpr char MAGIC[8] = {'Y', 'G', 'L', 'O', 'B', 'I', 'D', 'X'};
+        constexpr uint32_t VERSION = 1;
+        constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+        constexpr uint32_t NO_DIRECTORY = UINT32_MAX;
+        /**
+         * @brief The time stored for directories that must be read again
+         *      by the next refresh.
+         */
+        constexpr int64_t UNKNOWN_TIME = INT64_MIN;
+
+        // The index file consists of a FileHeader, the root path (padded
+        // to a multiple of 8 bytes), the directories, the entries and
+        // finally the names.
+        struct FileHeader
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t byte_order;
+            uint64_t root_size;
+            uint64_t directory_count;
+            uint64_t entry_count;
+            uint64_t names_size;
+            uint64_t reserved[2];
+        };
+
+        struct IndexDirectory
+        {
+            uint64_t first_entry;
+            uint64_t entry_count;
+            int64_t modified;
+            int64_t changed;
+            uint64_t device;
+            uint64_t inode;
+        };
+
+        /**
+         * @brief A file or directory in the index.
+         *
+         * The entries in a directory are stored consecutively and are
+         * sorted by name.
+         */
+        struct IndexEntry
+        {
+            uint64_t name_offset;
+            uint32_t name_size;
+            /**
+             * @brief The entry's index among the directories, or
+             *      NO_DIRECTORY if it isn't a directory.
+             */
+            uint32_t directory;
+            uint64_t size;
+            int64_t modified;
+            uint8_t type;
+            uint8_t padding[7];
+        };
+
+        static_assert(sizeof(FileHeader) == 64);
+        static_assert(sizeof(IndexDirectory) == 48);
+        static_assert(sizeof(IndexEntry) == 40);
+
+        size_t align8(size_t n)
+        {
+            return (n + 7) & ~size_t(7);
+        }
+
+        std::string to_string(const std::filesystem::path& path)
+        {
+            return std::string(ystring::to_string_view(path.generic_u8string()));
+        }
+
+        std::filesystem::path from_string(std::string_view str)
+        {
+            return {std::u8string_view(reinterpret_cast<const char8_t*>(str.data()),
+                                       str.size())};
+        }
+
+        std::filesystem::path normalized_absolute(const std::filesystem::path& path)
+        {
+            auto result = std::filesystem::absolute(path).lexically_normal();
+            if (!result.has_filename() && result.has_relative_path())
+                result = result.parent_path();
+            return result;
+        }
+
+        /**
+         * @brief A read-only view of an index, either in memory or in a
+         *      mapped file.
+         */
+        struct IndexView
+        {
+            std::span<const IndexDirectory> directories;
+            std::span<const IndexEntry> entries;
+            std::string_view names;
+
+            [[nodiscard]]
+            std::string_view name(const IndexEntry& entry) const
+            {
+                return names.substr(entry.name_offset, entry.name_size);
+            }
+
+            [[nodiscard]]
+            std::span<const IndexEntry> children(uint32_t directory) const
+            {
+                const auto& dir = directories[directory];
+                return entries.subspan(dir.first_entry, dir.entry_count);
+            }
+
+            /**
+             * @brief Returns the entry named @a name in @a directory, or
+             *      null if there is none.
+             */
+            [[nodiscard]]
+            const IndexEntry* find(uint32_t directory, std::string_view name) const
+            {
+                auto entries = children(directory);
+                auto it = std::ranges::lower_bound(entries, name, {}, [&](auto& e)
+                {
+                    return this->name(e);
+                });
+                if (it == entries.end() || this->name(*it) != name)
+                    return nullptr;
+                return &*it;
+            }
+        };
+
+        /**
+         * @brief Builds an index breadth first, which places the entries
+         *      of each directory next to each other.
+         *
+         * When an old index is given, the contents of the directories
+         * that are unchanged since the old index was built are copied
+         * from it instead of being read.
+         */
+        class IndexBuilder
+        {
+        public:
+            explicit IndexBuilder(const IndexView* old = nullptr)
+                : old_(old)
+            {}
+
+            void build(const std::filesystem::path& root)
+            {
+                directories.emplace_back();
+                queue_.push_back({0, root, old_ ? 0 : NO_DIRECTORY});
+                while (!queue_.empty())
+                {
+                    auto pending = std::move(queue_.front());
+                    queue_.pop_front();
+                    build_directory(pending);
+                }
+            }
+
+            [[nodiscard]]
+            size_t directories_read() const
+            {
+                return directories_read_;
+            }
+
+            std::vector<IndexDirectory> directories;
+            std::vector<IndexEntry> entries;
+            std::string names;
+        private:
+            struct Pending
+            {
+                uint32_t directory;
+                std::filesystem::path path;
+                uint32_t old_directory;
+            };
+
+            void build_directory(const Pending& pending)
+            {
+                // The stamp is taken before the directory is read, changes
+                // made while it is read are then found by the next
+                // refresh.
+                auto stamp = get_file_stamp(pending.path);
+                auto& dir = directories[pending.directory];
+                dir.first_entry = entries.size();
+                dir.modified = dir.changed = UNKNOWN_TIME;
+                if (stamp && !is_recently_changed(*stamp))
+                {
+                    dir.modified = stamp->modified;
+                    dir.changed = stamp->changed;
+                    dir.device = stamp->device;
+                    dir.inode = stamp->inode;
+                }
+
+                if (pending.old_directory != NO_DIRECTORY && stamp
+                    && is_unchanged(old_->directories[pending.old_directory], *stamp))
+                {
+                    copy_directory(pending);
+                }
+                else
+                {
+                    read_directory(pending);
+                }
+
+                auto& done_dir = directories[pending.directory];
+                done_dir.entry_count = entries.size() - done_dir.first_entry;
+            }
+
+            void copy_directory(const Pending& pending)
+            {
+                for (const auto& old_entry : old_->children(pending.old_directory))
+                {
+                    auto name = old_->name(old_entry);
+                    auto& entry = add_entry(name);
+                    entry.size = old_entry.size;
+                    entry.modified = old_entry.modified;
+                    entry.type = old_entry.type;
+                    if (old_entry.directory != NO_DIRECTORY)
+                        add_directory(entry, pending.path, name, old_entry.directory);
+                }
+            }
+
+            void read_directory(const Pending& pending)
+            {
+                ++directories_read_;
+                std::vector<std::pair<std::string, FileStamp>> children;
+                std::error_code ec;
+                std::filesystem::directory_iterator it(
+                    pending.path,
+                    std::filesystem::directory_options::skip_permission_denied,
+                    ec);
+                for (; !ec && it != std::filesystem::directory_iterator(); it.increment(ec))
+                {
+                    auto stamp = get_file_stamp(it->path(), false);
+                    if (stamp)
+                        children.emplace_back(to_string(it->path().filename()), *stamp);
+                }
+                std::ranges::sort(children, {}, [](auto& c) {return c.first;});
+
+                for (const auto& [name, stamp] : children)
+                {
+                    auto& entry = add_entry(name);
+                    entry.size = stamp.size;
+                    entry.modified = stamp.modified;
+                    entry.type = encode_file_type(stamp.type);
+                    if (stamp.type == std::filesystem::file_type::directory)
+                        add_directory(entry, pending.path, name, find_old(pending, name));
+                }
+            }
+
+            IndexEntry& add_entry(std::string_view name)
+            {
+                auto& entry = entries.emplace_back();
+                entry.name_offset = names.size();
+                entry.name_size = uint32_t(name.size());
+                entry.directory = NO_DIRECTORY;
+                names.append(name);
+                return entry;
+            }
+
+            void add_directory(IndexEntry& entry, const std::filesystem::path& parent,
+                               std::string_view name, uint32_t old_directory)
+            {
+                entry.directory = uint32_t(directories.size());
+                directories.emplace_back();
+                queue_.push_back({entry.directory, parent / from_string(name),
+                                  old_directory});
+            }
+
+            [[nodiscard]]
+            uint32_t find_old(const Pending& pending, std::string_view name) const
+            {
+                if (pending.old_directory == NO_DIRECTORY)
+                    return NO_DIRECTORY;
+                auto entry = old_->find(pending.old_directory, name);
+                return entry ? entry->directory : NO_DIRECTORY;
+            }
+
+            static bool is_unchanged(const IndexDirectory& dir, const FileStamp& stamp)
+            {
+                return dir.modified != UNKNOWN_TIME
+                       && dir.modified == stamp.modified
+                       && dir.changed == stamp.changed
+                       && dir.device == stamp.device
+                       && dir.inode == stamp.inode;
+            }
+
+            const IndexView* old_;
+            std::deque<Pending> queue_;
+            size_t directories_read_ = 0;
+        };
+
+        template <typename T>
+        void write_array(std::ostream& stream, const T* data, size_t count)
+        {
+            stream.write(reinterpret_cast<const char*>(data),
+                         std::streamsize(count * sizeof(T)));
+        }
+    }
+
+    class TreeIndex::TreeIndexImpl
+    {
+    public:
+        TreeIndexImpl() = default;
+
+        explicit TreeIndexImpl(const std::filesystem::path& root)
+            : root_(normalized_absolute(root))
+        {
+            if (!std::filesystem::is_directory(root_))
+                YGLOB_THROW("The root of a TreeIndex must be a directory.");
+            IndexBuilder builder;
+            builder.build(root_);
+            adopt(builder);
+        }
+
+        explicit TreeIndexImpl(MappedFile file)
+            : file_(std::move(file))
+        {
+            auto data = file_.data();
+            FileHeader header;
+            if (data.size() < sizeof(header))
+                YGLOB_THROW("The file is too small to be a TreeIndex.");
+            std::memcpy(&header, data.data(), sizeof(header));
+            if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+                YGLOB_THROW("The file is not a TreeIndex.");
+            if (header.byte_order != BYTE_ORDER_MARK)
+                YGLOB_THROW("The TreeIndex was made on a system with a different byte order.");
+            if (header.version != VERSION)
+                YGLOB_THROW("Unsupported TreeIndex version.");
+
+            auto size = data.size();
+            auto fits = [&](uint64_t offset, uint64_t count, uint64_t item_size)
+            {
+                return offset <= size && count <= (size - offset) / item_size;
+            };
+
+            uint64_t offset = sizeof(header);
+            if (!fits(offset, header.root_size, 1))
+                YGLOB_THROW("The TreeIndex is truncated.");
+            root_ = from_string(data.substr(offset, header.root_size));
+            offset += align8(header.root_size);
+            if (!fits(offset, header.directory_count, sizeof(IndexDirectory)))
+                YGLOB_THROW("The TreeIndex is truncated.");
+            view_.directories = {reinterpret_cast<const IndexDirectory*>(data.data() + offset),
+                                 size_t(header.directory_count)};
+            offset += header.directory_count * sizeof(IndexDirectory);
+            if (!fits(offset, header.entry_count, sizeof(IndexEntry)))
+                YGLOB_THROW("The TreeIndex is truncated.");
+            view_.entries = {reinterpret_cast<const IndexEntry*>(data.data() + offset),
+                             size_t(header.entry_count)};
+            offset += header.entry_count * sizeof(IndexEntry);
+            if (!fits(offset, header.names_size, 1))
+                YGLOB_THROW("The TreeIndex is truncated.");
+            view_.names = data.substr(offset, header.names_size);
+
+            if (!is_consistent())
+                YGLOB_THROW("The TreeIndex is corrupt.");
+        }
+
+        void save(const std::filesystem::path& file_path) const
+        {
+            std::ofstream stream(file_path, std::ios::binary | std::ios::trunc);
+            if (!stream)
+                YGLOB_THROW("Unable to create the TreeIndex file.");
+
+            auto root = to_string(root_);
+            FileHeader header = {};
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = VERSION;
+            header.byte_order = BYTE_ORDER_MARK;
+            header.root_size = root.size();
+            header.directory_count = view_.directories.size();
+            header.entry_count = view_.entries.size();
+            header.names_size = view_.names.size();
+            write_array(stream, &header, 1);
+            root.resize(align8(root.size()));
+            write_array(stream, root.data(), root.size());
+            write_array(stream, view_.directories.data(), view_.directories.size());
+            write_array(stream, view_.entries.data(), view_.entries.size());
+            write_array(stream, view_.names.data(), view_.names.size());
+            if (!stream.flush())
+                YGLOB_THROW("Unable to write the TreeIndex file.");
+        }
+
+        size_t refresh()
+        {
+            if (root_.empty())
+                return 0;
+            IndexBuilder builder(&view_);
+            builder.build(root_);
+            adopt(builder);
+            return builder.directories_read();
+        }
+
+        [[nodiscard]]
+        const std::filesystem::path& root() const
+        {
+            return root_;
+        }
+
+        [[nodiscard]]
+        size_t size() const
+        {
+            return view_.entries.size();
+        }
+
+        [[nodiscard]]
+        std::vector<Entry> find(const std::vector<std::filesystem::path>& glob_paths,
+                                PathIteratorFlags flags) const
+        {
+            std::vector<Entry> result;
+            if (view_.directories.empty())
+                return result;
+
+            ComponentTrie trie;
+            for (size_t i = 0; i < glob_paths.size(); ++i)
+            {
+                trie.add(glob_paths[i], to_glob_flags(flags),
+                         to_literal_flags(flags), i);
+            }
+
+            std::vector<Frame> stack;
+            push_absolute_frames(trie, stack);
+            if (trie.node(0).has_successors())
+            {
+                Frame frame;
+                trie.add_with_closure(0, frame.nodes);
+                stack.push_back(std::move(frame));
+            }
+
+            ComponentTrie::NodeList next_nodes;
+            while (!stack.empty())
+            {
+                auto frame = std::move(stack.back());
+                stack.pop_back();
+
+                auto visit = [&](const IndexEntry& entry)
+                {
+                    auto name = view_.name(entry);
+                    trie.advance(frame.nodes, name, next_nodes);
+                    if (next_nodes.empty())
+                        return;
+
+                    bool is_match = false;
+                    bool has_successors = false;
+                    for (auto index : next_nodes)
+                    {
+                        const auto& node = trie.node(index);
+                        is_match = is_match || !node.patterns.empty();
+                        has_successors = has_successors || node.has_successors();
+                    }
+
+                    auto path = frame.prefix.empty() ? from_string(name)
+                                                     : frame.prefix / from_string(name);
+                    auto type = decode_file_type(entry.type);
+                    if (is_match && is_acceptable(type, flags))
+                        result.push_back({path, type, entry.size, entry.modified});
+                    if (entry.directory != NO_DIRECTORY && has_successors)
+                        stack.push_back({entry.directory, next_nodes, std::move(path)});
+                };
+
+                if (has_only_plain_names(trie, frame.nodes))
+                {
+                    for (auto name : get_plain_names(trie, frame.nodes))
+                    {
+                        if (auto entry = view_.find(frame.directory, name))
+                            visit(*entry);
+                    }
+                }
+                else
+                {
+                    for (const auto& entry : view_.children(frame.directory))
+                        visit(entry);
+                }
+            }
+            return result;
+        }
+    private:
+        struct Frame
+        {
+            uint32_t directory = 0;
+            ComponentTrie::NodeList nodes;
+            std::filesystem::path prefix;
+        };
+
+        void adopt(IndexBuilder& builder)
+        {
+            directories_ = std::move(builder.directories);
+            entries_ = std::move(builder.entries);
+            names_ = std::move(builder.names);
+            file_ = MappedFile();
+            view_ = {directories_, entries_, names_};
+        }
+
+        /**
+         * @brief Adds frames for the absolute glob paths that can match
+         *      paths below the root.
+         */
+        void push_absolute_frames(const ComponentTrie& trie,
+                                  std::vector<Frame>& stack) const
+        {
+            auto root_str = to_string(root_);
+            std::string_view root_path = root_str;
+            auto root_name = extract_root(root_path);
+            ComponentTrie::NodeList next_nodes;
+            for (const auto& [root, node] : trie.roots())
+            {
+                if (!is_same_root(root_name, root, false))
+                    continue;
+
+                Frame frame;
+                frame.prefix = root_;
+                trie.add_with_closure(node, frame.nodes);
+                auto path = root_path;
+                std::string_view name;
+                while (!frame.nodes.empty() && next_component(path, name))
+                {
+                    trie.advance(frame.nodes, name, next_nodes);
+                    frame.nodes.swap(next_nodes);
+                }
+                if (!frame.nodes.empty())
+                    stack.push_back(std::move(frame));
+            }
+        }
+
+        static bool has_only_plain_names(const ComponentTrie& trie,
+                                         const ComponentTrie::NodeList& nodes)
+        {
+            return std::ranges::all_of(nodes, [&](auto i)
+            {
+                return trie.node(i).has_only_plain_names();
+            });
+        }
+
+        static std::vector<std::string_view>
+        get_plain_names(const ComponentTrie& trie, const ComponentTrie::NodeList& nodes)
+        {
+            std::vector<std::string_view> result;
+            for (auto i : nodes)
+            {
+                for (const auto& [name, _] : trie.node(i).literals)
+                    result.emplace_back(name);
+            }
+            std::ranges::sort(result);
+            result.erase(std::unique(result.begin(), result.end()), result.end());
+            return result;
+        }
+
+        static bool is_acceptable(std::filesystem::file_type type,
+                                  PathIteratorFlags flags)
+        {
+            if (bool(flags & PathIteratorFlags::NO_DIRECTORIES)
+                && type == std::filesystem::file_type::directory)
+            {
+                return false;
+            }
+            if (bool(flags & PathIteratorFlags::NO_FILES)
+                && type == std::filesystem::file_type::regular)
+            {
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Returns true if all offsets and indexes in a loaded
+         *      index are within bounds, and the directories form a tree.
+         *
+         * Directories are numbered breadth-first, so every directory
+         * except the root must be referenced by exactly one entry, and
+         * that entry must be in a directory with a lower index. Anything
+         * else could make find() and refresh() loop forever.
+         */
+        [[nodiscard]]
+        bool is_consistent() const
+        {
+            if (view_.directories.empty() && !view_.entries.empty())
+                return false;
+            for (const auto& dir : view_.directories)
+            {
+                if (dir.first_entry > view_.entries.size()
+                    || dir.entry_count > view_.entries.size() - dir.first_entry)
+                {
+                    return false;
+                }
+            }
+            for (const auto& entry : view_.entries)
+            {
+                if (entry.name_offset > view_.names.size()
+                    || entry.name_size > view_.names.size() - entry.name_offset)
+                {
+                    return false;
+                }
+                if (entry.directory != NO_DIRECTORY
+                    && entry.directory >= view_.directories.size())
+                {
+                    return false;
+                }
+            }
+
+            std::vector<bool> is_referenced(view_.directories.size());
+            for (uint32_t i = 0; i < view_.directories.size(); ++i)
+            {
+                for (const auto& entry : view_.children(i))
+                {
+                    if (entry.directory == NO_DIRECTORY)
+                        continue;
+                    if (entry.directory <= i || is_referenced[entry.directory])
+                        return false;
+                    is_referenced[entry.directory] = true;
+                }
+            }
+            for (size_t i = 1; i < is_referenced.size(); ++i)
+            {
+                if (!is_referenced[i])
+                    return false;
+            }
+            return true;
+        }
+
+        std::filesystem::path root_;
+        MappedFile file_;
+        std::vector<IndexDirectory> directories_;
+        std::vector<IndexEntry> entries_;
+        std::string names_;
+        IndexView view_;
+    };
+
+    TreeIndex::TreeIndex()
+        : impl_(std::make_unique<TreeIndexImpl>())
+    {}
+
+    TreeIndex::TreeIndex(const std::filesystem::path& root)
+        : impl_(std::make_unique<TreeIndexImpl>(root))
+    {}
+
+    TreeIndex::TreeIndex(TreeIndex&& rhs) noexcept = default;
+
+    TreeIndex::~TreeIndex() = default;
+
+    TreeIndex& TreeIndex::operator=(TreeIndex&& rhs) noexcept = default;
+
+    TreeIndex TreeIndex::load(const std::filesystem::path& file_path)
+    {
+        TreeIndex result;
+        result.impl_ = std::make_unique<TreeIndexImpl>(MappedFile(file_path));
+        return result;
+    }
+
+    void TreeIndex::save(const std::filesystem::path& file_path) const
+    {
+        impl_->save(file_path);
+    }
+
+    size_t TreeIndex::refresh()
+    {
+        return impl_->refresh();
+    }
+
+    const std::filesystem::path& TreeIndex::root() const
+    {
+        return impl_->root();
+    }
+
+    size_t TreeIndex::size() const
+    {
+        return impl_->size();
+    }
+
+    std::vector<TreeIndex::Entry>
+    TreeIndex::find(const std::filesystem::path& glob_path,
+                    PathIteratorFlags flags) const
+    {
+        return impl_->find({glob_path}, flags);
+    }
+
+    std::vector<TreeIndex::Entry>
+    TreeIndex::find(const std::vector<std::filesystem::path>& glob_paths,
+                    PathIteratorFlags flags) const
+    {
+        return impl_->find(glob_paths, flags);
+    }
+}
@@ -0,0 +1,117 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "WorkStealingPool.hpp"
+
+#include <algorithm>
+
+namespace Yglob
+{
+    namespace
+    {
+        /**
+         * @brief The pool and index of the worker running on the current
+         *      thread, if any.
+         */
+        thread_local const WorkStealingPool* current_pool = nullptr;
+        thread_local size_t current_index = 0;
+    }
+
+    WorkStealingPool::WorkStealingPool(unsigned thread_count)
+    {
+        thread_count = std::max(thread_count, 1u);
+        for (unsigned i = 0; i < thread_count; ++i)
+            workers_.push_back(std::make_unique<Worker>());
+        for (unsigned i = 0; i < thread_count; ++i)
+            threads_.emplace_back([this, i] {run(i);});
+    }
+
+    WorkStealingPool::~WorkStealingPool()
+    {
+        {
+            std::scoped_lock lock(mutex_);
+            stopped_ = true;
+        }
+        condition_.notify_all();
+        for (auto& thread : threads_)
+            thread.join();
+    }
+
+    void WorkStealingPool::submit(std::function<void()> task)
+    {
+        size_t index;
+        {
+            std::scoped_lock lock(mutex_);
+            if (stopped_)
+                return;
+            ++queued_;
+            index = current_pool == this
+                    ? current_index
+                    : next_worker_++ % workers_.size();
+        }
+
+        {
+            auto& worker = *workers_[index];
+            std::scoped_lock lock(worker.mutex);
+            worker.tasks.push_back(std::move(task));
+        }
+        condition_.notify_one();
+    }
+
+    void WorkStealingPool::run(size_t index)
+    {
+        current_pool = this;
+        current_index = index;
+        std::function<void()> task;
+        while (true)
+        {
+            if (pop(index, task))
+            {
+                task();
+                task = nullptr;
+                continue;
+            }
+
+            // queued_ is incremented before the task is added to a queue,
+            // the thread might have to look more than once.
+            std::unique_lock lock(mutex_);
+            condition_.wait(lock, [&] {return stopped_ || queued_ != 0;});
+            if (stopped_)
+                return;
+        }
+    }
+
+    bool WorkStealingPool::pop(size_t index, std::function<void()>& task)
+    {
+        for (size_t i = 0; i < workers_.size(); ++i)
+        {
+            auto& worker = *workers_[(index + i) % workers_.size()];
+            std::unique_lock lock(worker.mutex);
+            if (worker.tasks.empty())
+                continue;
+
+            // Take the newest task from our own queue, and the oldest
+            // one from the others.
+            if (i == 0)
+            {
+                task = std::move(worker.tasks.back());
+                worker.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(worker.tasks.front());
+                worker.tasks.pop_front();
+            }
+            lock.unlock();
+
+            std::scoped_lock queued_lock(mutex_);
+            --queued_;
+            return true;
+        }
+        return false;
+    }
+}
@@ -0,0 +1,62 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Yglob
+{
+    /**
+     * @brief A fixed set of threads that run submitted tasks.
+     *
+     * Each thread has its own queue. Tasks submitted by a task are added
+     * to the queue of the thread that runs it and are taken from the
+     * back, so a thread keeps working on the most recent part of the
+     * problem. Threads with empty queues steal the oldest tasks from the
+     * other threads.
+     *
+     * Tasks that haven't started when the pool is destroyed are
+     * discarded, the destructor waits for the running tasks.
+     */
+    class WorkStealingPool
+    {
+    public:
+        explicit WorkStealingPool(unsigned thread_count);
+
+        ~WorkStealingPool();
+
+        WorkStealingPool(const WorkStealingPool&) = delete;
+
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        void submit(std::function<void()> task);
+    private:
+        struct Worker
+        {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        void run(size_t index);
+
+        bool pop(size_t index, std::function<void()>& task);
+
+        std::vector<std::unique_ptr<Worker>> workers_;
+        std::vector<std::thread> threads_;
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        size_t queued_ = 0;
+        size_t next_worker_ = 0;
+        bool stopped_ = false;
+    };
+}
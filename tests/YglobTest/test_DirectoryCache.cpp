@@ -0,0 +1,121 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yglob/DirectoryCache.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <catch2/catch_test_macros.hpp>
+#include "Yglob/PathIterator.hpp"
+#include "TempFiles.hpp"
+
+namespace
+{
+    std::vector<std::string> get_names(const Yglob::DirectoryCache::Listing& listing)
+    {
+        std::vector<std::string> result;
+        for (const auto& entry : listing)
+            result.push_back(entry.name);
+        std::ranges::sort(result);
+        return result;
+    }
+
+    std::vector<std::filesystem::path> get_paths(Yglob::PathIterator it)
+    {
+        std::vector<std::filesystem::path> result;
+        while (it.next())
+            result.push_back(it.path());
+        std::ranges::sort(result);
+        return result;
+    }
+}
+
+TEST_CASE("DirectoryCache listing")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a.txt", "b/c.txt"});
+
+    Yglob::DirectoryCache cache;
+    auto listing = cache.listing(files.base_directory());
+    REQUIRE(get_names(*listing) == std::vector<std::string>{"a.txt", "b"});
+    for (const auto& entry : *listing)
+    {
+        auto expected = entry.name == "b" ? std::filesystem::file_type::directory
+                                          : std::filesystem::file_type::regular;
+        REQUIRE(entry.type == expected);
+        REQUIRE_FALSE(entry.is_symlink);
+    }
+    REQUIRE(cache.size() == 1);
+
+    cache.clear();
+    REQUIRE(cache.size() == 0);
+}
+
+TEST_CASE("DirectoryCache reuses unchanged listings")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a.txt", "b.txt"});
+
+    // Listings of directories that were just modified are not reused.
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    Yglob::DirectoryCache cache;
+    auto listing1 = cache.listing(files.base_directory());
+    auto listing2 = cache.listing(files.base_directory());
+    REQUIRE(listing1 == listing2);
+
+    files.make_file("c.txt");
+    auto listing3 = cache.listing(files.base_directory());
+    REQUIRE(get_names(*listing3) == std::vector<std::string>{"a.txt", "b.txt", "c.txt"});
+}
+
+TEST_CASE("DirectoryCache used from several threads")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a.txt", "b.txt", "c/d.txt"});
+
+    Yglob::DirectoryCache cache;
+    std::vector<std::shared_ptr<const Yglob::DirectoryCache::Listing>> listings(8);
+    {
+        std::vector<std::jthread> threads;
+        for (auto& listing : listings)
+        {
+            threads.emplace_back([&]
+            {
+                listing = cache.listing(files.base_directory());
+            });
+        }
+    }
+
+    for (const auto& listing : listings)
+    {
+        REQUIRE(listing);
+        REQUIRE(get_names(*listing) == std::vector<std::string>{"a.txt", "b.txt", "c"});
+    }
+}
+
+TEST_CASE("PathIterator with DirectoryCache")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a.txt", "b/c.txt", "b/d.md", "b/e/f.txt"});
+
+    auto cache = std::make_shared<Yglob::DirectoryCache>();
+    for (const auto& pattern : {"**/*.txt", "b/*", "*/*/*.txt"})
+    {
+        auto glob_path = files.get_path(pattern);
+        auto expected = get_paths(Yglob::PathIterator(glob_path));
+        REQUIRE(!expected.empty());
+        REQUIRE(get_paths(Yglob::PathIterator(glob_path, {}, {}, cache)) == expected);
+        // The second time, the listings come from the cache.
+        REQUIRE(get_paths(Yglob::PathIterator(glob_path, {}, {}, cache)) == expected);
+    }
+
+    std::vector<std::filesystem::path> glob_paths = {files.get_path("**/*.md"),
+                                                     files.get_path("b/e/*")};
+    REQUIRE(get_paths(Yglob::PathIterator(glob_paths, {}, {}, cache))
+            == std::vector{files.get_path("b/d.md"), files.get_path("b/e/f.txt")});
+}
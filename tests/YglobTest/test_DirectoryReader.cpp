@@ -0,0 +1,91 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yglob/DirectoryReader.hpp"
+
+#include <algorithm>
+#include <tuple>
+#include <catch2/catch_test_macros.hpp>
+#include "TempFiles.hpp"
+
+namespace
+{
+    using Entry = std::tuple<std::string, std::filesystem::path, bool, bool>;
+
+    std::vector<Entry> read_entries(Yglob::DirectoryReader reader)
+    {
+        std::vector<Entry> result;
+        while (reader.next())
+        {
+            result.emplace_back(std::string(reader.name()), reader.path(),
+                                reader.is_directory(), reader.is_symlink());
+        }
+        std::ranges::sort(result);
+        return result;
+    }
+
+    struct AutoCwd
+    {
+        explicit AutoCwd(const std::filesystem::path& path)
+            : prev_path(std::filesystem::current_path())
+        {
+            std::filesystem::current_path(path);
+        }
+
+        ~AutoCwd()
+        {
+            std::filesystem::current_path(prev_path);
+        }
+
+        std::filesystem::path prev_path;
+    };
+}
+
+TEST_CASE("DirectoryReader iterating over a directory")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a/b.txt", "a/c/d.txt"});
+    std::filesystem::create_directory_symlink(files.get_path("a/c"),
+                                              files.get_path("a/e"));
+    auto dir = files.get_path("a");
+
+    SECTION("Directory with a path")
+    {
+        // The paths are the directory iterator's own paths.
+        REQUIRE(read_entries(Yglob::DirectoryReader(dir, {}, nullptr))
+                == std::vector<Entry>{{"b.txt", dir / "b.txt", false, false},
+                                      {"c", dir / "c", true, false},
+                                      {"e", dir / "e", true, true}});
+    }
+
+    SECTION("Current directory")
+    {
+        AutoCwd cwd(dir);
+        REQUIRE(read_entries(Yglob::DirectoryReader({}, {}, nullptr))
+                == std::vector<Entry>{{"b.txt", "b.txt", false, false},
+                                      {"c", "c", true, false},
+                                      {"e", "e", true, true}});
+    }
+
+    SECTION("Path is valid until the next entry")
+    {
+        Yglob::DirectoryReader reader(dir, {}, nullptr);
+        size_t count = 0;
+        while (reader.next())
+        {
+            const auto& path = reader.path();
+            REQUIRE(path.filename() == reader.name());
+            REQUIRE(path.parent_path() == dir);
+            ++count;
+        }
+        REQUIRE(count == 3);
+        REQUIRE_FALSE(reader.next());
+    }
+
+    // TempFiles only removes the files and directories it created.
+    std::filesystem::remove(files.get_path("a/e"));
+}
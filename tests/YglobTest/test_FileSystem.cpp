@@ -0,0 +1,172 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yglob/MemoryFileSystem.hpp"
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include "Yglob/PathIterator.hpp"
+#include "Yglob/RealFileSystem.hpp"
+#include "Yglob/YglobException.hpp"
+#include "TempFiles.hpp"
+
+namespace
+{
+    using Paths = std::vector<std::filesystem::path>;
+
+    Paths get_paths(Yglob::PathIterator it)
+    {
+        Paths result;
+        while (it.next())
+            result.push_back(it.path());
+        std::ranges::sort(result);
+        return result;
+    }
+
+    std::shared_ptr<Yglob::MemoryFileSystem> make_file_system()
+    {
+        auto fs = std::make_shared<Yglob::MemoryFileSystem>();
+        fs->add_file("a/b.txt");
+        fs->add_file("a/c/d.txt");
+        fs->add_file("a/c/e.md");
+        fs->add_directory("a/f");
+        fs->add_file("g.txt");
+        fs->add_file("/abs/h.txt");
+        return fs;
+    }
+}
+
+TEST_CASE("MemoryFileSystem")
+{
+    auto fs = make_file_system();
+    REQUIRE(fs->size() == 9);
+
+    auto listing = fs->list_directory("a");
+    REQUIRE(listing->size() == 3);
+    REQUIRE((*listing)[0].name == "b.txt");
+    REQUIRE((*listing)[0].type == std::filesystem::file_type::regular);
+    REQUIRE((*listing)[1].name == "c");
+    REQUIRE((*listing)[1].type == std::filesystem::file_type::directory);
+
+    REQUIRE(fs->list_directory(".")->size() == 2);
+    REQUIRE(fs->list_directory("/")->size() == 1);
+    REQUIRE(fs->status("./a/c/../b.txt").type == std::filesystem::file_type::regular);
+    REQUIRE(fs->status("a/f/").type == std::filesystem::file_type::directory);
+    REQUIRE_FALSE(fs->exists("a/x"));
+    REQUIRE_FALSE(fs->exists("g.txt/x"));
+    REQUIRE_THROWS_AS(fs->list_directory("a/x"), std::filesystem::filesystem_error);
+    REQUIRE_THROWS_AS(fs->list_directory("g.txt"), std::filesystem::filesystem_error);
+
+    fs->add_directory("a/c");
+    REQUIRE_THROWS_AS(fs->add_file("a/b.txt"), Yglob::YglobException);
+    REQUIRE_THROWS_AS(fs->add_file("g.txt/i.txt"), Yglob::YglobException);
+
+    // Listings that have been returned are not changed by later additions.
+    fs->add_file("a/j.txt");
+    REQUIRE(listing->size() == 3);
+    REQUIRE(fs->list_directory("a")->size() == 4);
+}
+
+TEST_CASE("PathIterator on a MemoryFileSystem")
+{
+    auto fs = make_file_system();
+    auto flags = Yglob::PathIteratorFlags::DEFAULT;
+
+    REQUIRE(get_paths(Yglob::PathIterator("a/*/*.txt", {}, flags, fs))
+            == Paths{"a/c/d.txt"});
+    REQUIRE(get_paths(Yglob::PathIterator("**/*.txt", {}, flags, fs))
+            == Paths{"a/b.txt", "a/c/d.txt", "g.txt"});
+    REQUIRE(get_paths(Yglob::PathIterator("/abs/*", {}, flags, fs))
+            == Paths{"/abs/h.txt"});
+    REQUIRE(get_paths(Yglob::PathIterator("a/c/e.md", {}, flags, fs))
+            == Paths{"a/c/e.md"});
+    REQUIRE(get_paths(Yglob::PathIterator("a/*", {},
+                                          Yglob::PathIteratorFlags::NO_FILES, fs))
+            == Paths{"a/c", "a/f"});
+
+    REQUIRE(get_paths(Yglob::PathIterator(Paths{"a/*/*.md", "g.txt", "/abs/*.txt"},
+                                          {}, flags, fs))
+            == Paths{"a/c/e.md", "g.txt", "/abs/h.txt"});
+    REQUIRE(get_paths(Yglob::PathIterator(Paths{"a/**"}, {"a/c"},
+                                          Yglob::PathIteratorFlags::NO_DIRECTORIES,
+                                          fs))
+            == Paths{"a/b.txt"});
+}
+
+TEST_CASE("PathIterator on a large MemoryFileSystem")
+{
+    auto fs = std::make_shared<Yglob::MemoryFileSystem>();
+    for (int i = 0; i < 100; ++i)
+    {
+        for (int j = 0; j < 100; ++j)
+        {
+            auto dir = "d" + std::to_string(i) + "/e" + std::to_string(j);
+            fs->add_file(dir + "/a.txt");
+            fs->add_file(dir + "/b.md");
+        }
+    }
+
+    Yglob::PathIterator it(Paths{"d7/**/*.txt", "*/e42/*.md"}, {},
+                           Yglob::PathIteratorFlags::DEFAULT, fs);
+    size_t count = 0;
+    while (it.next())
+        ++count;
+    REQUIRE(count == 200);
+}
+
+TEST_CASE("PathIterator combining options on a MemoryFileSystem")
+{
+    auto fs = std::make_shared<Yglob::MemoryFileSystem>();
+    for (int i = 0; i < 10; ++i)
+    {
+        auto dir = "d" + std::to_string(i);
+        fs->add_file(dir + "/a.txt");
+        fs->add_file(dir + "/e/b.txt");
+    }
+    auto flags = Yglob::PathIteratorFlags::DEFAULT;
+    auto expected = get_paths(Yglob::PathIterator("**/*.txt", {}, flags, fs));
+    REQUIRE(expected.size() == 20);
+
+    for (bool parallel : {false, true})
+    {
+        Paths paths;
+        for (size_t index = 0; index < 4; ++index)
+        {
+            Yglob::PathIteratorOptions options;
+            options.file_system = fs;
+            if (parallel)
+            {
+                options.parallel.emplace();
+                options.parallel->thread_count = 2;
+            }
+            options.shard = Yglob::Shard(index, 4);
+            auto shard_paths = get_paths(Yglob::PathIterator("**/*.txt", {},
+                                                             flags, options));
+            REQUIRE(shard_paths.size() < expected.size());
+            paths.insert(paths.end(), shard_paths.begin(), shard_paths.end());
+        }
+        std::ranges::sort(paths);
+        REQUIRE(paths == expected);
+    }
+}
+
+TEST_CASE("PathIterator on a RealFileSystem")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a/b.txt", "a/c/d.txt", "e.md"});
+    auto glob_path = files.get_path("**/*.txt");
+
+    auto fs = std::make_shared<Yglob::RealFileSystem>();
+    auto expected = get_paths(Yglob::PathIterator(glob_path));
+    REQUIRE(expected.size() == 2);
+    REQUIRE(get_paths(Yglob::PathIterator(glob_path, {},
+                                          Yglob::PathIteratorFlags::DEFAULT, fs))
+            == expected);
+    REQUIRE(fs->status(files.get_path("a")).type
+            == std::filesystem::file_type::directory);
+    REQUIRE_FALSE(fs->exists(files.get_path("x")));
+}
@@ -7,6 +7,7 @@
 //****************************************************************************
 #include "Yglob/GlobMatcher.hpp"
 #include <catch2/catch_test_macros.hpp>
+#include "CountingResource.hpp"
 
 TEST_CASE("Test GlobMatcher with empty pattern")
 {
@@ -203,3 +204,143 @@ TEST_CASE("GlobMatcher with braces disabled")
     REQUIRE(matcher.match("ab{c,d,e}f"));
     REQUIRE(!matcher.match("abcf"));
 }
+
+TEST_CASE("Test is_subset")
+{
+    using namespace Yglob;
+    auto subset = [](std::string_view a, std::string_view b,
+                     GlobFlags flags = GlobFlags::CASE_SENSITIVE)
+    {
+        return is_subset(GlobMatcher(a, flags), GlobMatcher(b, flags));
+    };
+    REQUIRE(subset("app-*.log", "*.log"));
+    REQUIRE_FALSE(subset("*.log", "app-*.log"));
+    REQUIRE(subset("*.log", "*.log"));
+    REQUIRE(subset("a?c", "a*"));
+    REQUIRE(subset("[ab]x", "{a,b}?"));
+    REQUIRE(subset("{a,b}?", "[ab]x") == false);
+    REQUIRE(subset("[b-d]", "[a-z]"));
+    REQUIRE_FALSE(subset("[^x]", "[a-z]"));
+    REQUIRE(subset("**", "*"));
+    REQUIRE(subset("ABC", "abc", GlobFlags::DEFAULT));
+    REQUIRE_FALSE(subset("ABC", "abc"));
+    REQUIRE_FALSE(is_subset(GlobMatcher("a*"),
+                            GlobMatcher("a*", GlobFlags::CASE_SENSITIVE)));
+    REQUIRE(is_subset(GlobMatcher("a*", GlobFlags::CASE_SENSITIVE),
+                      GlobMatcher("A*")));
+}
+
+TEST_CASE("GlobMatcher with extended globs")
+{
+    using namespace Yglob;
+    const auto flags = GlobFlags::EXT_GLOBS | GlobFlags::CASE_SENSITIVE;
+
+    GlobMatcher not_generated("!(*_generated).cpp", flags);
+    REQUIRE(not_generated.match("main.cpp"));
+    REQUIRE(not_generated.match(".cpp"));
+    REQUIRE_FALSE(not_generated.match("parser_generated.cpp"));
+    REQUIRE_FALSE(not_generated.match("main.h"));
+
+    GlobMatcher one("@(foo|bar).txt", flags);
+    REQUIRE(one.match("foo.txt"));
+    REQUIRE(one.match("bar.txt"));
+    REQUIRE_FALSE(one.match("foobar.txt"));
+
+    GlobMatcher zero_or_one("a?(b|c)d", flags);
+    REQUIRE(zero_or_one.match("ad"));
+    REQUIRE(zero_or_one.match("acd"));
+    REQUIRE_FALSE(zero_or_one.match("abcd"));
+
+    GlobMatcher zero_or_more("a*(bc)d", flags);
+    REQUIRE(zero_or_more.match("ad"));
+    REQUIRE(zero_or_more.match("abcbcd"));
+    REQUIRE_FALSE(zero_or_more.match("abd"));
+
+    GlobMatcher one_or_more("+([0-9]).log", flags);
+    REQUIRE(one_or_more.match("2024.log"));
+    REQUIRE_FALSE(one_or_more.match(".log"));
+    REQUIRE_FALSE(one_or_more.match("v1.log"));
+
+    GlobMatcher star_before("x**(ab)", flags);
+    REQUIRE(star_before.match("xyab"));
+    REQUIRE(star_before.match("x"));
+
+    GlobMatcher qmark_before("x?\?(ab)", flags);
+    REQUIRE(qmark_before.match("xy"));
+    REQUIRE(qmark_before.match("xyab"));
+    REQUIRE_FALSE(qmark_before.match("x"));
+}
+
+TEST_CASE("GlobMatcher with nested extended globs")
+{
+    using namespace Yglob;
+    GlobMatcher matcher("!(!(a*)|ab*)", GlobFlags::EXT_GLOBS);
+    REQUIRE(matcher.match("a"));
+    REQUIRE(matcher.match("AXY"));
+    REQUIRE_FALSE(matcher.match("abc"));
+    REQUIRE_FALSE(matcher.match("b"));
+}
+
+TEST_CASE("GlobMatcher with extended globs disabled")
+{
+    using namespace Yglob;
+    GlobMatcher matcher("!(a|b)", GlobFlags::CASE_SENSITIVE);
+    REQUIRE(matcher.match("!(a|b)"));
+    REQUIRE_FALSE(matcher.match("c"));
+    REQUIRE_FALSE(is_glob_pattern("@(a)"));
+    REQUIRE(is_glob_pattern("@(a)", GlobFlags::EXT_GLOBS));
+}
+
+TEST_CASE("GlobMatchers with the same pattern share it")
+{
+    using namespace Yglob;
+    GlobMatcher a("[a-z]*.{c,h}");
+    GlobMatcher b("[a-z]*.{c,h}");
+    GlobMatcher c("[a-z]*.{c,h}", GlobFlags::CASE_SENSITIVE);
+    REQUIRE(a.match("x.C"));
+    REQUIRE(b.match("x.C"));
+    REQUIRE_FALSE(c.match("x.C"));
+    REQUIRE(a.memory_usage() == b.memory_usage());
+    REQUIRE(a.memory_usage() > sizeof(GlobMatcher));
+    REQUIRE(GlobMatcher().memory_usage() == sizeof(GlobMatcher));
+
+    GlobMatcher ext("!(*.c)", GlobFlags::EXT_GLOBS);
+    REQUIRE(ext.memory_usage() > GlobMatcher("*.c").memory_usage());
+
+    // The ranges in a set are on the heap.
+    REQUIRE(GlobMatcher("[a-ce-gx]*").memory_usage()
+            > GlobMatcher("?*").memory_usage());
+}
+
+TEST_CASE("GlobMatcher with a memory resource")
+{
+    using namespace Yglob;
+    CountingResource resource;
+
+    SECTION("Plain glob")
+    {
+        {
+            GlobMatcher matcher("abc*[x-z]?.txt", GlobFlags::DEFAULT, &resource);
+            REQUIRE(resource.allocations > 0);
+            REQUIRE(matcher.match("abcdefy1.TXT"));
+            REQUIRE_FALSE(matcher.match("abcdefa1.txt"));
+        }
+        REQUIRE(resource.bytes_in_use == 0);
+    }
+
+    SECTION("Extended glob with a long string")
+    {
+        {
+            GlobMatcher matcher("!(*.txt)", GlobFlags::EXT_GLOBS, &resource);
+            const auto allocations = resource.allocations;
+            REQUIRE(allocations > 0);
+            REQUIRE(matcher.match("abc.doc"));
+            REQUIRE_FALSE(matcher.match("abc.txt"));
+            // The string is too long for the matcher's buffer on the
+            // stack.
+            REQUIRE(matcher.match(std::string(10000, 'a')));
+            REQUIRE(resource.allocations > allocations);
+        }
+        REQUIRE(resource.bytes_in_use == 0);
+    }
+}
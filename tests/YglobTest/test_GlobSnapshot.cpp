@@ -0,0 +1,90 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yglob/GlobSnapshot.hpp"
+
+#include <fstream>
+#include <thread>
+#include <catch2/catch_test_macros.hpp>
+#include "Yglob/PathIterator.hpp"
+#include "Yglob/YglobException.hpp"
+#include "TempFiles.hpp"
+
+namespace
+{
+    using Paths = std::vector<std::filesystem::path>;
+}
+
+TEST_CASE("GlobSnapshot paths")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a.txt", "b/c.txt", "b/d.md", "b/e/f.txt"});
+
+    Yglob::GlobSnapshot snapshot({files.get_path("**/*.txt"),
+                                  files.get_path("b/*.txt")},
+                                 {"**/e"});
+    REQUIRE(snapshot.paths() == Paths{files.get_path("a.txt"),
+                                      files.get_path("b/c.txt")});
+    REQUIRE(snapshot.exclude_patterns() == std::vector<std::string>{"**/e"});
+}
+
+TEST_CASE("GlobSnapshot refresh")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a/b.txt", "c/d/e.txt", "c/d/f.txt", "c/g.txt"});
+
+    // Directories that changed just before they were read are always
+    // read again.
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    Yglob::GlobSnapshot snapshot({files.get_path("**/*.txt")});
+    REQUIRE(snapshot.paths().size() == 4);
+
+    auto unchanged = Yglob::PathIterator::refresh(snapshot);
+    REQUIRE(unchanged.snapshot.paths() == snapshot.paths());
+    REQUIRE(unchanged.added.empty());
+    REQUIRE(unchanged.removed.empty());
+
+    files.make_files({"c/d/h.txt", "c/i/j.txt"});
+    std::filesystem::remove(files.get_path("a/b.txt"));
+    auto changed = Yglob::PathIterator::refresh(unchanged.snapshot);
+    REQUIRE(changed.added == Paths{files.get_path("c/d/h.txt"),
+                                   files.get_path("c/i/j.txt")});
+    REQUIRE(changed.removed == Paths{files.get_path("a/b.txt")});
+    REQUIRE(changed.snapshot.paths()
+            == Paths{files.get_path("c/d/e.txt"),
+                     files.get_path("c/d/f.txt"),
+                     files.get_path("c/d/h.txt"),
+                     files.get_path("c/g.txt"),
+                     files.get_path("c/i/j.txt")});
+    files.make_file("a/b.txt");
+}
+
+TEST_CASE("GlobSnapshot save and load")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a.txt", "b/c.txt", "b/d/e.txt", "snapshot.bin"});
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    Yglob::GlobSnapshot snapshot({files.get_path("**/*.txt")}, {},
+                                 Yglob::PathIteratorFlags::NO_DIRECTORIES);
+    snapshot.save(files.get_path("snapshot.bin"));
+
+    auto loaded = Yglob::GlobSnapshot::load(files.get_path("snapshot.bin"));
+    REQUIRE(loaded.glob_paths() == snapshot.glob_paths());
+    REQUIRE(loaded.flags() == Yglob::PathIteratorFlags::NO_DIRECTORIES);
+    REQUIRE(loaded.paths() == snapshot.paths());
+
+    files.make_file("b/d/f.txt");
+    auto refreshed = Yglob::PathIterator::refresh(loaded);
+    REQUIRE(refreshed.added == Paths{files.get_path("b/d/f.txt")});
+    REQUIRE(refreshed.removed.empty());
+
+    std::ofstream(files.get_path("snapshot.bin")) << "not a snapshot";
+    REQUIRE_THROWS_AS(Yglob::GlobSnapshot::load(files.get_path("snapshot.bin")),
+                      Yglob::YglobException);
+}
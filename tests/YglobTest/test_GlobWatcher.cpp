@@ -0,0 +1,138 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yglob/GlobWatcher.hpp"
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include "TempFiles.hpp"
+
+namespace
+{
+    using Paths = std::vector<std::filesystem::path>;
+
+    std::vector<Yglob::GlobEvent> get_events(Yglob::GlobWatcher& watcher)
+    {
+        auto events = watcher.poll(std::chrono::seconds(1));
+        std::ranges::sort(events, [](auto& a, auto& b) {return a.path < b.path;});
+        return events;
+    }
+}
+
+TEST_CASE("GlobWatcher events")
+{
+    if (!Yglob::GlobWatcher::is_supported())
+        return;
+
+    TempFiles files("YglobTest", true);
+    files.make_files({"incoming/a/1.csv", "incoming/a/2.txt", "other/3.csv"});
+
+    Yglob::GlobWatcher watcher(files.get_path("incoming/*/*.csv"));
+    REQUIRE(watcher.paths() == Paths{files.get_path("incoming/a/1.csv")});
+    REQUIRE(watcher.poll().empty());
+
+    SECTION("Files are created and deleted")
+    {
+        files.make_files({"incoming/a/4.csv", "incoming/a/5.txt"});
+        auto events = get_events(watcher);
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].type == Yglob::GlobEventType::CREATED);
+        REQUIRE(events[0].path == files.get_path("incoming/a/4.csv"));
+
+        std::filesystem::remove(files.get_path("incoming/a/1.csv"));
+        events = get_events(watcher);
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].type == Yglob::GlobEventType::DELETED);
+        REQUIRE(events[0].path == files.get_path("incoming/a/1.csv"));
+        REQUIRE(watcher.paths() == Paths{files.get_path("incoming/a/4.csv")});
+        files.make_file("incoming/a/1.csv");
+    }
+
+    SECTION("New directories are watched")
+    {
+        files.make_files({"incoming/b/6.csv"});
+        auto events = get_events(watcher);
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].type == Yglob::GlobEventType::CREATED);
+        REQUIRE(events[0].path == files.get_path("incoming/b/6.csv"));
+
+        files.make_files({"incoming/b/7.csv"});
+        events = get_events(watcher);
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].path == files.get_path("incoming/b/7.csv"));
+    }
+
+    SECTION("Files and directories are moved")
+    {
+        std::filesystem::rename(files.get_path("incoming/a/1.csv"),
+                                files.get_path("incoming/a/8.csv"));
+        auto events = get_events(watcher);
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].type == Yglob::GlobEventType::MOVED);
+        REQUIRE(events[0].path == files.get_path("incoming/a/8.csv"));
+        REQUIRE(events[0].old_path == files.get_path("incoming/a/1.csv"));
+
+        std::filesystem::rename(files.get_path("incoming/a"),
+                                files.get_path("incoming/c"));
+        events = get_events(watcher);
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].type == Yglob::GlobEventType::MOVED);
+        REQUIRE(events[0].path == files.get_path("incoming/c/8.csv"));
+        REQUIRE(events[0].old_path == files.get_path("incoming/a/8.csv"));
+
+        std::filesystem::rename(files.get_path("incoming/c"),
+                                files.get_path("other/c"));
+        events = get_events(watcher);
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].type == Yglob::GlobEventType::DELETED);
+        REQUIRE(events[0].path == files.get_path("incoming/c/8.csv"));
+        REQUIRE(watcher.paths().empty());
+
+        std::filesystem::rename(files.get_path("other/c"),
+                                files.get_path("incoming/a"));
+        std::filesystem::rename(files.get_path("incoming/a/8.csv"),
+                                files.get_path("incoming/a/1.csv"));
+        events = get_events(watcher);
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].type == Yglob::GlobEventType::CREATED);
+        REQUIRE(events[0].path == files.get_path("incoming/a/1.csv"));
+    }
+
+    SECTION("Only directories that can lead to matches are watched")
+    {
+        auto count = watcher.watch_count();
+        files.make_files({"other/d/9.csv", "incoming/a/e/10.csv"});
+        REQUIRE(get_events(watcher).empty());
+        REQUIRE(watcher.watch_count() == count);
+    }
+}
+
+TEST_CASE("GlobWatcher with double star")
+{
+    if (!Yglob::GlobWatcher::is_supported())
+        return;
+
+    TempFiles files("YglobTest", true);
+    files.make_files({"a/1.csv", "a/b/2.txt"});
+
+    Yglob::GlobWatcher watcher(std::vector{files.get_path("**/*.csv")},
+                               {"**/x"});
+    REQUIRE(watcher.paths() == Paths{files.get_path("a/1.csv")});
+
+    files.make_files({"a/b/c/3.csv", "a/x/4.csv"});
+    auto events = get_events(watcher);
+    REQUIRE(events.size() == 1);
+    REQUIRE(events[0].type == Yglob::GlobEventType::CREATED);
+    REQUIRE(events[0].path == files.get_path("a/b/c/3.csv"));
+
+    std::filesystem::remove_all(files.get_path("a/b"));
+    events = get_events(watcher);
+    REQUIRE(events.size() == 1);
+    REQUIRE(events[0].type == Yglob::GlobEventType::DELETED);
+    REQUIRE(events[0].path == files.get_path("a/b/c/3.csv"));
+    files.make_file("a/b/2.txt");
+}
@@ -0,0 +1,99 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yglob/IgnoreFilter.hpp"
+
+#include <fstream>
+#include <catch2/catch_test_macros.hpp>
+#include "TempFiles.hpp"
+
+namespace
+{
+    void write_file(const std::filesystem::path& path, std::string_view text)
+    {
+        std::ofstream stream(path, std::ios::binary);
+        stream << text;
+    }
+}
+
+TEST_CASE("IgnoreFilter with simple rules")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a/b.txt", "a/c.log", "d.log"});
+    auto base = files.base_directory();
+
+    Yglob::IgnoreFilter filter;
+    filter.add_rules(base, "# Comment\n*.log\n!d.log\n");
+    REQUIRE(filter.is_ignored(base / "a/c.log", false));
+    REQUIRE_FALSE(filter.is_ignored(base / "a/b.txt", false));
+    REQUIRE_FALSE(filter.is_ignored(base / "d.log", false));
+}
+
+TEST_CASE("IgnoreFilter with anchored and directory rules")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"build/a.o", "src/build", "src/x/build/b.o"});
+    auto base = files.base_directory();
+
+    Yglob::IgnoreFilter filter;
+    filter.add_rules(base, "/build/\nx/\n");
+    REQUIRE(filter.is_ignored(base / "build", true));
+    REQUIRE(filter.is_ignored(base / "build/a.o", false));
+    REQUIRE_FALSE(filter.is_ignored(base / "src/build", false));
+    // "x/" contains no slash other than the trailing one and
+    // matches at any depth.
+    REQUIRE(filter.is_ignored(base / "src/x", true));
+    REQUIRE(filter.is_ignored(base / "src/x/build/b.o", false));
+}
+
+TEST_CASE("IgnoreFilter with rules in subdirectory")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a/b.tmp", "a/c/d.tmp", "e.tmp",
+                      ".gitignore", "a/.gitignore"});
+    auto base = files.base_directory();
+    write_file(base / ".gitignore", "*.tmp\n");
+    write_file(base / "a/.gitignore", "!*.tmp\n");
+
+    Yglob::IgnoreFilter filter;
+    REQUIRE(filter.is_ignored(base / "e.tmp", false));
+    REQUIRE_FALSE(filter.is_ignored(base / "a/b.tmp", false));
+    REQUIRE_FALSE(filter.is_ignored(base / "a/c/d.tmp", false));
+}
+
+TEST_CASE("IgnoreFilter with double star")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a/out/b/c.txt", "out/d.txt", "a/e.txt"});
+    auto base = files.base_directory();
+
+    Yglob::IgnoreFilter filter;
+    filter.add_rules(base, "a/**/c.txt\nout/**\n");
+    REQUIRE(filter.is_ignored(base / "a/out/b/c.txt", false));
+    REQUIRE(filter.is_ignored(base / "out/d.txt", false));
+    REQUIRE_FALSE(filter.is_ignored(base / "out", true));
+    REQUIRE_FALSE(filter.is_ignored(base / "a/e.txt", false));
+}
+
+TEST_CASE("IgnoreFilter with several repositories")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"r1/.git/HEAD", "r1/.gitignore", "r1/a/b.log",
+                      "r2/.git/HEAD", "r2/.gitignore", "r2/a/b.log", "r2/c.tmp",
+                      "r2/s/.git/HEAD", "r2/s/d.tmp"});
+    auto base = files.base_directory();
+    write_file(base / "r1/.gitignore", "*.log\n");
+    write_file(base / "r2/.gitignore", "*.tmp\n");
+
+    Yglob::IgnoreFilter filter;
+    REQUIRE(filter.is_ignored_entry(base / "r1/a/b.log", false));
+    REQUIRE_FALSE(filter.is_ignored_entry(base / "r2/a/b.log", false));
+    REQUIRE(filter.is_ignored_entry(base / "r2/c.tmp", false));
+    // r2/s is a repository of its own, r2's rules don't apply to it.
+    REQUIRE_FALSE(filter.is_ignored_entry(base / "r2/s/d.tmp", false));
+    REQUIRE(filter.is_ignored(base / "r1/a/b.log", false));
+}
@@ -7,8 +7,16 @@
 //****************************************************************************
 #include "Yglob/PathIterator.hpp"
 
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <mutex>
 #include <ranges>
+#include <thread>
 #include <catch2/catch_test_macros.hpp>
+#include "Yglob/ParallelWalker.hpp"
+#include "Yglob/YglobException.hpp"
+#include "CountingResource.hpp"
 #include "TempFiles.hpp"
 
 namespace
@@ -225,3 +233,758 @@ TEST_CASE("Case-sensitive PathIterator")
     REQUIRE(it.path() == files.get_path("b/ghi.txt"));
     REQUIRE_FALSE(it.next());
 }
+
+TEST_CASE("PathIterator with recursive path below recursive path")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a/abc.txt", "a/b/def.txt", "b/ghi.txt", "c/b/d/jkl.txt"});
+
+    Yglob::PathIterator it(files.get_path("**/b/**"),
+                           Yglob::PathIteratorFlags::NO_DIRECTORIES);
+    std::vector<std::filesystem::path> paths;
+    while (it.next())
+        paths.push_back(it.path());
+    REQUIRE(paths.size() == 3);
+    REQUIRE(contains(paths, files.get_path("a/b/def.txt")));
+    REQUIRE(contains(paths, files.get_path("b/ghi.txt")));
+    REQUIRE(contains(paths, files.get_path("c/b/d/jkl.txt")));
+}
+
+TEST_CASE("PathIterator with ignore files")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a/abc.txt", "a/def.log", "b/ghi.txt", "c/jkl.txt",
+                      ".gitignore"});
+    {
+        std::ofstream stream(files.get_path(".gitignore"));
+        stream << "*.log\n/b/\n";
+    }
+
+    Yglob::PathIterator it(files.get_path("**/*.*"),
+                           Yglob::PathIteratorFlags::NO_DIRECTORIES
+                           | Yglob::PathIteratorFlags::USE_IGNORE_FILES);
+    std::vector<std::filesystem::path> paths;
+    while (it.next())
+        paths.push_back(it.path());
+    REQUIRE(paths.size() == 3);
+    REQUIRE(contains(paths, files.get_path(".gitignore")));
+    REQUIRE(contains(paths, files.get_path("a/abc.txt")));
+    REQUIRE(contains(paths, files.get_path("c/jkl.txt")));
+}
+
+TEST_CASE("PathIterator with exclude patterns")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a/abc.txt", "a/def.tmp", "node_modules/ghi.txt",
+                      "b/node_modules/c/jkl.txt", "b/mno.txt"});
+
+    Yglob::PathIterator it(files.get_path("**/*.*"),
+                           {"**/node_modules", "**/*.tmp"},
+                           Yglob::PathIteratorFlags::NO_DIRECTORIES);
+    std::vector<std::filesystem::path> paths;
+    while (it.next())
+        paths.push_back(it.path());
+    REQUIRE(paths.size() == 2);
+    REQUIRE(contains(paths, files.get_path("a/abc.txt")));
+    REQUIRE(contains(paths, files.get_path("b/mno.txt")));
+}
+
+TEST_CASE("PathIterator with exclude patterns and glob")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a/abc.txt", "a/def.tmp", "b/ghi.txt"});
+
+    Yglob::PathIterator it(files.get_path("*/*"), {"**/b", "**/*.tmp"});
+    std::vector<std::filesystem::path> paths;
+    while (it.next())
+        paths.push_back(it.path());
+    REQUIRE(paths.size() == 1);
+    REQUIRE(contains(paths, files.get_path("a/abc.txt")));
+}
+
+TEST_CASE("PathIterator with exclude patterns matching plain names")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"base/build/x.o", "base/y.o", "a/x/k.c", "a/y/l.c",
+                      "b/x/m.c"});
+
+    SECTION("In the base path")
+    {
+        Yglob::PathIterator it(files.get_path("base/build/*.o"), {"**/build"});
+        REQUIRE_FALSE(it.next());
+
+        it = Yglob::PathIterator(files.get_path("base/build"), {"**/build"});
+        REQUIRE_FALSE(it.next());
+
+        it = Yglob::PathIterator(files.get_path("base/*.o"), {"**/build"});
+        REQUIRE(it.next());
+        REQUIRE(it.path() == files.get_path("base/y.o"));
+        REQUIRE_FALSE(it.next());
+    }
+
+    SECTION("After a glob")
+    {
+        Yglob::PathIterator it(files.get_path("*/x/*.c"), {"**/x"});
+        REQUIRE_FALSE(it.next());
+
+        it = Yglob::PathIterator(files.get_path("*/y/*.c"), {"**/x"});
+        REQUIRE(it.next());
+        REQUIRE(it.path() == files.get_path("a/y/l.c"));
+        REQUIRE_FALSE(it.next());
+    }
+}
+
+TEST_CASE("PathIterator with several glob paths")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"src/a.cpp", "src/b/c.h", "src/b/d.cpp", "include/e.hpp",
+                      "tests/f/data/g.json", "tests/h.json"});
+
+    std::vector<std::filesystem::path> glob_paths = {
+        files.get_path("src/**/*.cpp"),
+        files.get_path("src/**/*.h"),
+        files.get_path("include/**/*.hpp"),
+        files.get_path("tests/*/data/*.json"),
+        files.get_path("src/b/*")
+    };
+    Yglob::PathIterator it(glob_paths);
+    std::vector<std::pair<std::filesystem::path, std::vector<size_t>>> results;
+    while (it.next())
+        results.emplace_back(it.path(), it.pattern_indexes());
+
+    std::ranges::sort(results);
+    REQUIRE(results.size() == 5);
+    REQUIRE(results[0].first == files.get_path("include/e.hpp"));
+    REQUIRE(results[0].second == std::vector<size_t>{2});
+    REQUIRE(results[1].first == files.get_path("src/a.cpp"));
+    REQUIRE(results[1].second == std::vector<size_t>{0});
+    REQUIRE(results[2].first == files.get_path("src/b/c.h"));
+    REQUIRE(results[2].second == std::vector<size_t>{1, 4});
+    REQUIRE(results[3].first == files.get_path("src/b/d.cpp"));
+    REQUIRE(results[3].second == std::vector<size_t>{0, 4});
+    REQUIRE(results[4].first == files.get_path("tests/f/data/g.json"));
+    REQUIRE(results[4].second == std::vector<size_t>{3});
+}
+
+TEST_CASE("PathIterator with several relative glob paths")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a/b.txt", "a/c.md", "d.txt"});
+    AutoCwd cwd(files.base_directory());
+
+    std::vector<std::filesystem::path> glob_paths = {"**/*.txt", "a/*"};
+    Yglob::PathIterator it(glob_paths, Yglob::PathIteratorFlags::NO_DIRECTORIES);
+    std::vector<std::filesystem::path> paths;
+    while (it.next())
+        paths.push_back(it.path());
+    REQUIRE(paths.size() == 3);
+    REQUIRE(contains(paths, "a/b.txt"));
+    REQUIRE(contains(paths, "a/c.md"));
+    REQUIRE(contains(paths, "d.txt"));
+}
+
+TEST_CASE("PathIterator view")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a/b.txt", "a/c/d.txt", "e.txt"});
+
+    for (const auto& glob_paths : {std::vector{files.get_path("**/*.txt")},
+                                   std::vector{files.get_path("**/*.txt"),
+                                               files.get_path("a/*")}})
+    {
+        Yglob::PathIterator it(glob_paths);
+        size_t count = 0;
+        while (it.next())
+        {
+            REQUIRE(std::filesystem::path(std::u8string(
+                        reinterpret_cast<const char8_t*>(it.view().data()),
+                        it.view().size())) == it.path());
+            ++count;
+        }
+        REQUIRE(count >= 3);
+        REQUIRE(it.view().empty() == it.path().empty());
+    }
+    REQUIRE(Yglob::PathIterator().view().empty());
+}
+
+TEST_CASE("PathIterator with one and several glob paths ending in **")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"x/a.txt", "x/y/b.txt", "a/b/c.txt", "a/b/d/e.txt",
+                      "f/b/g.txt", "f/c/h.txt"});
+
+    for (std::string glob_path : {"x/**", "*/b/**"})
+    {
+        std::vector<std::filesystem::path> expected;
+        Yglob::PathIterator single(files.get_path(glob_path));
+        while (single.next())
+            expected.push_back(single.path());
+        std::ranges::sort(expected);
+        REQUIRE(!expected.empty());
+        REQUIRE_FALSE(contains(expected, files.get_path("x")));
+        REQUIRE_FALSE(contains(expected, files.get_path("a/b")));
+
+        std::vector<std::filesystem::path> paths;
+        Yglob::PathIterator several(std::vector{files.get_path(glob_path)});
+        while (several.next())
+            paths.push_back(several.path());
+        std::ranges::sort(paths);
+        REQUIRE(paths == expected);
+
+        paths.clear();
+        Yglob::ParallelOptions options;
+        options.thread_count = 2;
+        Yglob::PathIterator parallel(files.get_path(glob_path), {},
+                                     Yglob::PathIteratorFlags::DEFAULT,
+                                     options);
+        while (parallel.next())
+            paths.push_back(parallel.path());
+        std::ranges::sort(paths);
+        REQUIRE(paths == expected);
+    }
+}
+
+TEST_CASE("PathIterator with one and several relative glob paths")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a/b.txt", "a/c/d.txt", "e.txt"});
+    AutoCwd auto_cwd(files.base_directory());
+
+    auto get_paths = [](Yglob::PathIterator it)
+    {
+        std::vector<std::filesystem::path> paths;
+        while (it.next())
+            paths.push_back(it.path());
+        std::ranges::sort(paths);
+        return paths;
+    };
+
+    REQUIRE(get_paths(Yglob::PathIterator("*/b.txt"))
+            == std::vector<std::filesystem::path>{"a/b.txt"});
+
+    for (std::string glob_path : {"*/b.txt", "*.txt", "a/*.txt", "**/*.txt",
+                                  "a/**", "*/c/*"})
+    {
+        auto expected = get_paths(Yglob::PathIterator(glob_path));
+        REQUIRE(!expected.empty());
+        REQUIRE(get_paths(Yglob::PathIterator(
+                    std::vector<std::filesystem::path>{glob_path}))
+                == expected);
+    }
+}
+
+TEST_CASE("PathIterator reading directories in parallel")
+{
+    TempFiles files("YglobTest", true);
+    std::vector<std::filesystem::path> names;
+    for (int i = 0; i < 6; ++i)
+    {
+        for (int j = 0; j < 4; ++j)
+        {
+            auto dir = "d" + std::to_string(i) + "/e" + std::to_string(j);
+            names.push_back(dir + "/a.log");
+            names.push_back(dir + "/b.txt");
+            names.push_back(dir + "/x/c.log");
+        }
+    }
+    files.make_files(names);
+    auto glob_path = files.get_path("**/*.log");
+    std::vector<std::string> excludes = {"**/x"};
+
+    std::vector<std::filesystem::path> expected;
+    Yglob::PathIterator sequential(glob_path, excludes);
+    while (sequential.next())
+        expected.push_back(sequential.path());
+    REQUIRE(expected.size() == 24);
+    std::ranges::sort(expected);
+
+    SECTION("Unordered")
+    {
+        Yglob::ParallelOptions options;
+        options.thread_count = 4;
+        options.queue_size = 3;
+        Yglob::PathIterator it(glob_path, excludes,
+                               Yglob::PathIteratorFlags::DEFAULT, options);
+        std::vector<std::filesystem::path> paths;
+        while (it.next())
+        {
+            REQUIRE(it.pattern_indexes() == std::vector<size_t>{0});
+            paths.push_back(it.path());
+        }
+        std::ranges::sort(paths);
+        REQUIRE(paths == expected);
+    }
+
+    SECTION("Ordered")
+    {
+        Yglob::ParallelOptions options;
+        options.thread_count = 3;
+        options.queue_size = 1;
+        options.ordered = true;
+        Yglob::PathIterator it(glob_path, excludes,
+                               Yglob::PathIteratorFlags::DEFAULT, options);
+        std::vector<std::filesystem::path> paths;
+        while (it.next())
+            paths.push_back(it.path());
+        REQUIRE(paths == expected);
+    }
+
+    SECTION("With an executor")
+    {
+        std::mutex mutex;
+        std::vector<std::jthread> threads;
+        Yglob::ParallelOptions options;
+        options.executor = [&](std::function<void()> task)
+        {
+            std::scoped_lock lock(mutex);
+            threads.emplace_back(std::move(task));
+        };
+        std::vector<std::filesystem::path> paths;
+        {
+            Yglob::PathIterator it(std::vector{glob_path, glob_path}, excludes,
+                                   Yglob::PathIteratorFlags::DEFAULT, options);
+            while (it.next())
+            {
+                REQUIRE(it.pattern_indexes() == std::vector<size_t>{0, 1});
+                paths.push_back(it.path());
+            }
+        }
+        // All the tasks have been scheduled when next() returns false.
+        threads.clear();
+        std::ranges::sort(paths);
+        REQUIRE(paths == expected);
+    }
+
+    SECTION("Stopping early")
+    {
+        Yglob::ParallelOptions options;
+        options.queue_size = 1;
+        Yglob::PathIterator it(glob_path, excludes,
+                               Yglob::PathIteratorFlags::DEFAULT, options);
+        REQUIRE(it.next());
+    }
+}
+
+TEST_CASE("PathIterator reading relative glob paths in parallel")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a/b.txt", "a/c/d.txt", "e.txt"});
+    AutoCwd auto_cwd(files.base_directory());
+
+    for (std::string glob_path : {"*.txt", "*/*.txt", "**/*.txt"})
+    {
+        std::vector<std::filesystem::path> expected;
+        Yglob::PathIterator sequential(glob_path);
+        while (sequential.next())
+            expected.push_back(sequential.path());
+        std::ranges::sort(expected);
+        REQUIRE(!expected.empty());
+
+        for (bool ordered : {false, true})
+        {
+            Yglob::ParallelOptions options;
+            options.thread_count = 2;
+            options.ordered = ordered;
+            std::vector<std::filesystem::path> paths;
+            Yglob::PathIterator it(glob_path, {},
+                                   Yglob::PathIteratorFlags::DEFAULT, options);
+            while (it.next())
+                paths.push_back(it.path());
+            std::ranges::sort(paths);
+            REQUIRE(paths == expected);
+        }
+    }
+}
+
+TEST_CASE("Ordered parallel walk releases the directories it has passed")
+{
+    TempFiles files("YglobTest", true);
+    std::vector<std::filesystem::path> names;
+    for (int i = 0; i < 30; ++i)
+    {
+        for (int j = 0; j < 30; ++j)
+        {
+            names.push_back("d" + std::to_string(i) + "/s" + std::to_string(j)
+                            + "/f.txt");
+        }
+    }
+    files.make_files(names);
+
+    Yglob::ParallelOptions options;
+    options.thread_count = 2;
+    options.queue_size = 1;
+    options.ordered = true;
+    Yglob::ParallelWalker walker({files.get_path("**")},
+                                 Yglob::PathIteratorFlags::DEFAULT,
+                                 nullptr, nullptr, options);
+    size_t count = 0;
+    size_t max_tasks = 0;
+    while (walker.next())
+    {
+        ++count;
+        max_tasks = std::max(max_tasks, walker.task_count());
+    }
+    REQUIRE(count == 30 + 30 * 30 * 2);
+    // The tree has more than 900 directories, but only the ones on the
+    // way down to the current path, their siblings and the few that are
+    // read ahead need to be in memory.
+    REQUIRE(max_tasks < 100);
+}
+
+TEST_CASE("Prefetching PathIterator")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a/b.txt", "a/c/d.txt", "a/c/e.md", "f.txt", "g/h/i.txt"});
+
+    std::vector<std::filesystem::path> glob_paths = {files.get_path("**/*.txt"),
+                                                     files.get_path("a/**")};
+    std::vector<std::pair<std::filesystem::path, std::vector<size_t>>> expected;
+    Yglob::PathIterator sequential(glob_paths);
+    while (sequential.next())
+        expected.emplace_back(sequential.path(), sequential.pattern_indexes());
+
+    for (size_t max_buffered : {1, 2, 1000})
+    {
+        auto it = Yglob::PathIterator::prefetching(Yglob::PathIterator(glob_paths),
+                                                   max_buffered);
+        std::vector<std::pair<std::filesystem::path, std::vector<size_t>>> results;
+        while (it.next())
+            results.emplace_back(it.path(), it.pattern_indexes());
+        REQUIRE(results == expected);
+        REQUIRE_FALSE(it.next());
+    }
+
+    auto stopped_early = Yglob::PathIterator::prefetching(
+        Yglob::PathIterator(files.get_path("**")), 1);
+    REQUIRE(stopped_early.next());
+}
+
+TEST_CASE("Sharded PathIterator")
+{
+    TempFiles files("YglobTest", true);
+    std::vector<std::filesystem::path> names;
+    for (int i = 0; i < 8; ++i)
+    {
+        auto dir = "d" + std::to_string(i);
+        names.push_back(dir + "/a.txt");
+        names.push_back(dir + "/logs/b.txt");
+        names.push_back(dir + "/logs/e" + std::to_string(i % 3) + "/c.txt");
+        names.push_back("f" + std::to_string(i) + ".txt");
+    }
+    files.make_files(names);
+
+    for (std::string glob_path : {"**", "*/logs/**/*.txt", "d3/logs/**"})
+    {
+        std::vector<std::filesystem::path> expected;
+        Yglob::PathIterator full(files.get_path(glob_path));
+        while (full.next())
+            expected.push_back(full.path());
+        std::ranges::sort(expected);
+        REQUIRE(!expected.empty());
+
+        for (size_t count : {1, 2, 3, 5})
+        {
+            for (size_t depth : {1, 2, 3})
+            {
+                std::vector<std::filesystem::path> paths;
+                size_t non_empty_shards = 0;
+                for (size_t index = 0; index < count; ++index)
+                {
+                    Yglob::PathIterator it(files.get_path(glob_path), {},
+                                           Yglob::PathIteratorFlags::DEFAULT,
+                                           Yglob::Shard(index, count, depth));
+                    auto size = paths.size();
+                    while (it.next())
+                        paths.push_back(it.path());
+                    if (paths.size() != size)
+                        ++non_empty_shards;
+                }
+                std::ranges::sort(paths);
+                REQUIRE(paths == expected);
+                if (expected.size() > 10)
+                    REQUIRE(non_empty_shards >= std::min<size_t>(count, 2));
+            }
+        }
+    }
+
+    REQUIRE_THROWS_AS(Yglob::PathIterator(files.get_path("**"), {},
+                                          Yglob::PathIteratorFlags::DEFAULT,
+                                          Yglob::Shard(2, 2)),
+                      Yglob::YglobException);
+}
+
+TEST_CASE("Sharded PathIterator with relative glob paths")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"d0/a.txt", "d1/b.txt", "d2/c/e.txt", "f.txt", "g.txt"});
+    AutoCwd auto_cwd(files.base_directory());
+
+    for (std::string glob_path : {"*.txt", "*/*.txt", "**/*.txt"})
+    {
+        std::vector<std::filesystem::path> expected;
+        Yglob::PathIterator full(glob_path);
+        while (full.next())
+            expected.push_back(full.path());
+        std::ranges::sort(expected);
+        REQUIRE(!expected.empty());
+
+        std::vector<std::filesystem::path> paths;
+        for (size_t index = 0; index < 3; ++index)
+        {
+            Yglob::PathIterator it(glob_path, {},
+                                   Yglob::PathIteratorFlags::DEFAULT,
+                                   Yglob::Shard(index, 3));
+            while (it.next())
+                paths.push_back(it.path());
+        }
+        std::ranges::sort(paths);
+        REQUIRE(paths == expected);
+    }
+}
+
+TEST_CASE("Sharded PathIterator reading directories in parallel")
+{
+    TempFiles files("YglobTest", true);
+    std::vector<std::filesystem::path> names;
+    for (int i = 0; i < 8; ++i)
+    {
+        auto dir = "d" + std::to_string(i);
+        names.push_back(dir + "/a.txt");
+        names.push_back(dir + "/logs/b.txt");
+        names.push_back(dir + "/logs/e" + std::to_string(i % 3) + "/c.txt");
+    }
+    files.make_files(names);
+
+    for (std::string glob_path : {"**", "*/logs/**/*.txt"})
+    {
+        std::vector<std::filesystem::path> expected;
+        Yglob::PathIterator full(files.get_path(glob_path));
+        while (full.next())
+            expected.push_back(full.path());
+        std::ranges::sort(expected);
+        REQUIRE(!expected.empty());
+
+        for (bool ordered : {false, true})
+        {
+            std::vector<std::filesystem::path> paths;
+            for (size_t index = 0; index < 3; ++index)
+            {
+                Yglob::PathIteratorOptions options;
+                options.parallel.emplace();
+                options.parallel->thread_count = 2;
+                options.parallel->ordered = ordered;
+                options.shard = Yglob::Shard(index, 3, 2);
+                Yglob::PathIterator it(files.get_path(glob_path), {},
+                                       Yglob::PathIteratorFlags::DEFAULT,
+                                       options);
+                auto size = paths.size();
+                while (it.next())
+                    paths.push_back(it.path());
+                // Each shard has its part of the sequential shard's paths.
+                Yglob::PathIterator sequential(files.get_path(glob_path), {},
+                                               Yglob::PathIteratorFlags::DEFAULT,
+                                               options.shard);
+                std::vector<std::filesystem::path> shard_paths;
+                while (sequential.next())
+                    shard_paths.push_back(sequential.path());
+                std::vector<std::filesystem::path> parallel_paths(
+                    paths.begin() + ptrdiff_t(size), paths.end());
+                std::ranges::sort(shard_paths);
+                std::ranges::sort(parallel_paths);
+                REQUIRE(parallel_paths == shard_paths);
+            }
+            std::ranges::sort(paths);
+            REQUIRE(paths == expected);
+        }
+    }
+
+    Yglob::PathIteratorOptions options;
+    options.parallel.emplace();
+    options.parallel->thread_count = 2;
+    options.shard = Yglob::Shard(3, 3);
+    REQUIRE_THROWS_AS(Yglob::PathIterator(files.get_path("**"), {},
+                                          Yglob::PathIteratorFlags::DEFAULT,
+                                          options),
+                      Yglob::YglobException);
+}
+
+TEST_CASE("Stopping PathIterator with a stop token or deadline")
+{
+    TempFiles files("YglobTest", true);
+    std::vector<std::filesystem::path> names;
+    for (int i = 0; i < 5; ++i)
+    {
+        for (int j = 0; j < 5; ++j)
+            names.push_back("d" + std::to_string(i) + "/f" + std::to_string(j) + ".txt");
+    }
+    files.make_files(names);
+    auto glob_path = files.get_path("**/*.txt");
+
+    std::vector<std::function<Yglob::PathIterator()>> makers = {
+        [&] {return Yglob::PathIterator(glob_path);},
+        [&] {return Yglob::PathIterator(std::vector{glob_path});},
+        [&]
+        {
+            Yglob::ParallelOptions options;
+            options.thread_count = 2;
+            options.queue_size = 2;
+            return Yglob::PathIterator(std::vector{glob_path}, {},
+                                       Yglob::PathIteratorFlags::DEFAULT,
+                                       options);
+        },
+        [&]
+        {
+            return Yglob::PathIterator::prefetching(
+                Yglob::PathIterator(glob_path), 2);
+        }
+    };
+
+    SECTION("Completed")
+    {
+        for (const auto& make : makers)
+        {
+            auto it = make();
+            it.set_deadline(std::chrono::steady_clock::now() + std::chrono::hours(1));
+            REQUIRE(it.status() == Yglob::IterationStatus::IN_PROGRESS);
+            size_t count = 0;
+            while (it.next())
+                ++count;
+            REQUIRE(count == names.size());
+            REQUIRE(it.status() == Yglob::IterationStatus::COMPLETED);
+        }
+    }
+
+    SECTION("Cancelled during the walk")
+    {
+        for (const auto& make : makers)
+        {
+            std::stop_source source;
+            auto it = make();
+            it.set_stop_token(source.get_token());
+            size_t count = 0;
+            while (it.next())
+            {
+                if (++count == 3)
+                    source.request_stop();
+            }
+            REQUIRE(count == 3);
+            REQUIRE(it.status() == Yglob::IterationStatus::CANCELLED);
+            REQUIRE_FALSE(it.next());
+        }
+    }
+
+    SECTION("Cancelled before the walk")
+    {
+        for (const auto& make : makers)
+        {
+            std::stop_source source;
+            source.request_stop();
+            auto it = make();
+            it.set_stop_token(source.get_token());
+            REQUIRE_FALSE(it.next());
+            REQUIRE(it.status() == Yglob::IterationStatus::CANCELLED);
+        }
+    }
+
+    SECTION("Timed out")
+    {
+        for (const auto& make : makers)
+        {
+            auto it = make();
+            it.set_deadline(std::chrono::steady_clock::now());
+            REQUIRE_FALSE(it.next());
+            REQUIRE(it.status() == Yglob::IterationStatus::TIMED_OUT);
+        }
+    }
+}
+
+TEST_CASE("PathIterator looking up literal names")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a/b.txt", "a/c/d.txt", "e/f.txt"});
+    std::filesystem::create_directory_symlink(files.get_path("a/c"),
+                                              files.get_path("a/g"));
+    std::filesystem::create_symlink(files.get_path("a/missing"),
+                                    files.get_path("a/broken"));
+
+    // Every name in a/ is known, so a/ is never read.
+    std::vector glob_paths = {files.get_path("a/b.txt"),
+                              files.get_path("a/c"),
+                              files.get_path("a/g"),
+                              files.get_path("a/broken"),
+                              files.get_path("a/missing"),
+                              files.get_path("e/f.txt")};
+
+    auto get_paths = [&](Yglob::PathIteratorFlags flags)
+    {
+        std::vector<std::filesystem::path> paths;
+        Yglob::PathIterator it(glob_paths, {}, flags);
+        while (it.next())
+            paths.push_back(it.path());
+        std::ranges::sort(paths);
+        return paths;
+    };
+
+    REQUIRE(get_paths(Yglob::PathIteratorFlags::DEFAULT)
+            == std::vector{files.get_path("a/b.txt"),
+                           files.get_path("a/c"),
+                           files.get_path("a/g"),
+                           files.get_path("e/f.txt")});
+    REQUIRE(get_paths(Yglob::PathIteratorFlags::NO_DIRECTORIES)
+            == std::vector{files.get_path("a/b.txt"),
+                           files.get_path("e/f.txt")});
+    REQUIRE(get_paths(Yglob::PathIteratorFlags::NO_FILES)
+            == std::vector{files.get_path("a/c"),
+                           files.get_path("a/g")});
+
+    // TempFiles only removes the files and directories it created.
+    std::filesystem::remove(files.get_path("a/g"));
+    std::filesystem::remove(files.get_path("a/broken"));
+}
+
+TEST_CASE("PathIterator with a memory resource")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a/b.txt", "a/c/d.txt", "a/c/e.cpp", "f/g.txt"});
+
+    auto get_paths = [](Yglob::PathIterator it)
+    {
+        std::vector<std::filesystem::path> paths;
+        while (it.next())
+            paths.push_back(it.path());
+        std::ranges::sort(paths);
+        return paths;
+    };
+
+    CountingResource resource;
+
+    SECTION("One glob path")
+    {
+        for (std::string glob_path : {"*/*.txt", "a/**/*.txt"})
+        {
+            auto expected = get_paths(Yglob::PathIterator(files.get_path(glob_path)));
+            REQUIRE(!expected.empty());
+            const auto allocations = resource.allocations;
+            REQUIRE(get_paths(Yglob::PathIterator(
+                        files.get_path(glob_path), {},
+                        Yglob::PathIteratorFlags::DEFAULT, &resource))
+                    == expected);
+            REQUIRE(resource.allocations > allocations);
+            REQUIRE(resource.bytes_in_use == 0);
+        }
+    }
+
+    SECTION("Several glob paths")
+    {
+        std::vector glob_paths = {files.get_path("*/*.txt"),
+                                  files.get_path("a/**/*.cpp")};
+        auto expected = get_paths(Yglob::PathIterator(glob_paths));
+        REQUIRE(expected.size() == 3);
+        REQUIRE(get_paths(Yglob::PathIterator(
+                    glob_paths, {}, Yglob::PathIteratorFlags::DEFAULT,
+                    &resource))
+                == expected);
+        REQUIRE(resource.allocations > 0);
+        REQUIRE(resource.bytes_in_use == 0);
+    }
+}
@@ -0,0 +1,76 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yglob/PathList.hpp"
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include "Yglob/PathIterator.hpp"
+#include "Yglob/YglobException.hpp"
+#include "TempFiles.hpp"
+
+TEST_CASE("PathList access")
+{
+    std::vector<std::string> paths;
+    for (int i = 0; i < 40; ++i)
+        paths.push_back("dir/sub" + std::to_string(i / 7) + "/file" + std::to_string(i));
+    paths.emplace_back("");
+    paths.emplace_back("other");
+
+    Yglob::PathList list;
+    for (const auto& path : paths)
+        list.push_back(std::string_view(path));
+    REQUIRE(list.size() == paths.size());
+
+    size_t i = 0;
+    for (auto path : list)
+        REQUIRE(path == paths[i++]);
+    REQUIRE(i == paths.size());
+
+    std::string buffer;
+    for (i = paths.size(); i-- > 0;)
+        REQUIRE(list.get(i, buffer) == paths[i]);
+    REQUIRE(list[17] == std::filesystem::path(paths[17]));
+    REQUIRE_THROWS_AS(list.get(paths.size(), buffer), Yglob::YglobException);
+
+    list.clear();
+    REQUIRE(list.empty());
+    REQUIRE(list.begin() == list.end());
+}
+
+TEST_CASE("PathList is smaller than a vector of paths")
+{
+    Yglob::PathList list;
+    std::vector<std::filesystem::path> paths;
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto path = "/home/user/projects/library/src/module" + std::to_string(i / 20)
+                    + "/source_file_" + std::to_string(i) + ".cpp";
+        list.push_back(std::string_view(path));
+        paths.emplace_back(path);
+    }
+    list.shrink_to_fit();
+    REQUIRE(list.memory_usage() * 5 < paths.size() * (sizeof(std::filesystem::path) + 60));
+}
+
+TEST_CASE("collect")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a/b.txt", "a/c.txt", "d/e.txt", "d/f.md"});
+
+    Yglob::PathIterator it(files.get_path("*/*.txt"));
+    std::vector<std::filesystem::path> expected;
+    for (const auto& path : it)
+        expected.push_back(path);
+
+    auto list = Yglob::collect(files.get_path("*/*.txt"));
+    REQUIRE(list.size() == 3);
+    std::vector<std::filesystem::path> result;
+    for (auto path : list)
+        result.emplace_back(path);
+    REQUIRE(result == expected);
+}
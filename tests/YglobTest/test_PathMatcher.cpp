@@ -7,7 +7,11 @@
 //****************************************************************************
 #include "Yglob/PathMatcher.hpp"
 #include <filesystem>
+#include <iterator>
+#include <string>
+#include <vector>
 #include <catch2/catch_test_macros.hpp>
+#include "CountingResource.hpp"
 
 TEST_CASE("Relative glob, relative paths")
 {
@@ -80,3 +84,205 @@ TEST_CASE("Multi-dir glob 2")
     Yglob::PathMatcher matcher(std::filesystem::path("abc/**/cde/*.txt"));
     REQUIRE(matcher.match(std::filesystem::path("abc/a/b/cde/a.txt")));
 }
+
+TEST_CASE("Match path string")
+{
+    Yglob::PathMatcher matcher(std::filesystem::path("abc/**/cde/*.txt"));
+    REQUIRE(matcher.match(std::string_view("abc/a/b/cde/a.txt")));
+    REQUIRE(matcher.match(std::string_view("./abc//cde/a.txt")));
+    REQUIRE_FALSE(matcher.match(std::string_view("abc/a/b/cde/a.txt/b")));
+    REQUIRE_FALSE(matcher.match(std::string_view("/abc/cde/a.txt")));
+}
+
+TEST_CASE("Match path components")
+{
+    using namespace std::literals;
+    Yglob::PathMatcher matcher(std::filesystem::path("/abc/**/*.txt"));
+    std::string_view components[] = {"/"sv, "abc"sv, "def"sv, "a.txt"sv};
+    REQUIRE(matcher.match(std::span(components)));
+    REQUIRE_FALSE(matcher.match(std::span(components).subspan(1)));
+}
+
+TEST_CASE("Case-insensitive literal components")
+{
+    Yglob::PathMatcher matcher(std::filesystem::path("Abc/*.txt"));
+    REQUIRE(matcher.match(std::filesystem::path("aBC/def.TXT")));
+
+    Yglob::PathMatcher cs_matcher(std::filesystem::path("Abc/*.txt"),
+                                  Yglob::GlobFlags::CASE_SENSITIVE);
+    REQUIRE(cs_matcher.match(std::filesystem::path("Abc/def.txt")));
+    REQUIRE_FALSE(cs_matcher.match(std::filesystem::path("aBC/def.txt")));
+}
+
+TEST_CASE("Several multi-dir globs")
+{
+    Yglob::PathMatcher matcher(std::filesystem::path("a/**/b/**/c/*.h"));
+    REQUIRE(matcher.match(std::filesystem::path("a/b/c/x.h")));
+    REQUIRE(matcher.match(std::filesystem::path("a/x/b/y/b/z/c/x.h")));
+    REQUIRE(matcher.match(std::filesystem::path("a/b/b/c/c/x.h")));
+    REQUIRE_FALSE(matcher.match(std::filesystem::path("a/c/b/x.h")));
+    REQUIRE_FALSE(matcher.match(std::filesystem::path("x/a/b/c/x.h")));
+}
+
+TEST_CASE("Multi-dir glob on deep path")
+{
+    Yglob::PathMatcher matcher(std::filesystem::path("**/a/**/a/**/a/**/b"));
+    std::string path;
+    for (int i = 0; i < 200; ++i)
+        path += "a/";
+    REQUIRE_FALSE(matcher.match(std::string_view(path + "c")));
+    REQUIRE(matcher.match(std::string_view(path + "b")));
+}
+
+TEST_CASE("Trailing multi-dir glob")
+{
+    Yglob::PathMatcher matcher(std::filesystem::path("abc/**"));
+    REQUIRE(matcher.match(std::filesystem::path("abc")));
+    REQUIRE(matcher.match(std::filesystem::path("abc/def/ghi")));
+    REQUIRE_FALSE(matcher.match(std::filesystem::path("def/abc")));
+}
+
+TEST_CASE("May match below")
+{
+    Yglob::PathMatcher matcher(std::filesystem::path("abc/*/def/*.txt"));
+    REQUIRE(matcher.may_match_below(std::filesystem::path("abc")));
+    REQUIRE(matcher.may_match_below(std::filesystem::path("abc/x")));
+    REQUIRE(matcher.may_match_below(std::filesystem::path("abc/x/def")));
+    REQUIRE_FALSE(matcher.may_match_below(std::filesystem::path("abc/x/ghi")));
+    REQUIRE_FALSE(matcher.may_match_below(std::filesystem::path("abc/x/def/a.txt")));
+    REQUIRE_FALSE(matcher.may_match_below(std::filesystem::path("/abc")));
+}
+
+TEST_CASE("Matches all below")
+{
+    Yglob::PathMatcher matcher(std::filesystem::path("**/build/**"));
+    REQUIRE(matcher.matches_all_below(std::filesystem::path("a/build")));
+    REQUIRE(matcher.matches_all_below(std::filesystem::path("a/build/b")));
+    REQUIRE_FALSE(matcher.matches_all_below(std::filesystem::path("a/b")));
+    REQUIRE(matcher.may_match_below(std::filesystem::path("a/b")));
+}
+
+TEST_CASE("Match sorted paths")
+{
+    Yglob::PathMatcher matcher(std::filesystem::path("src/**/*.cpp"));
+    std::vector<std::string> paths = {
+        "include/a.hpp",
+        "src/a.cpp",
+        "src/a.hpp",
+        "src/ab/c.cpp",
+        "src/ab/c/d.cpp",
+        "src/abc/d.cpp",
+        "src2/a.cpp",
+        "/src/a.cpp",
+        "src/a.cpp"
+    };
+    auto result = matcher.match_sorted(paths);
+    REQUIRE(result == std::vector<bool>{false, true, false, true, true,
+                                        true, false, false, true});
+
+    std::vector<std::string> matches;
+    matcher.filter_sorted(paths, std::back_inserter(matches));
+    REQUIRE(matches.size() == 5);
+    REQUIRE(matches[0] == "src/a.cpp");
+}
+
+TEST_CASE("Match sorted paths sharing partial component names")
+{
+    Yglob::PathMatcher matcher(std::filesystem::path("ab/*.txt"));
+    std::vector<std::filesystem::path> paths = {
+        "a/b.txt",
+        "ab/c.txt",
+        "abc/c.txt",
+        "ab/d.txt"
+    };
+    auto result = matcher.match_sorted(paths);
+    REQUIRE(result == std::vector<bool>{false, true, false, true});
+}
+
+TEST_CASE("PathMatcher is_subset")
+{
+    using namespace Yglob;
+    auto subset = [](std::string_view a, std::string_view b)
+    {
+        return is_subset(PathMatcher(a), PathMatcher(b));
+    };
+    REQUIRE(subset("src/a/*.c", "src/**"));
+    REQUIRE_FALSE(subset("src/**", "src/a/*.c"));
+    REQUIRE(subset("a/b/c.txt", "**/*.txt"));
+    REQUIRE(subset("**/x/**/*.c", "**/*.c"));
+    REQUIRE_FALSE(subset("**/*.c", "*/*.c"));
+    REQUIRE(subset("/a/*.c", "**/*.c"));
+    REQUIRE_FALSE(subset("a/*.c", "/a/*.c"));
+    REQUIRE(subset("*/b/*", "**"));
+    // "/x" only matches the first pattern.
+    REQUIRE_FALSE(subset("**/x", "*/**"));
+    REQUIRE(subset("**/x", "**/*"));
+}
+
+TEST_CASE("simplify_patterns")
+{
+    using namespace Yglob;
+    auto result = simplify_patterns({"src/a/*.c", "*.log", "src/**",
+                                     "app-*.log", "*.log", "**/.git"});
+    REQUIRE(result == std::vector<std::string>{"*.log", "src/**", "**/.git"});
+
+    REQUIRE(simplify_patterns({"*/**", "**/x"})
+            == std::vector<std::string>{"*/**", "**/x"});
+}
+
+TEST_CASE("PathMatcher memory_usage")
+{
+    using namespace Yglob;
+    PathMatcher matcher(std::filesystem::path("a/very-long-directory-name/**/*.txt"));
+    auto copy = matcher;
+    REQUIRE(copy.match(std::string_view("a/very-long-directory-name/b/c.txt")));
+    REQUIRE(copy.memory_usage() == matcher.memory_usage());
+    REQUIRE(matcher.memory_usage()
+            > PathMatcher(std::filesystem::path("a/*.txt")).memory_usage());
+    REQUIRE(PathMatcher().memory_usage() == sizeof(PathMatcher));
+}
+
+TEST_CASE("PathMatcher with a memory resource")
+{
+    using namespace Yglob;
+    CountingResource resource;
+    {
+        PathMatcher matcher(std::string_view("src/**/[a-z]*.cpp"),
+                            GlobFlags::DEFAULT, &resource);
+        REQUIRE(resource.allocations > 0);
+        REQUIRE(matcher.match(std::string_view("src/a/b/main.cpp")));
+        REQUIRE_FALSE(matcher.match(std::string_view("src/a/b/Main.hpp")));
+        REQUIRE(matcher.may_match_below(std::string_view("src/a")));
+        REQUIRE_FALSE(matcher.may_match_below(std::string_view("lib")));
+
+        std::vector<std::string> paths{"lib/x.cpp", "src/a.cpp", "src/b/c.cpp"};
+        REQUIRE(matcher.match_sorted(paths) == std::vector{false, true, true});
+    }
+    REQUIRE(resource.bytes_in_use == 0);
+}
+
+TEST_CASE("PathMatcher with a memory resource and many components")
+{
+    using namespace Yglob;
+    // More than 64 states need memory for the state sets.
+    std::string pattern;
+    std::string path;
+    for (int i = 0; i < 70; ++i)
+    {
+        pattern += "*/";
+        path += "d/";
+    }
+    pattern += "*.txt";
+    path += "f.txt";
+
+    CountingResource resource;
+    {
+        PathMatcher matcher(std::string_view(pattern), GlobFlags::DEFAULT,
+                            &resource);
+        const auto allocations = resource.allocations;
+        REQUIRE(matcher.match(std::string_view(path)));
+        REQUIRE(resource.allocations > allocations);
+        REQUIRE_FALSE(matcher.match(std::string_view(path.substr(2))));
+    }
+    REQUIRE(resource.bytes_in_use == 0);
+}
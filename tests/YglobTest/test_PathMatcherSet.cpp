@@ -0,0 +1,60 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yglob/PathMatcherSet.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include "Yglob/PathMatcher.hpp"
+
+TEST_CASE("PathMatcherSet with literal and glob patterns")
+{
+    Yglob::PathMatcherSet set({"src/**/*.cpp", "src/**/*.hpp", "src/main.cpp",
+                               "include/*/*.hpp", "**/*.txt"});
+    REQUIRE(set.size() == 5);
+    REQUIRE(set.find_all(std::string_view("src/main.cpp")) == std::vector<size_t>{0, 2});
+    REQUIRE(set.find_first(std::string_view("src/main.cpp")) == 0);
+    REQUIRE(set.find_first(std::string_view("src/a/b/c.hpp")) == 1);
+    REQUIRE(set.find_first(std::string_view("include/a/b.hpp")) == 3);
+    REQUIRE_FALSE(set.find_first(std::string_view("include/b.hpp")));
+    REQUIRE(set.find_all(std::string_view("/a/b/c.txt")) == std::vector<size_t>{4});
+    REQUIRE_FALSE(set.match(std::string_view("/src/main.cpp")));
+}
+
+TEST_CASE("PathMatcherSet with absolute patterns")
+{
+    Yglob::PathMatcherSet set;
+    REQUIRE(set.add(std::string_view("/abc/*.txt")) == 0);
+    REQUIRE(set.add(std::string_view("abc/*.txt")) == 1);
+    REQUIRE(set.add(std::string_view("/**/def")) == 2);
+    REQUIRE(set.find_all(std::filesystem::path("/abc/a.txt")) == std::vector<size_t>{0});
+    REQUIRE(set.find_all(std::filesystem::path("./abc/a.txt")) == std::vector<size_t>{1});
+    REQUIRE(set.find_all(std::filesystem::path("/x/y/def")) == std::vector<size_t>{2});
+    REQUIRE(set.find_all(std::filesystem::path("x/y/def")).empty());
+}
+
+TEST_CASE("PathMatcherSet with case-sensitive and case-insensitive patterns")
+{
+    Yglob::PathMatcherSet set;
+    set.add(std::string_view("Abc/*.TXT"));
+    set.add(std::string_view("Abc/*.TXT"), Yglob::GlobFlags::CASE_SENSITIVE);
+    set.add(std::string_view("Abc/*.t?t"), Yglob::GlobFlags::CASE_SENSITIVE);
+    REQUIRE(set.find_all(std::string_view("abc/a.txt")) == std::vector<size_t>{0});
+    REQUIRE(set.find_all(std::string_view("Abc/a.TXT")) == std::vector<size_t>{0, 1});
+    REQUIRE(set.find_all(std::string_view("Abc/a.txt")) == std::vector<size_t>{0, 2});
+}
+
+TEST_CASE("PathMatcherSet with long case-insensitive extension")
+{
+    const std::string ext(70, 'x');
+    const auto pattern = "**/*." + ext;
+    const auto path = "a/b." + std::string(70, 'X');
+    REQUIRE(Yglob::PathMatcher(std::string_view(pattern)).match(std::string_view(path)));
+
+    Yglob::PathMatcherSet set;
+    set.add(std::string_view(pattern));
+    REQUIRE(set.match(std::string_view(path)));
+    REQUIRE_FALSE(set.match(std::string_view(path + "y")));
+}
@@ -0,0 +1,122 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yglob/SharedPathIterator.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <catch2/catch_test_macros.hpp>
+#include "TempFiles.hpp"
+
+namespace
+{
+    using Paths = std::vector<std::filesystem::path>;
+
+    Paths make_tree(TempFiles& files)
+    {
+        Paths names;
+        for (int i = 0; i < 5; ++i)
+        {
+            for (int j = 0; j < 5; ++j)
+            {
+                auto dir = "d" + std::to_string(i) + "/e" + std::to_string(j);
+                names.push_back(dir + "/a.log");
+                names.push_back(dir + "/b.log");
+                names.push_back(dir + "/c.txt");
+            }
+        }
+        files.make_files(names);
+
+        Paths result;
+        for (const auto& name : names)
+        {
+            if (name.extension() == ".log")
+                result.push_back(files.get_path(name));
+        }
+        std::ranges::sort(result);
+        return result;
+    }
+}
+
+TEST_CASE("SharedPathIterator with several consumers")
+{
+    TempFiles files("YglobTest", true);
+    auto expected = make_tree(files);
+
+    Yglob::ParallelOptions options;
+    options.thread_count = 2;
+    options.queue_size = 4;
+    Yglob::SharedPathIterator it({files.get_path("**/*.log")}, {},
+                                 Yglob::PathIteratorFlags::DEFAULT, options);
+
+    std::mutex mutex;
+    Paths paths;
+    auto consume = [&](bool batches)
+    {
+        Paths result;
+        if (batches)
+        {
+            Paths batch;
+            while (it.try_next_batch(batch))
+                result.insert(result.end(), batch.begin(), batch.end());
+        }
+        else
+        {
+            std::filesystem::path path;
+            while (it.try_next(path))
+                result.push_back(path);
+        }
+        std::scoped_lock lock(mutex);
+        paths.insert(paths.end(), result.begin(), result.end());
+    };
+
+    {
+        std::vector<std::jthread> consumers;
+        for (int i = 0; i < 4; ++i)
+            consumers.emplace_back(consume, i % 2 == 0);
+    }
+
+    std::ranges::sort(paths);
+    REQUIRE(paths == expected);
+}
+
+TEST_CASE("SharedPathIterator stopped early")
+{
+    TempFiles files("YglobTest", true);
+    make_tree(files);
+
+    Yglob::ParallelOptions options;
+    options.queue_size = 1;
+    Yglob::SharedPathIterator it({files.get_path("**/*.log")}, {},
+                                 Yglob::PathIteratorFlags::DEFAULT, options);
+
+    std::filesystem::path path;
+    REQUIRE(it.try_next(path));
+
+    SECTION("Destroyed without stop()")
+    {
+    }
+
+    SECTION("Waiting consumers are woken")
+    {
+        std::vector<std::jthread> consumers;
+        for (int i = 0; i < 3; ++i)
+        {
+            consumers.emplace_back([&]
+            {
+                std::filesystem::path p;
+                while (it.try_next(p))
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            });
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        it.stop();
+        consumers.clear();
+        REQUIRE_FALSE(it.try_next(path));
+    }
+}
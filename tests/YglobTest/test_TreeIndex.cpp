@@ -0,0 +1,147 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yglob/TreeIndex.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <catch2/catch_test_macros.hpp>
+#include "Yglob/YglobException.hpp"
+#include "TempFiles.hpp"
+
+namespace
+{
+    std::vector<std::filesystem::path>
+    get_paths(const std::vector<Yglob::TreeIndex::Entry>& entries)
+    {
+        std::vector<std::filesystem::path> result;
+        for (const auto& entry : entries)
+            result.push_back(entry.path);
+        std::ranges::sort(result);
+        return result;
+    }
+
+    using Paths = std::vector<std::filesystem::path>;
+}
+
+TEST_CASE("TreeIndex find")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a.txt", "b/c.txt", "b/d.md", "b/e/f.txt", "g/h.txt"});
+
+    Yglob::TreeIndex index(files.base_directory());
+    REQUIRE(index.size() == 8);
+    REQUIRE(get_paths(index.find("**/*.txt"))
+            == Paths{"a.txt", "b/c.txt", "b/e/f.txt", "g/h.txt"});
+    REQUIRE(get_paths(index.find("b/*")) == Paths{"b/c.txt", "b/d.md", "b/e"});
+    REQUIRE(get_paths(index.find("b/*", Yglob::PathIteratorFlags::NO_DIRECTORIES))
+            == Paths{"b/c.txt", "b/d.md"});
+    REQUIRE(get_paths(index.find("B/E/F.TXT")).empty());
+    REQUIRE(get_paths(index.find("B/E/F.TXT", Yglob::PathIteratorFlags::CASE_INSENSITIVE_PATHS))
+            == Paths{"b/e/f.txt"});
+    REQUIRE(get_paths(index.find(Paths{"*.txt", "g/*"})) == Paths{"a.txt", "g/h.txt"});
+
+    auto entries = index.find("b/*");
+    for (const auto& entry : entries)
+    {
+        if (entry.path == "b/e")
+        {
+            REQUIRE(entry.type == std::filesystem::file_type::directory);
+        }
+        else
+        {
+            REQUIRE(entry.type == std::filesystem::file_type::regular);
+            REQUIRE(entry.size == std::filesystem::file_size(files.get_path(entry.path)));
+        }
+    }
+}
+
+TEST_CASE("TreeIndex find with absolute glob paths")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a.txt", "b/c.txt"});
+
+    Yglob::TreeIndex index(files.base_directory());
+    REQUIRE(get_paths(index.find(files.get_path("**/*.txt")))
+            == Paths{files.get_path("a.txt"), files.get_path("b/c.txt")});
+    REQUIRE(get_paths(index.find(files.get_path("b/*")))
+            == Paths{files.get_path("b/c.txt")});
+    REQUIRE(index.find(files.get_path("../*")).empty());
+}
+
+TEST_CASE("TreeIndex save and load")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a.txt", "b/c.txt", "b/d/e.txt", "index.bin"});
+
+    Yglob::TreeIndex index(files.base_directory());
+    index.save(files.get_path("index.bin"));
+
+    auto loaded = Yglob::TreeIndex::load(files.get_path("index.bin"));
+    REQUIRE(loaded.root() == index.root());
+    REQUIRE(loaded.size() == index.size());
+    REQUIRE(get_paths(loaded.find("**/*.txt"))
+            == Paths{"a.txt", "b/c.txt", "b/d/e.txt"});
+
+    std::ofstream(files.get_path("index.bin")) << "not an index";
+    REQUIRE_THROWS_AS(Yglob::TreeIndex::load(files.get_path("index.bin")),
+                      Yglob::YglobException);
+}
+
+TEST_CASE("TreeIndex load rejects directories that aren't a tree")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a/b/c.txt", "index.bin"});
+
+    Yglob::TreeIndex index(files.base_directory());
+    index.save(files.get_path("index.bin"));
+
+    std::string data;
+    {
+        std::ifstream stream(files.get_path("index.bin"), std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(stream), {});
+    }
+
+    // The entries follow a 64-byte header, the root path padded to a
+    // multiple of 8 bytes, and the 48-byte directories. The root lists
+    // a and index.bin, so the third entry is b, the only entry in a.
+    uint64_t root_size, directory_count;
+    std::memcpy(&root_size, data.data() + 16, sizeof(root_size));
+    std::memcpy(&directory_count, data.data() + 24, sizeof(directory_count));
+    REQUIRE(directory_count == 3);
+    auto entries_offset = 64 + (root_size + 7) / 8 * 8 + directory_count * 48;
+    auto b_directory = entries_offset + 2 * 40 + 12;
+    REQUIRE(data.substr(b_directory, 4) == std::string("\2\0\0\0", 4));
+
+    // Make b refer to a, its own parent.
+    data[b_directory] = 1;
+    std::ofstream(files.get_path("index.bin"), std::ios::binary) << data;
+    REQUIRE_THROWS_AS(Yglob::TreeIndex::load(files.get_path("index.bin")),
+                      Yglob::YglobException);
+}
+
+TEST_CASE("TreeIndex refresh")
+{
+    TempFiles files("YglobTest", true);
+    files.make_files({"a/b.txt", "c/d/e.txt", "c/d/f.txt"});
+
+    // Directories that changed just before they were indexed are always
+    // read again.
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    Yglob::TreeIndex index(files.base_directory());
+    REQUIRE(index.refresh() == 0);
+
+    files.make_file("c/d/g.txt");
+    std::filesystem::remove(files.get_path("a/b.txt"));
+    REQUIRE(index.refresh() == 2);
+    REQUIRE(get_paths(index.find("**/*.txt"))
+            == Paths{"c/d/e.txt", "c/d/f.txt", "c/d/g.txt"});
+    files.make_file("a/b.txt");
+}